@@ -15,7 +15,7 @@ def extract_scip(entry_, file_path):
     ls = open(file_path).readlines()
     #print(ls)
     #print(file)
-    stat_keys = ["Total Time",  "Dual Bound", "Primal Bound",  "Gap", "nodes"]
+    stat_keys = ["Total Time",  "Dual Bound", "Primal Bound",  "Gap", "nodes", "Exact Primal Bound", "Exact Gap", "Final Dual Bound"]
     stat_dict = {}
     entry = entry_
     for l in ls:
@@ -31,6 +31,16 @@ def extract_scip(entry_, file_path):
     entry["gap"] = float(stat_dict["Gap"].split()[2])
     #print(stat_dict["nodes"].split())
     entry["nodes"] = int(stat_dict["nodes"].split()[2])
+    # B&B throughput, to compare the polyhedral cones with the nonlinear formulation
+    entry["throughput"] = entry["nodes"] / max(entry["total_time"], 1e-2)
+    # with polyhedral cones, the primal bound is the exact value of the incumbent design
+    if "Exact Primal Bound" in stat_dict:
+        entry["primal"] = -float(stat_dict["Exact Primal Bound"].split()[4])
+    if "Exact Gap" in stat_dict:
+        entry["gap"] = float(stat_dict["Exact Gap"].split()[3])
+    # gap of the dual bound at the end of the root node, to compare the bound propagation and the root seeding
+    rootdual = -float(stat_dict["Final Dual Bound"].split()[4]) if "Final Dual Bound" in stat_dict else float("NAN")
+    entry["rootgap"] = abs(rootdual - entry["primal"]) / max(abs(entry["primal"]), 1e-9) if not math.isnan(rootdual) else 1.0
     return entry
 
 
@@ -55,10 +65,7 @@ for log in logs:
     log = log[0:-4]
     #print(log.split("_"))
     setting = log.split("_")[-1]
-    if setting == "normal":
-        instance = log[0:-6]
-    else:
-        instance = log[0:-6]
+    instance = log[0:-(len(setting) + 1)]
     insclass = instance.split("_")[0]
     entry={}
     entry["instance"] = instance
@@ -71,15 +78,15 @@ for log in logs:
     
 
 def Stat(sname, pname):
-    return {"setting": sname, "pclass": pname, "total": 0, "nodes": 0, "gap": 0,  "dual": 0, "primal": 0, "nodes_lst": [], "gap_lst": [], "dual_lst": [], "primal_lst": []} 
+    return {"setting": sname, "pclass": pname, "total": 0, "nodes": 0, "gap": 0,  "dual": 0, "primal": 0, "throughput": 0, "rootgap": 0, "nodes_lst": [], "gap_lst": [], "dual_lst": [], "primal_lst": [], "throughput_lst": [], "rootgap_lst": []} 
 
-display_keys = ["setting", "pclass", "dual", "primal", "gap", "nodes"]
+display_keys = ["setting", "pclass", "dual", "primal", "gap", "nodes", "throughput", "rootgap"]
 
-numerical_keys = ["dual", "primal", "gap", "nodes"]
+numerical_keys = ["dual", "primal", "gap", "nodes", "throughput", "rootgap"]
 
 details = ""
 
-settings = ["scip1", "scip2", "scip3" , "scip4" , "scip5" , "scip6"]
+settings = ["scip1", "scip2", "scip3" , "scip4" , "scip5" , "scip6", "scip7", "scip8", "scip9", "scip10", "scip11", "scip12", "scip13", "scip14", "scip15", "scip16", "scip17"]
 pclasses = ['block2', 'normal']
 
 classstats = {}
@@ -107,6 +114,8 @@ def add(stat, entry):
     stat["gap_lst"].append(entry["gap"]) 
     stat["dual_lst"].append(entry["dual"])
     stat["primal_lst"].append(entry["primal"])
+    stat["throughput_lst"].append(entry["throughput"])
+    stat["rootgap_lst"].append(entry["rootgap"])
 
 
 def SGM(lst, total, bias):
@@ -118,6 +127,8 @@ def avgStat(stat):
     stat["primal"] = SGM(stat["primal_lst"], stat["total"], 1)
     stat["dual"] = SGM(stat["dual_lst"] , stat["total"], 1)
     stat["gap"] = SGM(stat["gap_lst"] , stat["total"], 1)
+    stat["throughput"] = SGM(stat["throughput_lst"] , stat["total"], 1)
+    stat["rootgap"] = SGM(stat["rootgap_lst"] , stat["total"], 1)
 
 
 def printStat(stat):
@@ -0,0 +1,32 @@
+#!/bin/bash
+# design cache: solves every benchmark instance twice with an empty cache directory, a cold run that fills the cache
+# and a warm run that starts from the cached root cuts and design, and records the time to the first branching, root
+# dual bound and solving time of both runs in a CSV file
+timelimit=3600
+datapath="benchmark"
+logpath="cache/logs"
+cachepath="cache/dcache"
+result="cache/cache.csv"
+
+mkdir -p $logpath
+echo "instance,run,cachehit,firstbranch,rootdual,solvetime" > $result
+
+for instance in $(ls $datapath)
+do
+    rm -rf $cachepath
+    mkdir -p $cachepath
+    for run in cold warm
+    do
+        log="$logpath/${instance}_$run.log"
+        solver/build/dopt -c "set limits time $timelimit" -c "set eventhdlr designcache dir $cachepath" \
+            -c "read $datapath/$instance" -c "opt" -c "display statistics" -c "quit" > $log 2>&1
+
+        cachehit=$(grep -c "design cache: hit" $log)
+        # design cache: first branching after <time> s
+        firstbranch=$(grep "design cache: first branching" $log | awk '{print $6}')
+        rootdual=$(grep "Final Dual Bound" $log | awk -F: '{print $2}' | tr -d ' ')
+        solvetime=$(grep "^Solving Time (sec)" $log | awk -F: '{print $2}' | tr -d ' ')
+        echo "$instance,$run,$cachehit,${firstbranch:-none},$rootdual,$solvetime" >> $result
+    done
+done
+rm -rf $cachepath
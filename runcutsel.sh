@@ -0,0 +1,37 @@
+#!/bin/bash
+# cut selection: solves the benchmark instances with the cut selector "designcutsel" (scip1) and with SCIP's hybrid
+# selector (scip16) and records bounds, gap, nodes, the LP size at the end of the solve, the LP iterations per node
+# and the selected and forced cuts of each selector in a CSV file
+timelimit=3600
+datapath="benchmark"
+logpath="cutsel/logs"
+result="cutsel/cutsel.csv"
+
+mkdir -p $logpath
+echo "instance,mode,solvetime,primal,dual,gap,nodes,lprows,lpcols,lpiters,iterspernode,selectedcuts,forcedcuts" > $result
+
+for instance in $(ls $datapath)
+do
+    for mode in scip1 scip16
+    do
+        log="$logpath/${instance}_$mode.log"
+        solver/build/dopt -c "set load settings/$mode.set" -c "set limits time $timelimit" \
+            -c "read $datapath/$instance" -c "opt" -c "display statistics" -c "quit" > $log 2>&1
+
+        solvetime=$(grep "^Solving Time (sec)" $log | awk -F: '{print $2}' | tr -d ' ')
+        primal=$(grep "^Primal Bound" $log | awk -F: '{print $2}' | awk '{print $1}')
+        dual=$(grep "^Dual Bound" $log | awk -F: '{print $2}' | tr -d ' ')
+        gap=$(grep "^Gap" $log | awk -F: '{print $2}' | awk '{print $1}')
+        nodes=$(grep "^Solving Nodes" $log | awk -F: '{print $2}' | awk '{print $1}')
+        # row "  transformed : <used> <total> <extern> <vars> <conss> <LP rows> <LP cols>" of the table designmemory
+        lprows=$(grep -E "^  transformed +:" $log | tail -n 1 | awk '{print $8}')
+        lpcols=$(grep -E "^  transformed +:" $log | tail -n 1 | awk '{print $9}')
+        # rows "  primal LP : <time> <calls> <iterations> ..." and "  dual LP : ..." of the LP statistics
+        lpiters=$(grep -E "^  (primal|dual) LP +:" $log | awk '{s += $6} END {print s + 0}')
+        iterspernode=$(awk -v i=$lpiters -v n=$nodes 'BEGIN {if (n > 0) printf "%.1f", i / n; else print i}')
+        # rows "  <cutsel> : <exectime> <setuptime> <calls> <rootcalls> <selected> <forced> ..." of the cut selectors
+        selectedcuts=$(grep -E "^  (designcutsel|hybrid) +:" $log | awk '{s += $7} END {print s + 0}')
+        forcedcuts=$(grep -E "^  (designcutsel|hybrid) +:" $log | awk '{s += $8} END {print s + 0}')
+        echo "$instance,$mode,$solvetime,$primal,$dual,$gap,$nodes,$lprows,$lpcols,$lpiters,$iterspernode,$selectedcuts,$forcedcuts" >> $result
+    done
+done
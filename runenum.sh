@@ -0,0 +1,45 @@
+#!/bin/bash
+# enumeration: solves the block2_45_10_9 instances with denum, which enumerates all designs, and with dopt with and
+# without the propagator "designenum", and records the optimal geometric mean of denum, primal and dual bound and time
+# of dopt and whether the primal bound of dopt agrees with the enumeration up to the tolerances of the model in a
+# CSV file
+timelimit=3600
+settings="settings/scip1.set"
+datapath="benchmark"
+logpath="enum/logs"
+result="enum/enum.csv"
+
+mkdir -p $logpath
+echo "instance,enumobj,enumtime,designs,mode,primal,dual,soltime,enumcutoffs,match" > $result
+
+for instance in $(ls $datapath | grep "^block2_45_10_9_")
+do
+    log="$logpath/${instance}_denum.log"
+    solver/build/denum $datapath/$instance -l $timelimit > $log 2>&1
+    # enumerated in <time> s with <n> threads: ...; log-determinant <logdet>, geometric mean <obj>
+    enumtime=$(grep "^enumerated in" $log | awk '{print $3}')
+    designs=$(grep "designs of" $log | awk '{print $6}')
+    enumobj=$(grep "geometric mean" $log | awk '{print $5}')
+
+    for mode in enum noenum
+    do
+        log="$logpath/${instance}_$mode.log"
+        freq=1
+        if [ $mode == "noenum" ]
+        then
+            freq=-1
+        fi
+        solver/build/dopt -c "set load $settings" -c "set limits time $timelimit" \
+            -c "set propagating designenum freq $freq" \
+            -c "read $datapath/$instance" -c "opt" -c "quit" > $log 2>&1
+
+        # the objective is minimized as -obj_var
+        primal=$(grep "^Primal Bound" $log | awk '{print -$4}')
+        dual=$(grep "^Dual Bound" $log | awk '{print -$4}')
+        soltime=$(grep "^Solving Time (sec)" $log | awk -F: '{print $2}' | tr -d ' ')
+        # designenum propagator: <n> enumerations, <n> designs evaluated, <n> nodes cut off, ...
+        cutoffs=$(grep "designenum propagator:" $log | awk '{print $8}')
+        match=$(awk -v p="$primal" -v e="$enumobj" 'BEGIN {d = p - e; if (d < 0) d = -d; print (e != "" && d <= 1e-4 * e) ? 1 : 0}')
+        echo "$instance,$enumobj,$enumtime,$designs,$mode,$primal,$dual,$soltime,${cutoffs:-0},$match" >> $result
+    done
+done
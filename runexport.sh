@@ -0,0 +1,58 @@
+#!/bin/bash
+# native export: converts every benchmark instance to CBF (geometric mean and log-determinant form) and MPS with
+# dconvert, and writes synthetic instances of growing size both with dconvert and with "write problem" of dopt, which
+# goes through SCIP's generic writer; records write time and file size in a CSV file
+numvarslist=(1000 10000 100000)
+dim=20
+seed=1
+datapath="benchmark"
+outpath="export"
+result="export/export.csv"
+
+mkdir -p $outpath
+echo "instance,format,writer,writetime,filesize,status" > $result
+
+now() {
+    date +%s.%N
+}
+
+# runs a writer on an instance: writer format model command...
+runWriter() {
+    name=$1
+    format=$2
+    writer=$3
+    model=$4
+    shift 4
+    start=$(now)
+    "$@" > $outpath/writer.log 2>&1
+    rc=$?
+    writetime=$(awk "BEGIN {print $(now) - $start}")
+    status="ok"
+    if [ $rc != 0 ] || [ ! -s $model ]
+    then
+        status="error$rc"
+    fi
+    filesize=$(stat -c %s $model 2> /dev/null)
+    echo "$name,$format,$writer,$writetime,$filesize,$status" >> $result
+}
+
+for instance in $(ls $datapath)
+do
+    runWriter $instance cbf dconvert $outpath/$instance.cbf solver/build/dconvert $datapath/$instance $outpath/$instance.cbf
+    runWriter $instance cbf-logdet dconvert $outpath/${instance}_logdet.cbf \
+        solver/build/dconvert $datapath/$instance $outpath/${instance}_logdet.cbf -l
+    runWriter $instance mps dconvert $outpath/$instance.mps solver/build/dconvert $datapath/$instance $outpath/$instance.mps
+done
+
+for numvars in ${numvarslist[@]}
+do
+    instance="$outpath/normal_${numvars}_${dim}_$(( 2 * dim ))_${seed}.design"
+    solver/build/dgen normal $numvars $dim $(( 2 * dim )) -s $seed -o $instance > /dev/null || continue
+    name=$(basename $instance)
+    runWriter $name cbf dconvert $instance.cbf solver/build/dconvert $instance $instance.cbf
+    runWriter $name mps dconvert $instance.mps solver/build/dconvert $instance $instance.mps
+    # the time of dopt includes reading the instance and building the model
+    runWriter $name gms dopt $instance.gms solver/build/dopt -c "read $instance" -c "write problem $instance.gms" -c "quit"
+    rm -f $instance $instance.cbf $instance.mps $instance.gms
+done
+rm -f $outpath/writer.log
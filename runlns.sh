@@ -0,0 +1,48 @@
+#!/bin/bash
+# sub-SCIP heuristics and concurrent solving: solves the normal_60 and normal_70 benchmark instances with the default
+# settings (scip1), with more frequent large neighborhood search heuristics (scip13), without the exchange heuristic
+# designlns (scip14) and with the concurrent mode of scip1 ("concurrentopt", needs SCIP with a task interface), and
+# records solving time, bounds, nodes, the primal integral and the time of the last improvement of the bound trace,
+# and the solutions found by the large neighborhood search heuristics of SCIP and by designlns in a CSV file
+timelimit=3600
+nthreads=$(nproc)
+datapath="benchmark"
+logpath="lns/logs"
+result="lns/lns.csv"
+lnsheurs="rens|rins|crossover|dins|alns"
+
+mkdir -p $logpath
+echo "instance,mode,solvetime,primal,dual,gap,nodes,primalintegral,lastimprovement,lnssols,designlnssols" > $result
+
+for instance in $(ls $datapath | grep -E "^normal_(60|70)_")
+do
+    for mode in scip1 scip13 scip14 concurrent
+    do
+        log="$logpath/${instance}_$mode.log"
+        trace="$logpath/${instance}_$mode.jsonl"
+        settings="settings/$mode.set"
+        optcmd="opt"
+        if [ $mode == "concurrent" ]
+        then
+            settings="settings/scip1.set"
+            optcmd="concurrentopt"
+        fi
+        solver/build/dopt -c "set load $settings" -c "set limits time $timelimit" \
+            -c "set parallel maxnthreads $nthreads" -c "set eventhdlr trace filename $trace" \
+            -c "read $datapath/$instance" -c "$optcmd" -c "display statistics" -c "quit" > $log 2>&1
+
+        solvetime=$(grep "^Solving Time (sec)" $log | awk -F: '{print $2}' | tr -d ' ')
+        primal=$(grep "^Primal Bound" $log | awk -F: '{print $2}' | awk '{print $1}')
+        dual=$(grep "^Dual Bound" $log | awk -F: '{print $2}' | tr -d ' ')
+        gap=$(grep "^Gap" $log | awk -F: '{print $2}' | awk '{print $1}')
+        nodes=$(grep "^Solving Nodes" $log | awk -F: '{print $2}' | awk '{print $1}')
+        # rows "  <heur> : <exectime> <setuptime> <calls> <found> <best>" of the primal heuristics statistics
+        lnssols=$(grep -E "^  ($lnsheurs) +:" $log | awk '{s += $6} END {print s + 0}')
+        designlnssols=$(grep -E "^  designlns +:" $log | awk '{s += $6} END {print s + 0}')
+        # summary line of the bound trace, and the time of the last sample with a new primal bound
+        primalintegral=$(tail -n 1 $trace | sed 's/.*"primalintegral":\([^,]*\).*/\1/')
+        lastimprovement=$(grep -v '"summary"' $trace | sed 's/.*"time":\([^,]*\),"primal":\([^,]*\),.*/\1 \2/' \
+            | awk '$2 != last {t = $1; last = $2} END {print t + 0}')
+        echo "$instance,$mode,$solvetime,$primal,$dual,$gap,$nodes,$primalintegral,$lastimprovement,$lnssols,$designlnssols" >> $result
+    done
+done
@@ -0,0 +1,71 @@
+#!/bin/bash
+# compressed input: generates synthetic instances with dgen, compresses them with gzip and zstd and records, for each
+# instance and input, the file size, the parse time of the reader and the wall time of "dopt" reading the file in a
+# CSV file; the input "predecomp" decompresses the gzip file to a plain file first and counts this time in
+numvarslist=(100000 1000000)
+dimlist=(10 50)
+seed=1
+inputs=("plain" "gz" "zst" "predecomp")
+datapath="load"
+logpath="load/logs"
+result="load/load.csv"
+
+mkdir -p $datapath $logpath
+echo "numvars,dim,input,filesize,decomptime,parsetime,walltime,status" > $result
+
+now() {
+    date +%s.%N
+}
+
+runInput() {
+    log="$logpath/$(basename $instance .design)_$input.log"
+    decomptime=0
+    case $input in
+        plain) file=$instance ;;
+        gz) file=$instance.gz ;;
+        zst) file=$instance.zst ;;
+        predecomp)
+            file="$datapath/predecomp.design"
+            start=$(now)
+            gzip -dc $instance.gz > $file
+            decomptime=$(awk "BEGIN {print $(now) - $start}")
+            ;;
+    esac
+    filesize=$(stat -c %s $file)
+
+    # the model is built but not solved
+    start=$(now)
+    solver/build/dopt -c "read $file" -c "quit" > $log 2>&1
+    rc=$?
+    walltime=$(awk "BEGIN {print $(now) - $start + $decomptime}")
+
+    parsetime=$(grep -o "parsed in [0-9.e+-]*" $log | awk '{print $3}')
+    status="ok"
+    if [ $rc != 0 ] || [ -z "$parsetime" ]
+    then
+        # e.g. the solver is built without zstd
+        status="error$rc"
+    fi
+    echo "$numvars,$dim,$input,$filesize,$decomptime,$parsetime,$walltime,$status" >> $result
+
+    if [ $input == "predecomp" ]
+    then
+        rm -f $file
+    fi
+}
+
+for dim in ${dimlist[@]}
+do
+    for numvars in ${numvarslist[@]}
+    do
+        instance="$datapath/normal_${numvars}_${dim}_$(( 2 * dim ))_${seed}.design"
+        solver/build/dgen normal $numvars $dim $(( 2 * dim )) -s $seed -o $instance > /dev/null || continue
+        gzip -kf $instance
+        zstd -qkf $instance
+        for input in ${inputs[@]}
+        do
+            runInput
+        done
+        rm -f $instance $instance.gz $instance.zst
+    done
+done
@@ -0,0 +1,45 @@
+#!/bin/bash
+# online mode: for each benchmark instance, solves the instance without its last points, appends them with "append"
+# and solves again, and compares the time of the second solve with a cold solve of the whole instance in a CSV file
+timelimit=3600
+nappendlist=(1 5)
+datapath="online"
+logpath="online/logs"
+result="online/online.csv"
+
+mkdir -p $datapath $logpath
+echo "instance,numvars,nappend,coldtime,coldprimal,basetime,resolvetime,resolveprimal,keptcuts" > $result
+
+for instance in benchmark/*.design
+do
+    name=$(basename $instance .design)
+    read numvars dim card epsilon < <(head -1 $instance)
+
+    log="$logpath/${name}_cold.log"
+    solver/build/dopt -c "set limits time $timelimit" -c "read $instance" -c "opt" -c "quit" > $log 2>&1
+    coldtime=$(grep "^Solving Time (sec)" $log | awk -F: '{print $2}' | tr -d ' ')
+    coldprimal=$(grep "^Primal Bound" $log | awk -F: '{print $2}' | awk '{print $1}')
+
+    for nappend in ${nappendlist[@]}
+    do
+        base="$datapath/${name}_base$nappend.design"
+        points="$datapath/${name}_append$nappend.points"
+        echo "$(( numvars - nappend )) $dim $card $epsilon" > $base
+        sed -n "2,$(( numvars - nappend + 1 ))p" $instance >> $base
+        echo "$nappend $dim" > $points
+        sed -n "$(( numvars - nappend + 2 )),$(( numvars + 1 ))p" $instance >> $points
+
+        log="$logpath/${name}_append$nappend.log"
+        solver/build/dopt -c "set limits time $timelimit" -c "read $base" -c "opt" -c "append $points" -c "opt" \
+            -c "quit" > $log 2>&1
+
+        # the first solve is the base instance, the second one the re-solve after the append
+        basetime=$(grep "^Solving Time (sec)" $log | head -1 | awk -F: '{print $2}' | tr -d ' ')
+        resolvetime=$(grep "^Solving Time (sec)" $log | tail -1 | awk -F: '{print $2}' | tr -d ' ')
+        resolveprimal=$(grep "^Primal Bound" $log | tail -1 | awk -F: '{print $2}' | awk '{print $1}')
+        keptcuts=$(grep -o "[0-9]* root cuts kept" $log | awk '{print $1}')
+        echo "$name,$numvars,$nappend,$coldtime,$coldprimal,$basetime,$resolvetime,$resolveprimal,$keptcuts" >> $result
+
+        rm -f $base $points
+    done
+done
@@ -0,0 +1,34 @@
+#!/bin/bash
+# callback profile: solves every benchmark instance with the profile table enabled, writes the profile of each run as
+# JSON and collects calls, time and hardware counters of every callback in a CSV file; the solving time of a run with
+# the profile disabled is recorded next to it to show the overhead of the profiling
+timelimit=600
+settings="settings/scip1.set"
+datapath="benchmark"
+outpath="profile"
+result="profile/profile.csv"
+
+mkdir -p $outpath
+echo "instance,callback,calls,seconds,cycles,instructions,llc_misses,ipc,soltime,soltime_noprofile" > $result
+
+for instance in $(ls $datapath)
+do
+    log="$outpath/$instance.log"
+    json="$outpath/$instance.json"
+
+    solver/build/dopt -c "set load $settings" -c "set limits time $timelimit" \
+        -c "read $datapath/$instance" -c "opt" -c "quit" > $log.off 2>&1
+    soltime_off=$(grep "^Solving Time (sec)" $log.off | awk -F: '{print $2}' | tr -d ' ')
+
+    solver/build/dopt -c "set load $settings" -c "set limits time $timelimit" \
+        -c "set table designprofile enabled TRUE" -c "set table designprofile filename $json" \
+        -c "read $datapath/$instance" -c "opt" -c "display statistics" -c "quit" > $log 2>&1
+    soltime=$(grep "^Solving Time (sec)" $log | awk -F: '{print $2}' | tr -d ' ')
+
+    # the JSON file has one line per callback: "name": {"calls": c, "seconds": s, "cycles": ..., "ipc": ...}
+    grep '^  "' $json 2> /dev/null | sed -e 's/[{}":,]/ /g' | \
+        awk -v inst=$instance -v st="$soltime" -v so="$soltime_off" \
+            '{print inst "," $1 "," $3 "," $5 "," $7 "," $9 "," $11 "," $13 "," st "," so}' >> $result
+
+    rm -f $log.off
+done
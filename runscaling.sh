@@ -0,0 +1,95 @@
+#!/bin/bash
+# scaling suite: generates synthetic instances of growing size with dgen and records, for each size and for the full
+# model and the pricing mode, read time, model build time, maximal memory, time of the root node and root dual bound
+# in a CSV file
+timelimit=3600
+numvarslist=(10000 100000 1000000)
+dimlist=(10 50 200)
+card_per_dim=2 # cardinality = card_per_dim * dim
+seed=1
+modes=("full" "pricing")
+datapath="scaling"
+logpath="scaling/logs"
+result="scaling/scaling.csv"
+
+mkdir -p $datapath $logpath
+echo "family,numvars,dim,card,mode,filesize,gentime,readtime,buildtime,maxrss_kb,roottime,rootdual,status" > $result
+
+runSize() {
+    family=$1
+    numvars=$2
+    dim=$3
+    card=$(( card_per_dim * dim ))
+
+    if [ $family == "normal" ]
+    then
+        instance="$datapath/normal_${numvars}_${dim}_${card}_${seed}.design"
+        genargs="normal $numvars $dim $card"
+    else
+        # block2 instances have dim = t - 1 and numvars comparisons between the t treatments
+        instance="$datapath/block2_${numvars}_$(( dim + 1 ))_${card}_${seed}.design"
+        genargs="block2 $(( dim + 1 )) $numvars $card"
+    fi
+
+    start=$(date +%s.%N)
+    if ! solver/build/dgen $genargs -s $seed -o $instance > /dev/null
+    then
+        echo "$family,$numvars,$dim,$card,,,,,,,,,generror" >> $result
+        return 1
+    fi
+    gentime=$(awk "BEGIN {print $(date +%s.%N) - $start}")
+    filesize=$(stat -c %s $instance)
+
+    for mode in ${modes[@]}
+    do
+        runMode
+    done
+
+    rm -f $instance
+}
+
+runMode() {
+    log="$logpath/$(basename $instance .design)_$mode.log"
+    pricing="FALSE"
+    if [ $mode == "pricing" ]
+    then
+        pricing="TRUE"
+    fi
+
+    # the root node is solved by a node limit of 1; the maximal resident set size is reported by GNU time
+    timeout $(( timelimit + 60 )) /usr/bin/time -f "maxrss %M" -o $log.rss \
+        solver/build/dopt -c "set limits time $timelimit" -c "set limits nodes 1" -c "set reading design pricing $pricing" \
+        -c "read $instance" -c "opt" -c "quit" > $log 2>&1
+    rc=$?
+
+    readtime=$(grep -o "parsed in [0-9.e+-]*" $log | awk '{print $3}')
+    buildtime=$(grep -o "model built in [0-9.e+-]*" $log | awk '{print $4}')
+    maxrss=$(grep -o "maxrss [0-9]*" $log.rss 2> /dev/null | awk '{print $2}')
+    roottime=$(grep "^Solving Time (sec)" $log | awk -F: '{print $2}' | tr -d ' ')
+    rootdual=$(grep "^Dual Bound" $log | awk -F: '{print $2}' | tr -d ' ')
+
+    if [ $rc == 124 ]
+    then
+        status="timeout"
+    elif [ $rc != 0 ] || [ -z "$rootdual" ]
+    then
+        # typically out of memory: the fields measured before the failure are kept
+        status="error$rc"
+    else
+        status="ok"
+    fi
+    echo "$family,$numvars,$dim,$card,$mode,$filesize,$gentime,$readtime,$buildtime,$maxrss,$roottime,$rootdual,$status" >> $result
+
+    rm -f $log.rss
+}
+
+for family in normal block2
+do
+    for dim in ${dimlist[@]}
+    do
+        for numvars in ${numvarslist[@]}
+        do
+            runSize "$family" "$numvars" "$dim"
+        done
+    done
+done
@@ -0,0 +1,30 @@
+#!/bin/bash
+# root seeding: solves the root node of every benchmark instance with and without the tangent cuts at the optimal
+# continuous design in the initial LP and records first LP bound, root dual bound, separation rounds of conegrid and
+# root time in a CSV file
+timelimit=3600
+datapath="benchmark"
+logpath="seed/logs"
+result="seed/seed.csv"
+
+mkdir -p $logpath
+echo "instance,seed,seedcuts,firstlp,rootdual,nrounds,roottime" > $result
+
+for instance in $(ls $datapath)
+do
+    for seed in TRUE FALSE
+    do
+        log="$logpath/${instance}_seed$seed.log"
+        solver/build/dopt -c "set limits time $timelimit" -c "set limits nodes 1" -c "set reading design seed $seed" \
+            -c "read $datapath/$instance" -c "opt" -c "display statistics" -c "quit" > $log 2>&1
+
+        # root seeding: continuous design in <niters> iterations (gap <gap>), <ncuts> tangent cuts in <time> s
+        seedcuts=$(grep "root seeding:" $log | awk '{print $10}')
+        firstlp=$(grep "First LP value" $log | awk -F: '{print $2}' | tr -d ' ')
+        rootdual=$(grep "Final Dual Bound" $log | awk -F: '{print $2}' | tr -d ' ')
+        # conegrid separator: <ncuts> cuts in <nrounds> rounds, ...
+        nrounds=$(grep "conegrid separator:" $log | awk '{print $6}')
+        roottime=$(grep "^Solving Time (sec)" $log | awk -F: '{print $2}' | tr -d ' ')
+        echo "$instance,$seed,${seedcuts:-0},$firstlp,$rootdual,$nrounds,$roottime" >> $result
+    done
+done
@@ -0,0 +1,44 @@
+#!/bin/bash
+# separation timing: solves the root node of large synthetic instances with 1-32 threads in the conegrid separator
+# and records the separation time per round in a CSV file
+timelimit=3600
+numvarslist=(100000 1000000)
+dimlist=(10 50)
+card_per_dim=2 # cardinality = card_per_dim * dim
+threadslist=(1 2 4 8 16 32)
+seed=1
+datapath="scaling"
+logpath="scaling/logs"
+result="scaling/sepa.csv"
+
+mkdir -p $datapath $logpath
+echo "numvars,dim,card,threads,ncuts,nrounds,septime,msperround,roottime,rootdual" > $result
+
+for dim in ${dimlist[@]}
+do
+    for numvars in ${numvarslist[@]}
+    do
+        card=$(( card_per_dim * dim ))
+        instance="$datapath/normal_${numvars}_${dim}_${card}_${seed}.design"
+        solver/build/dgen normal $numvars $dim $card -s $seed -o $instance > /dev/null || continue
+
+        for threads in ${threadslist[@]}
+        do
+            log="$logpath/$(basename $instance .design)_sepa$threads.log"
+            solver/build/dopt -c "set limits time $timelimit" -c "set limits nodes 1" \
+                -c "set separating conegrid nthreads $threads" -c "read $instance" -c "opt" -c "quit" > $log 2>&1
+
+            # conegrid separator: <ncuts> cuts in <nrounds> rounds, <time> s, <ms> ms per round with <threads> threads
+            line=$(grep "conegrid separator:" $log)
+            ncuts=$(echo $line | awk '{print $3}')
+            nrounds=$(echo $line | awk '{print $6}')
+            septime=$(echo $line | awk '{print $8}')
+            msperround=$(echo $line | awk '{print $10}')
+            roottime=$(grep "^Solving Time (sec)" $log | awk -F: '{print $2}' | tr -d ' ')
+            rootdual=$(grep "^Dual Bound" $log | awk -F: '{print $2}' | tr -d ' ')
+            echo "$numvars,$dim,$card,$threads,$ncuts,$nrounds,$septime,$msperround,$roottime,$rootdual" >> $result
+        done
+
+        rm -f $instance
+    done
+done
@@ -1,7 +1,7 @@
 #!/bin/bash
 timelimit=3600
 gnuparalleltest=1 # 1: use GNU parallel to speed up test; 0: not use
-algorithms=("scip1" "scip2" "scip3" "scip4" "scip5" "scip6")
+algorithms=("scip1" "scip2" "scip3" "scip4" "scip5" "scip6" "scip7" "scip8" "scip9" "scip10" "scip11" "scip12" "scip13" "scip14" "scip15" "scip16" "scip17")
 datapath="benchmark"
 logpath="logs"
 settingpath="settings"
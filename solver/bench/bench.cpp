@@ -0,0 +1,706 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   bench.cpp
+ * @brief  Micro-benchmarks for the D-optimal design reader, model build and transformation
+ * @author Liding Xu
+ *
+ * Besides reading and building, the violations of the cones Z_ij^2 <= t_ij w_i at a random point are evaluated by
+ * the expressions of the nonlinear constraints (cone-expr) and by the kernel of conekernel.h, with scalar code
+ * (cone-scal) and with the best vector instructions of the processor (cone-simd). The kernels of linalgkernel.h
+ * for the dimension of the instance (chol, logdet, lev and rank1 with suffix -fix) are compared with the generic
+ * ones for a runtime dimension (suffix -gen). For comparison designs, the greedy design and the log-determinant of the
+ * Laplacian mode (greedy-lap, logdet-lap) are compared with the generic ones (greedy-gen, logdet-gen), and the exchange
+ * heuristic of laplacian.h is timed; synthetic comparison designs of 40 treatments are added for the scales.
+ *
+ * Every case is run once for warm-up and then a fixed number of times. For each measured quantity the median,
+ * the 10% and 90% percentiles and the minimum over the repetitions are reported. The results can be written to a
+ * csv file, and a previously written csv file can be given as baseline: the benchmark then fails if a median got
+ * slower than the baseline by more than the given tolerance.
+ *
+ * usage: doptbench [-r reps] [-d benchmarkdir] [-s scale1,scale2,...] [-o out.csv] [-b baseline.csv] [-t tol] [files]
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "scip/scip.h"
+#include "scip/scipdefplugins.h"
+
+#include "conekernel.h"
+#include "generator.h"
+#include "laplacian.h"
+#include "linalg.h"
+#include "linalgkernel.h"
+#include "probdata.h"
+#include "reader_sub.h"
+
+using namespace std;
+
+/** default instances of the benchmark directory, one per family and size */
+static const char* defaultinstances[] = {
+   "block2_45_10_9_9.design",
+   "block2_66_12_11_11.design",
+   "normal_50_20_20.design",
+   "normal_70_42_42.design"
+};
+
+/** timings of one measured quantity */
+struct Timing
+{
+   string                name;               /**< name of the case */
+   string                quantity;           /**< name of the measured quantity */
+   vector<double>        samples;            /**< measured times in seconds */
+   double                work;               /**< amount of work per sample (bytes, variables, ...) */
+   string                unit;               /**< unit of the work */
+};
+
+/** returns the p-quantile of sorted samples (nearest rank) */
+static
+double quantile(
+   const vector<double>& sorted,             /**< sorted samples */
+   double                p                   /**< quantile in [0,1] */
+   )
+{
+   assert(!sorted.empty());
+   size_t k = (size_t) ceil(p * sorted.size());
+   k = k == 0 ? 0 : k - 1;
+   return sorted[min(k, sorted.size() - 1)];
+}
+
+/** returns the current time in seconds */
+static
+double now()
+{
+   return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** returns the size of a file in bytes */
+static
+double fileSize(
+   const string&         filename            /**< name of the file */
+   )
+{
+   ifstream f(filename, ios::binary | ios::ate);
+   return f ? (double) f.tellg() : 0.0;
+}
+
+/** creates a SCIP instance with the plugins needed for reading design files */
+static
+SCIP_RETCODE createScip(
+   SCIP**                scip                /**< pointer to store SCIP */
+   )
+{
+   SCIP_CALL( SCIPcreate(scip) );
+   SCIP_CALL( SCIPincludeDefaultPlugins(*scip) );
+   SCIP_CALL( SCIPincludeObjReader(*scip, new ReaderSubmodular(*scip), TRUE) );
+   SCIPsetMessagehdlrQuiet(*scip, TRUE);
+   return SCIP_OKAY;
+}
+
+/** runs the reader, model build and transformation benchmarks on one instance */
+static
+SCIP_RETCODE benchInstance(
+   const string&         name,               /**< name of the case */
+   const string&         filename,           /**< name of the instance file */
+   int                   reps,               /**< number of measured repetitions */
+   vector<Timing>&       timings             /**< vector to append the timings to */
+   )
+{
+   Timing parse = {name, "parse", {}, fileSize(filename), "MB/s"};
+   Timing build = {name, "build", {}, 0.0, "kvars/s"};
+   Timing buildconss = {name, "build", {}, 0.0, "kconss/s"};
+   Timing trans = {name, "transform", {}, 0.0, "kvars/s"};
+   Timing read = {name, "read", {}, 0.0, ""};
+
+   for( int r = -1; r < reps; r++ )
+   {
+      SCIP* scip = NULL;
+      int numvars, dim, card;
+      SCIP_Real epsilon;
+      vector<vector<SCIP_Real>> A;
+
+      /* parse only */
+      double start = now();
+      SCIP_CALL( readDesignData(filename.c_str(), numvars, dim, card, epsilon, A) );
+      double tparse = now() - start;
+
+      /* build the lifted model from the parsed data */
+      SCIP_CALL( createScip(&scip) );
+      start = now();
+      SCIP_CALL( createDesignProb(scip, filename.c_str(), numvars, dim, A, card, sqrt(epsilon)) );
+      double tbuild = now() - start;
+      int nvars = SCIPgetNOrigVars(scip);
+      int nconss = SCIPgetNOrigConss(scip);
+
+      /* transform the problem */
+      start = now();
+      SCIP_CALL( SCIPtransformProb(scip) );
+      double ttrans = now() - start;
+      SCIP_CALL( SCIPfree(&scip) );
+
+      /* complete reader call through SCIP */
+      SCIP_CALL( createScip(&scip) );
+      start = now();
+      SCIP_CALL( SCIPreadProb(scip, filename.c_str(), "design") );
+      double tread = now() - start;
+      SCIP_CALL( SCIPfree(&scip) );
+
+      /* the first round is a warm-up */
+      if( r < 0 )
+         continue;
+
+      parse.samples.push_back(tparse);
+      build.samples.push_back(tbuild);
+      buildconss.samples.push_back(tbuild);
+      trans.samples.push_back(ttrans);
+      read.samples.push_back(tread);
+      build.work = nvars;
+      buildconss.work = nconss;
+      trans.work = nvars;
+   }
+
+   parse.work /= 1e6;
+   build.work /= 1e3;
+   buildconss.work /= 1e3;
+   trans.work /= 1e3;
+
+   timings.push_back(parse);
+   timings.push_back(build);
+   timings.push_back(buildconss);
+   timings.push_back(trans);
+   timings.push_back(read);
+
+   return SCIP_OKAY;
+}
+
+/** evaluates the cones of one instance at a random point by the nonlinear constraints and by the cone kernel */
+static
+SCIP_RETCODE benchConeKernel(
+   const string&         name,               /**< name of the case */
+   const string&         filename,           /**< name of the instance file */
+   int                   reps,               /**< number of measured repetitions */
+   vector<Timing>&       timings             /**< vector to append the timings to */
+   )
+{
+   SCIP* scip = NULL;
+   int numvars, dim, card;
+   SCIP_Real epsilon;
+   vector<vector<SCIP_Real>> A;
+
+   SCIP_CALL( readDesignData(filename.c_str(), numvars, dim, card, epsilon, A) );
+   SCIP_CALL( createScip(&scip) );
+   SCIP_CALL( createDesignProb(scip, filename.c_str(), numvars, dim, A, card, sqrt(epsilon)) );
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   assert(probdata != NULL);
+
+   /* random point with about half of the cones violated */
+   size_t ncones = (size_t) numvars * dim;
+   vector<SCIP_Real> z(ncones);
+   vector<SCIP_Real> t(ncones);
+   vector<SCIP_Real> w(ncones);
+   vector<SCIP_Real> efficacy(ncones);
+   mt19937_64 rng(20220101ull);
+   uniform_real_distribution<double> unif(0.0, 1.0);
+   SCIP_SOL* sol;
+   SCIP_CALL( SCIPcreateSol(scip, &sol, NULL) );
+   for( int i = 0; i < numvars; i++ )
+   {
+      SCIP_Real wval = unif(rng);
+      SCIP_CALL( SCIPsetSolVal(scip, sol, probdata->bin_vars[i], wval) );
+      for( int j = 0; j < dim; j++ )
+      {
+         size_t k = (size_t) i * dim + j;
+         z[k] = 2.0 * unif(rng) - 1.0;
+         t[k] = unif(rng);
+         w[k] = wval;
+         SCIP_CALL( SCIPsetSolVal(scip, sol, probdata->Z[i][j], z[k]) );
+         SCIP_CALL( SCIPsetSolVal(scip, sol, probdata->t[i][j], t[k]) );
+      }
+   }
+
+   /* the nonlinear cones of the points are the constraints "soc<i><j>" of the nonlinear handler */
+   vector<SCIP_CONS*> cones;
+   for( size_t c = 0; c < probdata->conss.size(); c++ )
+   {
+      SCIP_CONS* cons = probdata->conss[c];
+      if( strcmp(SCIPconshdlrGetName(SCIPconsGetHdlr(cons)), "nonlinear") == 0
+         && strncmp(SCIPconsGetName(cons), "soc", 3) == 0 )
+         cones.push_back(cons);
+   }
+
+   ConeKernelIsa isa = coneKernelBestIsa();
+   Timing expr = {name, "cone-expr", {}, cones.size() / 1e6, "Mcones/s"};
+   Timing scal = {name, "cone-scal", {}, ncones / 1e6, "Mcones/s"};
+   Timing simd = {name, "cone-simd", {}, ncones / 1e6, "Mcones/s"};
+   double checksum = 0.0;
+
+   for( int r = -1; r < reps; r++ )
+   {
+      double start = now();
+      for( size_t c = 0; c < cones.size(); c++ )
+      {
+         SCIP_Real viol;
+         SCIP_CALL( SCIPgetAbsViolationNonlinear(scip, cones[c], sol, &viol) );
+         checksum += viol;
+      }
+      double texpr = now() - start;
+
+      start = now();
+      coneEfficacies(CONEKERNEL_SCALAR, ncones, z.data(), t.data(), w.data(), efficacy.data());
+      double tscal = now() - start;
+      checksum += efficacy[0];
+
+      start = now();
+      coneEfficacies(isa, ncones, z.data(), t.data(), w.data(), efficacy.data());
+      double tsimd = now() - start;
+      checksum += efficacy[0];
+
+      /* the first round is a warm-up */
+      if( r < 0 )
+         continue;
+
+      expr.samples.push_back(texpr);
+      scal.samples.push_back(tscal);
+      simd.samples.push_back(tsimd);
+   }
+
+   SCIP_CALL( SCIPfreeSol(scip, &sol) );
+   SCIP_CALL( SCIPfree(&scip) );
+
+   /* keeps the evaluations from being optimized away */
+   if( checksum == 0.123456789 )
+      printf("\n");
+
+   timings.push_back(expr);
+   timings.push_back(scal);
+   timings.push_back(simd);
+
+   return SCIP_OKAY;
+}
+
+/** runs the dense kernels of the information matrix of the greedy design of one instance, specialized on its
+ *  dimension and generic
+ */
+static
+SCIP_RETCODE benchDimKernels(
+   const string&         name,               /**< name of the case */
+   const string&         filename,           /**< name of the instance file */
+   int                   reps,               /**< number of measured repetitions */
+   vector<Timing>&       timings             /**< vector to append the timings to */
+   )
+{
+   const int nfactor = 1000;
+   const int nrankone = 1000;
+   int numvars, dim, card;
+   SCIP_Real epsilon;
+   vector<vector<SCIP_Real>> A;
+
+   SCIP_CALL( readDesignData(filename.c_str(), numvars, dim, card, epsilon, A) );
+
+   vector<int> points;
+   greedyDesign(A, epsilon, card > 0 ? card : dim, points);
+   vector<double> M;
+   informationMatrix(A, points, epsilon, M);
+
+   /* M^-1 = L^-T L^-1, where row j of Linvt is the solution of L x = e_j */
+   vector<double> L = M;
+   if( !choleskyFactor(dim, L) )
+   {
+      printf("information matrix of <%s> is singular\n", filename.c_str());
+      return SCIP_INVALIDDATA;
+   }
+   vector<double> Linvt(dim * dim);
+   vector<double> x(dim);
+   for( int j = 0; j < dim; j++ )
+   {
+      x.assign(dim, 0.0);
+      x[j] = 1.0;
+      choleskySolveLower(dim, L, x.data());
+      for( int k = 0; k < dim; k++ )
+         Linvt[j * dim + k] = x[k];
+   }
+   vector<double> Minv(dim * dim, 0.0);
+   for( int j1 = 0; j1 < dim; j1++ )
+      for( int j2 = 0; j2 < dim; j2++ )
+         for( int k = 0; k < dim; k++ )
+            Minv[j1 * dim + j2] += Linvt[j1 * dim + k] * Linvt[j2 * dim + k];
+
+   vector<double> lev(numvars);
+   vector<double> u(dim);
+   vector<double> a(dim);
+   double checksum = 0.0;
+
+   for( int s = 0; s < 2; s++ )
+   {
+      DimKernel kernel = dimKernel(dim, s == 1);
+      string suffix = kernel.fixeddim > 0 ? "-fix" : "-gen";
+      Timing chol = {name, "chol" + suffix, {}, nfactor / 1e3, "kfact/s"};
+      Timing logdet = {name, "logdet" + suffix, {}, nfactor / 1e3, "kdet/s"};
+      Timing leverage = {name, "lev" + suffix, {}, numvars / 1e6, "Mpoints/s"};
+      Timing rankone = {name, "rank1" + suffix, {}, nrankone / 1e3, "kupd/s"};
+
+      for( int r = -1; r < reps; r++ )
+      {
+         double start = now();
+         for( int k = 0; k < nfactor; k++ )
+         {
+            L = M;
+            checksum += kernel.factor(dim, L.data()) ? 1.0 : 0.0;
+         }
+         double tchol = now() - start;
+
+         start = now();
+         for( int k = 0; k < nfactor; k++ )
+            checksum += kernel.logdet(dim, L.data());
+         double tlogdet = now() - start;
+
+         start = now();
+         kernel.leverages(dim, A, L.data(), 0, numvars, lev.data());
+         double tlev = now() - start;
+         checksum += lev[0];
+
+         /* pairs of updates with +1 and -1 keep the inverse */
+         vector<double> Mtmp = Minv;
+         start = now();
+         for( int k = 0; k < nrankone; k++ )
+         {
+            int i = (k / 2) % numvars;
+            for( int j = 0; j < dim; j++ )
+               a[j] = A[j][i];
+            checksum += kernel.rankOne(dim, Mtmp.data(), a.data(), k % 2 == 0 ? 1.0 : -1.0, u.data());
+         }
+         double trankone = now() - start;
+
+         /* the first round is a warm-up */
+         if( r < 0 )
+            continue;
+
+         chol.samples.push_back(tchol);
+         logdet.samples.push_back(tlogdet);
+         leverage.samples.push_back(tlev);
+         rankone.samples.push_back(trankone);
+      }
+
+      timings.push_back(chol);
+      timings.push_back(logdet);
+      timings.push_back(leverage);
+      timings.push_back(rankone);
+   }
+
+   /* keeps the kernels from being optimized away */
+   if( checksum == 0.123456789 )
+      printf("\n");
+
+   return SCIP_OKAY;
+}
+
+/** runs the greedy design, the log-determinant of a design and the exchange heuristic of a comparison design
+ *  instance with the Laplacian machinery of laplacian.h and with the generic dense code; does nothing for instances
+ *  of other points
+ */
+static
+SCIP_RETCODE benchLaplacian(
+   const string&         name,               /**< name of the case */
+   const string&         filename,           /**< name of the instance file */
+   int                   reps,               /**< number of measured repetitions */
+   vector<Timing>&       timings             /**< vector to append the timings to */
+   )
+{
+   const int nlogdet = 100;
+   int numvars, dim, card;
+   SCIP_Real epsilon;
+   vector<vector<SCIP_Real>> A;
+
+   SCIP_CALL( readDesignData(filename.c_str(), numvars, dim, card, epsilon, A) );
+
+   vector<pair<int, int>> edges;
+   if( !incidenceEdges(A, edges) )
+      return SCIP_OKAY;
+
+   int size = card > 0 ? card : dim;
+   Timing greedygen = {name, "greedy-gen", {}, 0.0, ""};
+   Timing greedylap = {name, "greedy-lap", {}, 0.0, ""};
+   Timing logdetgen = {name, "logdet-gen", {}, nlogdet / 1e3, "kdet/s"};
+   Timing logdetlap = {name, "logdet-lap", {}, nlogdet / 1e3, "kdet/s"};
+   Timing exchange = {name, "exchange", {}, 0.0, ""};
+   DimKernel kernel = dimKernel(dim);
+   vector<int> points;
+   vector<double> M;
+   double checksum = 0.0;
+
+   for( int r = -1; r < reps; r++ )
+   {
+      double start = now();
+      greedyDesign(A, epsilon, size, points);
+      double tgreedygen = now() - start;
+
+      start = now();
+      laplacianGreedyDesign(dim, edges, epsilon, size, points);
+      double tgreedylap = now() - start;
+
+      start = now();
+      for( int k = 0; k < nlogdet; k++ )
+      {
+         informationMatrix(A, points, epsilon, M);
+         if( choleskyFactor(dim, M) )
+            checksum += choleskyLogdet(dim, M);
+      }
+      double tlogdetgen = now() - start;
+
+      start = now();
+      for( int k = 0; k < nlogdet; k++ )
+         checksum += laplacianLogdet(dim, edges, points, epsilon);
+      double tlogdetlap = now() - start;
+
+      start = now();
+      checksum += laplacianExchange(dim, edges, epsilon, 1000, kernel, points);
+      double texchange = now() - start;
+
+      /* the first round is a warm-up */
+      if( r < 0 )
+         continue;
+
+      greedygen.samples.push_back(tgreedygen);
+      greedylap.samples.push_back(tgreedylap);
+      logdetgen.samples.push_back(tlogdetgen);
+      logdetlap.samples.push_back(tlogdetlap);
+      exchange.samples.push_back(texchange);
+   }
+
+   /* keeps the evaluations from being optimized away */
+   if( checksum == 0.123456789 )
+      printf("\n");
+
+   timings.push_back(greedygen);
+   timings.push_back(greedylap);
+   timings.push_back(logdetgen);
+   timings.push_back(logdetlap);
+   timings.push_back(exchange);
+
+   return SCIP_OKAY;
+}
+
+/** prints the table of timings and optionally writes them to a csv file */
+static
+void reportTimings(
+   vector<Timing>&       timings,            /**< timings */
+   const string&         csvfile             /**< name of csv file, or empty */
+   )
+{
+   FILE* csv = csvfile.empty() ? NULL : fopen(csvfile.c_str(), "w");
+   if( csv != NULL )
+      fprintf(csv, "case,quantity,unit,median,p10,p90,min,rate\n");
+
+   printf("%-32s %-10s %12s %12s %12s %12s %14s\n", "case", "quantity", "median[ms]", "p10[ms]", "p90[ms]", "min[ms]", "rate");
+   for( size_t k = 0; k < timings.size(); k++ )
+   {
+      Timing& t = timings[k];
+      sort(t.samples.begin(), t.samples.end());
+      double med = quantile(t.samples, 0.5);
+      double rate = (t.unit.empty() || med <= 0.0) ? 0.0 : t.work / med;
+      char ratestr[64] = "";
+      if( !t.unit.empty() )
+         snprintf(ratestr, sizeof(ratestr), "%.2f %s", rate, t.unit.c_str());
+
+      printf("%-32s %-10s %12.3f %12.3f %12.3f %12.3f %14s\n", t.name.c_str(), t.quantity.c_str(), 1e3 * med,
+         1e3 * quantile(t.samples, 0.1), 1e3 * quantile(t.samples, 0.9), 1e3 * t.samples[0], ratestr);
+      if( csv != NULL )
+         fprintf(csv, "%s,%s,%s,%.9g,%.9g,%.9g,%.9g,%.9g\n", t.name.c_str(), t.quantity.c_str(), t.unit.c_str(), med,
+            quantile(t.samples, 0.1), quantile(t.samples, 0.9), t.samples[0], rate);
+   }
+
+   if( csv != NULL )
+      fclose(csv);
+}
+
+/** compares the medians against a baseline csv file; returns the number of regressions */
+static
+int compareBaseline(
+   const vector<Timing>& timings,            /**< sorted timings */
+   const string&         baselinefile,       /**< name of the baseline csv file */
+   double                tolerance           /**< allowed relative slowdown of a median */
+   )
+{
+   ifstream f(baselinefile);
+   if( !f )
+   {
+      printf("cannot open baseline <%s>\n", baselinefile.c_str());
+      return 1;
+   }
+
+   map<string, double> baseline;
+   string line;
+   getline(f, line);
+   while( getline(f, line) )
+   {
+      stringstream ss(line);
+      string casename, quantity, unit, median;
+      getline(ss, casename, ',');
+      getline(ss, quantity, ',');
+      getline(ss, unit, ',');
+      getline(ss, median, ',');
+      baseline[casename + "/" + quantity + "/" + unit] = atof(median.c_str());
+   }
+
+   int nregressions = 0;
+   for( size_t k = 0; k < timings.size(); k++ )
+   {
+      const Timing& t = timings[k];
+      map<string, double>::const_iterator it = baseline.find(t.name + "/" + t.quantity + "/" + t.unit);
+      if( it == baseline.end() || it->second <= 0.0 )
+         continue;
+      double med = quantile(t.samples, 0.5);
+      if( med > (1.0 + tolerance) * it->second )
+      {
+         printf("regression: %s %s median %.3f ms, baseline %.3f ms (+%.1f%%)\n", t.name.c_str(), t.quantity.c_str(),
+            1e3 * med, 1e3 * it->second, 100.0 * (med / it->second - 1.0));
+         nregressions++;
+      }
+   }
+   return nregressions;
+}
+
+/** main function of the benchmark */
+int main(
+   int                   argc,               /**< number of arguments */
+   char**                argv                /**< arguments */
+   )
+{
+   int reps = 7;
+   string dir = "benchmark";
+   string csvfile;
+   string baselinefile;
+   double tolerance = 0.10;
+   vector<int> scales = {2, 4, 8};
+   vector<string> files;
+
+   for( int i = 1; i < argc; i++ )
+   {
+      if( strcmp(argv[i], "-r") == 0 && i + 1 < argc )
+         reps = max(1, atoi(argv[++i]));
+      else if( strcmp(argv[i], "-d") == 0 && i + 1 < argc )
+         dir = argv[++i];
+      else if( strcmp(argv[i], "-o") == 0 && i + 1 < argc )
+         csvfile = argv[++i];
+      else if( strcmp(argv[i], "-b") == 0 && i + 1 < argc )
+         baselinefile = argv[++i];
+      else if( strcmp(argv[i], "-t") == 0 && i + 1 < argc )
+         tolerance = atof(argv[++i]);
+      else if( strcmp(argv[i], "-s") == 0 && i + 1 < argc )
+      {
+         scales.clear();
+         stringstream ss(argv[++i]);
+         string tok;
+         while( getline(ss, tok, ',') )
+            if( atoi(tok.c_str()) > 0 )
+               scales.push_back(atoi(tok.c_str()));
+      }
+      else
+         files.push_back(argv[i]);
+   }
+
+   if( files.empty() )
+   {
+      for( size_t k = 0; k < sizeof(defaultinstances) / sizeof(defaultinstances[0]); k++ )
+         files.push_back(dir + "/" + defaultinstances[k]);
+   }
+
+   vector<Timing> timings;
+
+   /* instances from the benchmark set */
+   for( size_t k = 0; k < files.size(); k++ )
+   {
+      string name = files[k].substr(files[k].find_last_of('/') + 1);
+      SCIP_RETCODE retcode = benchInstance(name, files[k], reps, timings);
+      if( retcode == SCIP_OKAY )
+         retcode = benchConeKernel(name, files[k], reps, timings);
+      if( retcode == SCIP_OKAY )
+         retcode = benchDimKernels(name, files[k], reps, timings);
+      if( retcode == SCIP_OKAY )
+         retcode = benchLaplacian(name, files[k], reps, timings);
+      if( retcode != SCIP_OKAY )
+      {
+         printf("failed to benchmark <%s>\n", files[k].c_str());
+         SCIPprintError(retcode);
+         return 1;
+      }
+   }
+
+   /* synthetic scale-ups of the largest normal instances: numvars = 70 * scale, dim = 42 */
+   for( size_t k = 0; k < scales.size(); k++ )
+   {
+      int numvars = 70 * scales[k];
+      string name = "synthetic_" + to_string(numvars) + "_42_42";
+      string filename = "/tmp/doptbench_" + name + ".design";
+      if( !writeNormalInstance(filename, numvars, 42, 42, 1e-6, 20220101ull + k) )
+      {
+         printf("cannot write <%s>\n", filename.c_str());
+         return 1;
+      }
+      SCIP_RETCODE retcode = benchInstance(name, filename, reps, timings);
+      if( retcode == SCIP_OKAY )
+         retcode = benchConeKernel(name, filename, reps, timings);
+      if( retcode == SCIP_OKAY )
+         retcode = benchDimKernels(name, filename, reps, timings);
+      remove(filename.c_str());
+      if( retcode != SCIP_OKAY )
+      {
+         printf("failed to benchmark <%s>\n", name.c_str());
+         SCIPprintError(retcode);
+         return 1;
+      }
+   }
+
+   /* synthetic comparison designs of 40 treatments with as many comparisons as the scale-ups above */
+   for( size_t k = 0; k < scales.size(); k++ )
+   {
+      int numedges = 70 * scales[k];
+      string name = "synthetic_block2_" + to_string(numedges) + "_41_80";
+      string filename = "/tmp/doptbench_" + name + ".design";
+      if( !writeBlockInstance(filename, 41, numedges, 80, 1e-6, 20220101ull + k) )
+      {
+         printf("cannot write <%s>\n", filename.c_str());
+         return 1;
+      }
+      SCIP_RETCODE retcode = benchLaplacian(name, filename, reps, timings);
+      remove(filename.c_str());
+      if( retcode != SCIP_OKAY )
+      {
+         printf("failed to benchmark <%s>\n", name.c_str());
+         SCIPprintError(retcode);
+         return 1;
+      }
+   }
+
+   reportTimings(timings, csvfile);
+
+   if( !baselinefile.empty() && compareBaseline(timings, baselinefile, tolerance) > 0 )
+      return 1;
+
+   return 0;
+}
@@ -0,0 +1,188 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   conekernel.cpp
+ * @brief  vectorized evaluation of the cones Z_ij^2 <= t_ij w_i over the whole grid
+ * @author Liding Xu
+ *
+ * The AVX2 and AVX-512 versions are compiled with target attributes, so they are available in any build on x86-64
+ * and only called if the processor supports them.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <float.h>
+
+#include "conekernel.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CONEKERNEL_X86
+#include <immintrin.h>
+#endif
+
+
+/** efficacy of a single cone */
+static inline
+double coneEfficacy(
+   double                z,                  /**< value of Z */
+   double                t,                  /**< value of t */
+   double                w                   /**< value of w */
+   )
+{
+   double d = t - w;
+   double n = sqrt(4.0 * z * z + d * d);
+   double den = 24.0 * z * z + 4.0 * d * d;
+
+   return (n - t - w) * n / sqrt(den > DBL_MIN ? den : DBL_MIN);
+}
+
+/** scalar kernel */
+static
+void coneEfficaciesScalar(
+   size_t                n,                  /**< number of cones */
+   const double*         z,                  /**< values of Z */
+   const double*         t,                  /**< values of t */
+   const double*         w,                  /**< values of w */
+   double*               efficacy            /**< array to store the efficacies */
+   )
+{
+   for( size_t k = 0; k < n; k++ )
+      efficacy[k] = coneEfficacy(z[k], t[k], w[k]);
+}
+
+#ifdef CONEKERNEL_X86
+
+/** AVX2 kernel */
+__attribute__((target("avx2,fma")))
+static
+void coneEfficaciesAvx2(
+   size_t                n,                  /**< number of cones */
+   const double*         z,                  /**< values of Z */
+   const double*         t,                  /**< values of t */
+   const double*         w,                  /**< values of w */
+   double*               efficacy            /**< array to store the efficacies */
+   )
+{
+   const __m256d four = _mm256_set1_pd(4.0);
+   const __m256d twentyfour = _mm256_set1_pd(24.0);
+   const __m256d tiny = _mm256_set1_pd(DBL_MIN);
+   size_t k = 0;
+
+   for( ; k + 4 <= n; k += 4 )
+   {
+      __m256d zv = _mm256_loadu_pd(z + k);
+      __m256d tv = _mm256_loadu_pd(t + k);
+      __m256d wv = _mm256_loadu_pd(w + k);
+      __m256d d = _mm256_sub_pd(tv, wv);
+      __m256d zz = _mm256_mul_pd(zv, zv);
+      __m256d dd = _mm256_mul_pd(d, d);
+      __m256d norm = _mm256_sqrt_pd(_mm256_fmadd_pd(four, zz, dd));
+      __m256d den = _mm256_max_pd(_mm256_fmadd_pd(twentyfour, zz, _mm256_mul_pd(four, dd)), tiny);
+      __m256d viol = _mm256_sub_pd(_mm256_sub_pd(norm, tv), wv);
+      _mm256_storeu_pd(efficacy + k, _mm256_div_pd(_mm256_mul_pd(viol, norm), _mm256_sqrt_pd(den)));
+   }
+
+   coneEfficaciesScalar(n - k, z + k, t + k, w + k, efficacy + k);
+}
+
+/** AVX-512 kernel */
+__attribute__((target("avx512f")))
+static
+void coneEfficaciesAvx512(
+   size_t                n,                  /**< number of cones */
+   const double*         z,                  /**< values of Z */
+   const double*         t,                  /**< values of t */
+   const double*         w,                  /**< values of w */
+   double*               efficacy            /**< array to store the efficacies */
+   )
+{
+   const __m512d four = _mm512_set1_pd(4.0);
+   const __m512d twentyfour = _mm512_set1_pd(24.0);
+   const __m512d tiny = _mm512_set1_pd(DBL_MIN);
+   size_t k = 0;
+
+   for( ; k + 8 <= n; k += 8 )
+   {
+      __m512d zv = _mm512_loadu_pd(z + k);
+      __m512d tv = _mm512_loadu_pd(t + k);
+      __m512d wv = _mm512_loadu_pd(w + k);
+      __m512d d = _mm512_sub_pd(tv, wv);
+      __m512d zz = _mm512_mul_pd(zv, zv);
+      __m512d dd = _mm512_mul_pd(d, d);
+      __m512d norm = _mm512_sqrt_pd(_mm512_fmadd_pd(four, zz, dd));
+      __m512d den = _mm512_max_pd(_mm512_fmadd_pd(twentyfour, zz, _mm512_mul_pd(four, dd)), tiny);
+      __m512d viol = _mm512_sub_pd(_mm512_sub_pd(norm, tv), wv);
+      _mm512_storeu_pd(efficacy + k, _mm512_div_pd(_mm512_mul_pd(viol, norm), _mm512_sqrt_pd(den)));
+   }
+
+   coneEfficaciesScalar(n - k, z + k, t + k, w + k, efficacy + k);
+}
+
+#endif
+
+
+/** returns the best instruction set supported by the processor */
+ConeKernelIsa coneKernelBestIsa()
+{
+#ifdef CONEKERNEL_X86
+   __builtin_cpu_init();
+   if( __builtin_cpu_supports("avx512f") )
+      return CONEKERNEL_AVX512;
+   if( __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") )
+      return CONEKERNEL_AVX2;
+#endif
+   return CONEKERNEL_SCALAR;
+}
+
+/** returns the name of an instruction set */
+const char* coneKernelIsaName(
+   ConeKernelIsa         isa                 /**< instruction set */
+   )
+{
+   switch( isa )
+   {
+   case CONEKERNEL_AVX512:
+      return "avx512";
+   case CONEKERNEL_AVX2:
+      return "avx2";
+   default:
+      return "scalar";
+   }
+}
+
+/** computes the efficacy of the gradient cut of the cones k = 0, ..., n - 1 */
+void coneEfficacies(
+   ConeKernelIsa         isa,                /**< instruction set to use, must be supported by the processor */
+   size_t                n,                  /**< number of cones */
+   const double*         z,                  /**< values of Z */
+   const double*         t,                  /**< values of t */
+   const double*         w,                  /**< values of w */
+   double*               efficacy            /**< array to store the efficacies */
+   )
+{
+#ifdef CONEKERNEL_X86
+   if( isa == CONEKERNEL_AVX512 )
+   {
+      coneEfficaciesAvx512(n, z, t, w, efficacy);
+      return;
+   }
+   if( isa == CONEKERNEL_AVX2 )
+   {
+      coneEfficaciesAvx2(n, z, t, w, efficacy);
+      return;
+   }
+#endif
+   coneEfficaciesScalar(n, z, t, w, efficacy);
+}
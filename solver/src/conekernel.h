@@ -0,0 +1,83 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   conekernel.h
+ * @brief  vectorized evaluation of the cones Z_ij^2 <= t_ij w_i over the whole grid
+ * @author Liding Xu
+ *
+ * The cone is |(2 z, t - w)| <= t + w. With d = t - w and n = |(2 z, d)|, the gradient cut at a violated point has
+ * the coefficients (4 z / n, d / n - 1, -d / n - 1) for (Z, t, w) and right hand side 0, violation n - (t + w) and
+ * squared coefficient norm (24 z^2 + 4 d^2) / n^2. The kernel computes the efficacy
+ *
+ *    (n - t - w) n / sqrt(24 z^2 + 4 d^2)
+ *
+ * of all cones of flat arrays in one pass, with AVX-512, AVX2 or scalar code chosen at runtime; the coefficients are
+ * only computed for the few cones that are selected.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_CONEKERNEL_H__
+#define __SCIP_CONEKERNEL_H__
+
+#include <stddef.h>
+#include <math.h>
+
+/** instruction sets of the cone kernel */
+enum ConeKernelIsa
+{
+   CONEKERNEL_SCALAR = 0,                    /**< portable scalar code */
+   CONEKERNEL_AVX2   = 1,                    /**< AVX2 with FMA, 4 cones per instruction */
+   CONEKERNEL_AVX512 = 2                     /**< AVX-512F, 8 cones per instruction */
+};
+
+/** returns the best instruction set supported by the processor */
+ConeKernelIsa coneKernelBestIsa();
+
+/** returns the name of an instruction set */
+const char* coneKernelIsaName(
+   ConeKernelIsa         isa                 /**< instruction set */
+   );
+
+/** computes the efficacy of the gradient cut of the cones k = 0, ..., n - 1 with values z[k], t[k], w[k]; it is
+ *  nonpositive for cones that are satisfied, including z = t = w = 0
+ */
+void coneEfficacies(
+   ConeKernelIsa         isa,                /**< instruction set to use, must be supported by the processor */
+   size_t                n,                  /**< number of cones */
+   const double*         z,                  /**< values of Z */
+   const double*         t,                  /**< values of t */
+   const double*         w,                  /**< values of w */
+   double*               efficacy            /**< array to store the efficacies */
+   );
+
+/** computes the coefficients of Z, t and w in the gradient cut of a violated cone, with right hand side 0 */
+inline
+void coneCutCoefs(
+   double                z,                  /**< value of Z */
+   double                t,                  /**< value of t */
+   double                w,                  /**< value of w */
+   double*               coefs               /**< array of length 3 to store the coefficients */
+   )
+{
+   double d = t - w;
+   double n = sqrt(4.0 * z * z + d * d);
+
+   coefs[0] = 4.0 * z / n;
+   coefs[1] = d / n - 1.0;
+   coefs[2] = -d / n - 1.0;
+}
+
+#endif
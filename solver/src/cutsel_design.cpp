@@ -0,0 +1,412 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   cutsel_design.cpp
+ * @brief  cut selector that groups the cuts by the cone family of the design model and removes duplicates
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <algorithm>
+#include <utility>
+
+#include "cutsel_design.h"
+#include "probdata.h"
+#include "linalg.h"
+#include "table_profile.h"
+
+using namespace scip;
+using namespace std;
+
+#define CUTSEL_NAME              "designcutsel"
+#define CUTSEL_DESC              "cut selector by cone families of the design model with duplicate removal"
+#define CUTSEL_PRIORITY          10000       /**< above the hybrid selector of SCIP (8000) */
+
+#define DEFAULT_MAXFAMILYCUTS    2           /**< maximal number of cuts of a family per round below the root */
+#define DEFAULT_MAXFAMILYCUTSROOT 5          /**< maximal number of cuts of a family per round at the root */
+#define DEFAULT_LEVWEIGHT        1.0         /**< weight of the leverage of the point of a cut in its score */
+#define DEFAULT_DUPTOL           1e-6        /**< rounding of the normalized coefficients of the duplicate detection */
+#define DEFAULT_MAXPARALLEL      0.99        /**< maximal parallelism of two cuts of a family in a round */
+
+#define FAMILY_OTHER             -1          /**< family of the cuts on several families or unknown variables */
+
+
+/** default constructor */
+CutselDesign::CutselDesign(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjCutsel(scip, CUTSEL_NAME, CUTSEL_DESC, CUTSEL_PRIORITY),
+     duptol_(DEFAULT_DUPTOL),
+     levweight_(DEFAULT_LEVWEIGHT),
+     maxfamilycuts_(DEFAULT_MAXFAMILYCUTS),
+     maxfamilycutsroot_(DEFAULT_MAXFAMILYCUTSROOT),
+     maxparallel_(DEFAULT_MAXPARALLEL),
+     nmappedvars_(-1),
+     npoints_(0),
+     dim_(0),
+     ncalls_(0),
+     ncuts_(0),
+     nselected_(0),
+     nduplicates_(0),
+     nlimited_(0)
+{
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "cutselection/" CUTSEL_NAME "/maxfamilycuts",
+         "maximal number of cuts of a design point, a column of J or the objective per round below the root",
+         &maxfamilycuts_, FALSE, DEFAULT_MAXFAMILYCUTS, 1, INT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "cutselection/" CUTSEL_NAME "/maxfamilycutsroot",
+         "maximal number of cuts of a design point, a column of J or the objective per round at the root",
+         &maxfamilycutsroot_, FALSE, DEFAULT_MAXFAMILYCUTSROOT, 1, INT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "cutselection/" CUTSEL_NAME "/levweight",
+         "weight of the leverage of the point of a cut in the LP design, the score is efficacy * (1 + levweight * leverage)",
+         &levweight_, FALSE, DEFAULT_LEVWEIGHT, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "cutselection/" CUTSEL_NAME "/duptol",
+         "cuts whose coefficients and sides divided by the norm agree after rounding to multiples of duptol are duplicates",
+         &duptol_, FALSE, DEFAULT_DUPTOL, 1e-12, 1.0, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "cutselection/" CUTSEL_NAME "/maxparallel",
+         "maximal parallelism of a selected cut to the selected cuts of its family",
+         &maxparallel_, FALSE, DEFAULT_MAXPARALLEL, 0.0, 1.0, NULL, NULL) );
+}
+
+
+/** maps the variables of the problem data to their families; returns false if there is no design problem data */
+bool CutselDesign::updateFamilies(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( probdata == NULL || probdata->obj_var == NULL )
+      return false;
+
+   /* the pricer adds the columns of points during the solve */
+   if( nmappedvars_ == SCIPgetNVars(scip) )
+      return true;
+
+   npoints_ = probdata->numvars;
+   dim_ = probdata->dim;
+   varfamily_.clear();
+
+   auto map = [this](SCIP_VAR* var, int family) {
+      if( var != NULL )
+         varfamily_[var] = family;
+   };
+   for( int i = 0; i < npoints_; i++ )
+   {
+      if( i < (int) probdata->Z.size() )
+      {
+         for( SCIP_VAR* var : probdata->Z[i] )
+            map(var, i);
+      }
+      if( i < (int) probdata->t.size() )
+      {
+         for( SCIP_VAR* var : probdata->t[i] )
+            map(var, i);
+      }
+      if( i < (int) probdata->w.size() )
+         map(probdata->w[i], i);
+      if( i < (int) probdata->bin_vars.size() )
+         map(probdata->bin_vars[i], i);
+   }
+   for( int j1 = 0; j1 < dim_; j1++ )
+   {
+      for( int j2 = 0; j2 < dim_; j2++ )
+      {
+         if( j1 < (int) probdata->J.size() && j2 < (int) probdata->J[j1].size() )
+            map(probdata->J[j1][j2], npoints_ + j2);
+         if( j1 < (int) probdata->epsZ.size() && j2 < (int) probdata->epsZ[j1].size() )
+            map(probdata->epsZ[j1][j2], npoints_ + j2);
+         if( j1 < (int) probdata->epsZ2.size() && j2 < (int) probdata->epsZ2[j1].size() )
+            map(probdata->epsZ2[j1][j2], npoints_ + j2);
+      }
+   }
+   if( npoints_ < (int) probdata->t.size() )
+   {
+      for( int j = 0; j < (int) probdata->t[npoints_].size(); j++ )
+         map(probdata->t[npoints_][j], npoints_ + j);
+   }
+   map(probdata->obj_var, npoints_ + dim_);
+
+   /* the rotated coordinates of a polyhedral cone belong to the family of its square */
+   for( const ProbData::PolyCone& cone : probdata->poly_cones )
+   {
+      auto it = varfamily_.find(cone.u);
+      if( it == varfamily_.end() )
+         continue;
+      int family = it->second;
+      for( SCIP_VAR* var : cone.xi )
+         map(var, family);
+      for( SCIP_VAR* var : cone.eta )
+         map(var, family);
+   }
+
+   nmappedvars_ = SCIPgetNVars(scip);
+
+   return true;
+}
+
+
+/** returns the family of a cut */
+int CutselDesign::cutFamily(
+   SCIP_ROW*             cut                 /**< the cut */
+   ) const
+{
+   int objfamily = npoints_ + dim_;
+   int family = FAMILY_OTHER;
+   SCIP_COL** cols = SCIProwGetCols(cut);
+   int ncols = SCIProwGetNNonz(cut);
+   bool mixed = false;
+
+   for( int k = 0; k < ncols; k++ )
+   {
+      auto it = varfamily_.find(SCIPcolGetVar(cols[k]));
+      if( it == varfamily_.end() )
+      {
+         mixed = true;
+         continue;
+      }
+      if( it->second == objfamily )
+         return objfamily;
+      if( family == FAMILY_OTHER )
+         family = it->second;
+      else if( family != it->second )
+         mixed = true;
+   }
+
+   return mixed ? FAMILY_OTHER : family;
+}
+
+
+/** computes the leverages of the points in the continuous design of the LP values of the binaries */
+void CutselDesign::computeLeverages(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   leverages_.assign(npoints_, 0.0);
+
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( levweight_ == 0.0 || probdata->epsilon <= 0.0 || (int) probdata->bin_vars.size() < npoints_ )
+      return;
+
+   weights_.assign(npoints_, 0.0);
+   for( int i = 0; i < npoints_; i++ )
+   {
+      SCIP_VAR* var = probdata->bin_vars[i];
+      if( var != NULL )
+         weights_[i] = MAX(MIN(SCIPgetSolVal(scip, NULL, var), 1.0), 0.0);
+   }
+
+   /* h_i = a_i^T M^-1 a_i = |L^-1 a_i|^2; all leverages stay 0 if M is not positive definite */
+   weightedInformationMatrix(probdata->A, weights_, probdata->epsilon * probdata->epsilon, M_);
+   if( probdata->kernel.factor(dim_, M_.data()) )
+      probdata->kernel.leverages(dim_, probdata->A, M_.data(), 0, npoints_, leverages_.data());
+}
+
+
+/** rounds a normalized coefficient or side to a multiple of tol */
+static
+long long quantize(
+   SCIP_Real             val,                /**< the value */
+   SCIP_Real             tol                 /**< the rounding */
+   )
+{
+   SCIP_Real q = val / tol;
+   if( q >= 1e18 )
+      return LLONG_MAX;
+   if( q <= -1e18 )
+      return LLONG_MIN + 1;
+   return llround(q);
+}
+
+
+/** computes the key of the duplicate detection of a cut: the pairs of column index and rounded coefficient by
+ *  increasing index, then the rounded sides, all divided by the norm of the cut; returns its hash
+ */
+static
+size_t cutKey(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_ROW*             cut,                /**< the cut */
+   SCIP_Real             tol,                /**< rounding of the normalized values */
+   vector<pair<long long, long long>>& key   /**< vector to store the key */
+   )
+{
+   SCIP_COL** cols = SCIProwGetCols(cut);
+   SCIP_Real* vals = SCIProwGetVals(cut);
+   int ncols = SCIProwGetNNonz(cut);
+   SCIP_Real norm = SCIProwGetNorm(cut);
+   if( norm <= 0.0 )
+      norm = 1.0;
+
+   key.resize(ncols);
+   for( int k = 0; k < ncols; k++ )
+      key[k] = make_pair((long long) SCIPcolGetIndex(cols[k]), quantize(vals[k] / norm, tol));
+   sort(key.begin(), key.end());
+
+   SCIP_Real constant = SCIProwGetConstant(cut);
+   SCIP_Real lhs = SCIProwGetLhs(cut);
+   SCIP_Real rhs = SCIProwGetRhs(cut);
+   key.push_back(make_pair(SCIPisInfinity(scip, -lhs) ? LLONG_MIN : quantize((lhs - constant) / norm, tol),
+         SCIPisInfinity(scip, rhs) ? LLONG_MAX : quantize((rhs - constant) / norm, tol)));
+
+   size_t hash = key.size();
+   for( const pair<long long, long long>& entry : key )
+   {
+      hash ^= std::hash<long long>()(entry.first) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+      hash ^= std::hash<long long>()(entry.second) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+   }
+
+   return hash;
+}
+
+
+/** solving process initialization method of cut selector (called when branch and bound process is about to begin) */
+SCIP_DECL_CUTSELINITSOL(CutselDesign::scip_initsol)
+{
+   nmappedvars_ = -1;
+   varfamily_.clear();
+   ncalls_ = 0;
+   ncuts_ = 0;
+   nselected_ = 0;
+   nduplicates_ = 0;
+   nlimited_ = 0;
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of cut selector (called before branch and bound process data is freed) */
+SCIP_DECL_CUTSELEXITSOL(CutselDesign::scip_exitsol)
+{
+   if( ncalls_ > 0 )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+         "designcutsel cut selector: %lld rounds, %lld cuts, %lld selected, %lld duplicates, %lld over family limits\n",
+         (long long) ncalls_, (long long) ncuts_, (long long) nselected_, (long long) nduplicates_,
+         (long long) nlimited_);
+   }
+   varfamily_.clear();
+   nmappedvars_ = -1;
+
+   return SCIP_OKAY;
+}
+
+
+/** cut selection method of cut selector */
+SCIP_DECL_CUTSELSELECT(CutselDesign::scip_select)
+{
+   DOPT_PROFILE(scip, "designcutsel/select");
+   *result = SCIP_DIDNOTFIND;
+   *nselectedcuts = 0;
+
+   /* without the problem data, the round is left to the next selector */
+   if( !updateFamilies(scip) )
+      return SCIP_OKAY;
+
+   ncalls_++;
+   ncuts_ += ncuts;
+   computeLeverages(scip);
+
+   int nfamilies = npoints_ + dim_ + 1;
+   int maxpercall = root ? maxfamilycutsroot_ : maxfamilycuts_;
+   vector<int> nfamilycuts(nfamilies, 0);
+   vector<vector<SCIP_ROW*>> familycuts(nfamilies + 1); /* the last entry holds the other cuts */
+   unordered_multimap<size_t, vector<pair<long long, long long>>> keys;
+   vector<pair<long long, long long>> key;
+
+   /* the forced cuts are selected anyway: they count for their families and their duplicates are dropped */
+   for( int c = 0; c < nforcedcuts; c++ )
+   {
+      int family = cutFamily(forcedcuts[c]);
+      size_t hash = cutKey(scip, forcedcuts[c], duptol_, key);
+      keys.emplace(hash, key);
+      if( family != FAMILY_OTHER )
+         nfamilycuts[family]++;
+      familycuts[family == FAMILY_OTHER ? nfamilies : family].push_back(forcedcuts[c]);
+   }
+
+   /* score of a cut: efficacy, scaled up by the leverage of its point */
+   vector<pair<SCIP_Real, int>> order;
+   vector<int> families(ncuts);
+   order.reserve(ncuts);
+   for( int c = 0; c < ncuts; c++ )
+   {
+      families[c] = cutFamily(cuts[c]);
+      SCIP_Real score = SCIPgetCutEfficacy(scip, NULL, cuts[c]);
+      if( families[c] >= 0 && families[c] < npoints_ )
+         score *= 1.0 + levweight_ * leverages_[families[c]];
+      order.push_back(make_pair(score, c));
+   }
+   sort(order.begin(), order.end(), [](const pair<SCIP_Real, int>& o1, const pair<SCIP_Real, int>& o2) {
+         return o1.first > o2.first || (o1.first == o2.first && o1.second < o2.second); });
+
+   /* greedy selection by decreasing score; the first cut of a key is kept */
+   vector<SCIP_ROW*> selected;
+   vector<SCIP_ROW*> rejected;
+   for( size_t k = 0; k < order.size(); k++ )
+   {
+      int c = order[k].second;
+      SCIP_ROW* cut = cuts[c];
+      int family = families[c];
+
+      if( (int) selected.size() >= maxnselectedcuts )
+      {
+         rejected.push_back(cut);
+         continue;
+      }
+
+      size_t hash = cutKey(scip, cut, duptol_, key);
+      bool duplicate = false;
+      auto range = keys.equal_range(hash);
+      for( auto it = range.first; it != range.second && !duplicate; ++it )
+         duplicate = (it->second == key);
+      if( duplicate )
+      {
+         nduplicates_++;
+         rejected.push_back(cut);
+         continue;
+      }
+
+      vector<SCIP_ROW*>& same = familycuts[family == FAMILY_OTHER ? nfamilies : family];
+      bool limited = (family != FAMILY_OTHER && nfamilycuts[family] >= maxpercall);
+      for( size_t s = 0; s < same.size() && !limited; s++ )
+         limited = (SCIProwGetParallelism(cut, same[s], 'e') > maxparallel_);
+      if( limited )
+      {
+         nlimited_++;
+         rejected.push_back(cut);
+         continue;
+      }
+
+      keys.emplace(hash, key);
+      if( family != FAMILY_OTHER )
+         nfamilycuts[family]++;
+      same.push_back(cut);
+      selected.push_back(cut);
+   }
+
+   /* the selected cuts come first */
+   assert(selected.size() + rejected.size() == (size_t) ncuts);
+   copy(selected.begin(), selected.end(), cuts);
+   copy(rejected.begin(), rejected.end(), cuts + selected.size());
+   *nselectedcuts = (int) selected.size();
+   nselected_ += *nselectedcuts;
+   *result = SCIP_SUCCESS;
+
+   SCIPdebugMsg(scip, "designcutsel: %d of %d cuts selected (%d forced, root %u)\n", *nselectedcuts, ncuts,
+      nforcedcuts, root);
+
+   return SCIP_OKAY;
+}
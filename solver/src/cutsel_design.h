@@ -0,0 +1,110 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   cutsel_design.h
+ * @brief  cut selector that groups the cuts by the cone family of the design model and removes duplicates
+ * @author Liding Xu
+ *
+ * Each cut belongs to a family by its variables: the point i if it has variables of point i only (Z_i*, t_i*, the
+ * binary of i and the variables of its polyhedral cones), which covers the tangent cuts of the cones
+ * Z_ij^2 <= t_ij w_i, the column j of J if it has variables of column j only (J_*j, epsZ_*j, epsZ2_*j, t_(numvars)j),
+ * the objective if it contains obj_var, and other cuts, e.g., the cuts of SCIP's separators, which combine several
+ * families.
+ *
+ * The cuts of a round, including those from the cut pool, are deduplicated: a cut whose coefficients and side,
+ * divided by its norm and rounded to multiples of "duptol", equal those of a better cut is dropped, since the cone
+ * separators produce many nearly identical tangent cuts at nearby LP points. The others are selected by decreasing
+ * efficacy times 1 + "levweight" h_i, where h_i = a_i^T M^-1 a_i is the leverage of the point of the cut in the
+ * continuous design of the LP values of the binaries, M = eps^2 I + sum_i w_i a_i a_i^T, so cuts of points that
+ * change the determinant most come first. A family gets at most "maxfamilycuts" cuts per round ("maxfamilycutsroot"
+ * at the root), other cuts are not limited, and a cut whose parallelism to a selected cut of its family exceeds
+ * "maxparallel" is not selected. Forced cuts are always selected and count for the limits of their family.
+ *
+ * The selector has a higher priority than SCIP's hybrid selector and leaves rounds to it if the problem has no
+ * design problem data; "cutselection/designcutsel/priority" below 8000 gives the rounds to the hybrid selector.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_CUTSEL_DESIGN_H__
+#define __SCIP_CUTSEL_DESIGN_H__
+
+#include <vector>
+#include <unordered_map>
+#include "objscip/objscip.h"
+
+
+/** cut selector by cone families of the design model */
+class CutselDesign : public scip::ObjCutsel
+{
+public:
+   /** default constructor */
+   CutselDesign(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~CutselDesign()
+   {
+   }
+
+   /** solving process initialization method of cut selector (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_CUTSELINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of cut selector (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_CUTSELEXITSOL(scip_exitsol);
+
+   /** cut selection method of cut selector */
+   virtual SCIP_DECL_CUTSELSELECT(scip_select);
+
+private:
+   /** maps the variables of the problem data to their families; returns false if there is no design problem data */
+   bool updateFamilies(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** returns the family of a cut */
+   int cutFamily(
+      SCIP_ROW*          cut                 /**< the cut */
+      ) const;
+
+   /** computes the leverages of the points in the continuous design of the LP values of the binaries */
+   void computeLeverages(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   SCIP_Real             duptol_;            /**< rounding of the normalized coefficients of the duplicate detection */
+   SCIP_Real             levweight_;         /**< weight of the leverage of the point of a cut in its score */
+   int                   maxfamilycuts_;     /**< maximal number of cuts of a family per round below the root */
+   int                   maxfamilycutsroot_; /**< maximal number of cuts of a family per round at the root */
+   SCIP_Real             maxparallel_;       /**< maximal parallelism of two cuts of a family in a round */
+
+   std::unordered_map<SCIP_VAR*, int> varfamily_; /**< family of each variable of the problem data */
+   int                   nmappedvars_;       /**< number of variables of the problem when varfamily_ was built */
+   int                   npoints_;           /**< number of points: families 0..npoints_-1 are points */
+   int                   dim_;               /**< dimension: families npoints_..npoints_+dim_-1 are columns of J */
+   std::vector<SCIP_Real> leverages_;        /**< leverage of each point in the current round */
+
+   std::vector<SCIP_Real> weights_;          /**< LP values of the binaries of the current round */
+   std::vector<SCIP_Real> M_;                /**< information matrix of weights_ and its Cholesky factor, dim * dim */
+
+   SCIP_Longint          ncalls_;            /**< number of rounds in the current solve */
+   SCIP_Longint          ncuts_;             /**< number of cuts offered in the current solve */
+   SCIP_Longint          nselected_;         /**< number of cuts selected in the current solve */
+   SCIP_Longint          nduplicates_;       /**< number of duplicates dropped in the current solve */
+   SCIP_Longint          nlimited_;          /**< number of cuts dropped by the limits or the parallelism in their family */
+};/*lint !e1712*/
+
+
+#endif
@@ -0,0 +1,808 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   daemon.cpp
+ * @brief  solver service that runs design jobs from a Unix domain socket on warm SCIP instances
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "objscip/objscip.h"
+
+#include "daemon.h"
+#include "plugins.h"
+#include "probdata.h"
+#include "reader_sub.h"
+
+using namespace scip;
+using namespace std;
+
+#define EVENTHDLR_NAME         "daemonjob"
+#define EVENTHDLR_DESC         "event handler that streams the incumbents of a job to its client"
+
+#define MAXLINE                65536         /**< maximal length of a line of a job */
+#define RECVTIMEOUT            10            /**< seconds to wait for the next line of a job */
+#define BACKLOG                64            /**< maximal number of pending connections */
+#define EVENTTYPE_JOB          (SCIP_EVENTTYPE_BESTSOLFOUND | SCIP_EVENTTYPE_LPSOLVED | SCIP_EVENTTYPE_NODESOLVED) /**< events of a job */
+#define POLLINTERVAL           200.0         /**< milliseconds between two checks whether the client of a job is gone */
+
+typedef chrono::steady_clock Clock;
+
+/** returns the milliseconds since the given time */
+static
+double millisecondsSince(
+   Clock::time_point     start               /**< start time */
+   )
+{
+   return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+/** writes a formatted line to a connection; returns FALSE if the client is gone */
+static
+bool writeLine(
+   int                   fd,                 /**< socket of the connection */
+   const char*           format,             /**< format string of the line, without the newline */
+   ...
+   )
+{
+   char buffer[MAXLINE];
+   va_list ap;
+   va_start(ap, format);
+   int len = vsnprintf(buffer, MAXLINE - 1, format, ap);
+   va_end(ap);
+   len = MIN(len, MAXLINE - 2);
+   buffer[len++] = '\n';
+
+   for( int pos = 0; pos < len; )
+   {
+      ssize_t n = send(fd, buffer + pos, len - pos, MSG_NOSIGNAL);
+      if( n < 0 && errno == EINTR )
+         continue;
+      if( n <= 0 )
+         return false;
+      pos += (int) n;
+   }
+   return true;
+}
+
+/** returns whether the client of a connection closed it; a client that only shut down its sending side still waits
+ *  for the answer
+ */
+static
+bool clientGone(
+   int                   fd                  /**< socket of the connection */
+   )
+{
+   struct pollfd pfd;
+   pfd.fd = fd;
+   pfd.events = 0;
+   pfd.revents = 0;
+   return poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+}
+
+/** buffered reader of the lines of a connection */
+class LineReader
+{
+public:
+   explicit LineReader(
+      int                fd                  /**< socket of the connection */
+      )
+      : fd_(fd),
+        pos_(0)
+   {
+   }
+
+   /** reads the next line without the newline; returns FALSE at the end of the input, on timeout or on error */
+   bool getLine(
+      string&            line                /**< buffer to store the line */
+      )
+   {
+      while( true )
+      {
+         size_t end = buffer_.find('\n', pos_);
+         if( end != string::npos )
+         {
+            line.assign(buffer_, pos_, end - pos_);
+            pos_ = end + 1;
+            return true;
+         }
+         if( buffer_.size() - pos_ > MAXLINE )
+            return false;
+
+         buffer_.erase(0, pos_);
+         pos_ = 0;
+         char chunk[4096];
+         ssize_t n = recv(fd_, chunk, sizeof(chunk), 0);
+         if( n < 0 && errno == EINTR )
+            continue;
+         if( n <= 0 )
+            return false;
+         buffer_.append(chunk, n);
+      }
+   }
+
+private:
+   int                   fd_;                /**< socket of the connection */
+   string                buffer_;            /**< received data */
+   size_t                pos_;               /**< start of the unread data in the buffer */
+};
+
+
+/** job of the service */
+struct DesignJob
+{
+   int                   id;                 /**< number of the job */
+   int                   fd;                 /**< socket of the client */
+   string                file;               /**< instance file, or empty for inline data */
+   int                   numvars;            /**< number of points of inline data */
+   int                   dim;                /**< dimension of inline data */
+   SCIP_Real             epsilon;            /**< epsilon of inline data as given in a file */
+   vector<vector<SCIP_Real>> A;              /**< inline data matrix: dim * numvars */
+   int                   card;               /**< cardinality, or -1 for the card of the file */
+   SCIP_Real             timelimit;          /**< time limit, or -1 for the default */
+   string                settings;           /**< settings file, or empty */
+   Clock::time_point     queued;             /**< time the job entered the queue */
+
+   DesignJob()
+      : id(-1), fd(-1), numvars(0), dim(0), epsilon(0.0), card(-1), timelimit(-1.0)
+   {
+   }
+};
+
+/** queue of the jobs waiting for a worker */
+class JobQueue
+{
+public:
+   JobQueue()
+      : closed_(false)
+   {
+   }
+
+   /** appends a job */
+   void push(
+      DesignJob*         job                 /**< job to append */
+      )
+   {
+      lock_guard<mutex> lock(mutex_);
+      jobs_.push_back(job);
+      cond_.notify_one();
+   }
+
+   /** returns the number of waiting jobs */
+   int size()
+   {
+      lock_guard<mutex> lock(mutex_);
+      return (int) jobs_.size();
+   }
+
+   /** waits for the next job; returns NULL if the queue is closed and empty */
+   DesignJob* pop()
+   {
+      unique_lock<mutex> lock(mutex_);
+      cond_.wait(lock, [this]{ return closed_ || !jobs_.empty(); });
+      if( jobs_.empty() )
+         return NULL;
+      DesignJob* job = jobs_.front();
+      jobs_.pop_front();
+      return job;
+   }
+
+   /** lets the workers finish the queued jobs and stop */
+   void close()
+   {
+      lock_guard<mutex> lock(mutex_);
+      closed_ = true;
+      cond_.notify_all();
+   }
+
+private:
+   mutex                 mutex_;             /**< protects the queue */
+   condition_variable    cond_;              /**< signals a new job or the close */
+   deque<DesignJob*>     jobs_;              /**< waiting jobs */
+   bool                  closed_;            /**< are no more jobs accepted? */
+};
+
+
+/** number of connections whose jobs are being received */
+class ReceiverCount
+{
+public:
+   ReceiverCount()
+      : count_(0)
+   {
+   }
+
+   /** registers a receiving connection */
+   void enter()
+   {
+      lock_guard<mutex> lock(mutex_);
+      ++count_;
+   }
+
+   /** unregisters a receiving connection */
+   void leave()
+   {
+      lock_guard<mutex> lock(mutex_);
+      --count_;
+      cond_.notify_all();
+   }
+
+   /** waits until no connection is being received */
+   void wait()
+   {
+      unique_lock<mutex> lock(mutex_);
+      cond_.wait(lock, [this]{ return count_ == 0; });
+   }
+
+private:
+   mutex                 mutex_;             /**< protects the count */
+   condition_variable    cond_;              /**< signals a finished connection */
+   int                   count_;             /**< number of receiving connections */
+};
+
+
+/** event handler that writes every new incumbent of the running job to its client and interrupts the solve when the
+ *  client is gone, which is checked on the LP solves and nodes at most every POLLINTERVAL milliseconds
+ */
+class EventhdlrJob : public ObjEventhdlr
+{
+public:
+   /** default constructor */
+   EventhdlrJob(
+      SCIP*              scip                /**< SCIP data structure */
+      )
+      : ObjEventhdlr(scip, EVENTHDLR_NAME, EVENTHDLR_DESC),
+        fd_(-1),
+        jobid_(-1),
+        lost_(FALSE),
+        lastpoll_(Clock::now())
+   {
+   }
+
+   /** sets the client of the next solve, or -1 to stop streaming */
+   void setJob(
+      int                fd,                 /**< socket of the client */
+      int                jobid               /**< number of the job */
+      )
+   {
+      fd_ = fd;
+      jobid_ = jobid;
+      lost_ = FALSE;
+      lastpoll_ = Clock::now();
+   }
+
+   /** returns whether the client disconnected during the solve */
+   SCIP_Bool isLost() const
+   {
+      return lost_;
+   }
+
+   /** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_EVENTINITSOL(scip_initsol)
+   {
+      SCIP_CALL( SCIPcatchEvent(scip, EVENTTYPE_JOB, eventhdlr, NULL, NULL) );
+      return SCIP_OKAY;
+   }
+
+   /** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_EVENTEXITSOL(scip_exitsol)
+   {
+      SCIP_CALL( SCIPdropEvent(scip, EVENTTYPE_JOB, eventhdlr, NULL, -1) );
+      return SCIP_OKAY;
+   }
+
+   /** execution method of event handler */
+   virtual SCIP_DECL_EVENTEXEC(scip_exec)
+   {
+      if( fd_ < 0 || lost_ )
+         return SCIP_OKAY;
+
+      if( SCIPeventGetType(event) == SCIP_EVENTTYPE_BESTSOLFOUND )
+      {
+         SCIP_SOL* sol = SCIPeventGetSol(event);
+         lost_ = !writeLine(fd_, "incumbent job=%d time=%.3f primal=%.15g", jobid_, SCIPgetSolvingTime(scip),
+            SCIPgetSolOrigObj(scip, sol));
+      }
+      else if( millisecondsSince(lastpoll_) >= POLLINTERVAL )
+      {
+         lastpoll_ = Clock::now();
+         lost_ = clientGone(fd_);
+      }
+
+      /* nobody waits for the result */
+      if( lost_ )
+      {
+         SCIP_CALL( SCIPinterruptSolve(scip) );
+      }
+      return SCIP_OKAY;
+   }
+
+private:
+   int                   fd_;                /**< socket of the client of the running job, or -1 */
+   int                   jobid_;             /**< number of the running job */
+   SCIP_Bool             lost_;              /**< did the client disconnect? */
+   Clock::time_point     lastpoll_;          /**< time of the last check of the connection */
+};
+
+
+/** returns a short name of the solution status */
+static
+const char* statusName(
+   SCIP_STATUS           status              /**< solution status */
+   )
+{
+   switch( status )
+   {
+   case SCIP_STATUS_OPTIMAL:
+      return "optimal";
+   case SCIP_STATUS_INFEASIBLE:
+      return "infeasible";
+   case SCIP_STATUS_UNBOUNDED:
+   case SCIP_STATUS_INFORUNBD:
+      return "unbounded";
+   case SCIP_STATUS_TIMELIMIT:
+      return "timelimit";
+   case SCIP_STATUS_GAPLIMIT:
+      return "gaplimit";
+   case SCIP_STATUS_USERINTERRUPT:
+      return "interrupted";
+   default:
+      return "limit";
+   }
+}
+
+/** reads a job from a connection; returns FALSE with a message if the job is malformed */
+static
+bool readJob(
+   LineReader&           reader,             /**< reader of the connection */
+   const string&         first,              /**< first line of the job, already read */
+   DesignJob&            job,                /**< job to fill */
+   string&               message             /**< buffer for the error message */
+   )
+{
+   string line = first;
+   do
+   {
+      istringstream in(line);
+      string key;
+      in >> key;
+
+      if( key == "end" )
+      {
+         if( job.file.empty() && job.A.empty() )
+         {
+            message = "job without file or matrix";
+            return false;
+         }
+         if( !job.A.empty() && job.card <= 0 )
+         {
+            message = "matrix job without positive card";
+            return false;
+         }
+         if( !job.file.empty() && !SCIPfileExists(job.file.c_str()) )
+         {
+            message = "file " + job.file + " not found";
+            return false;
+         }
+         if( !job.settings.empty() && !SCIPfileExists(job.settings.c_str()) )
+         {
+            message = "settings file " + job.settings + " not found";
+            return false;
+         }
+         return true;
+      }
+      else if( key == "file" )
+      {
+         in >> ws;
+         getline(in, job.file);
+      }
+      else if( key == "settings" )
+      {
+         in >> ws;
+         getline(in, job.settings);
+      }
+      else if( key == "card" )
+         in >> job.card;
+      else if( key == "time" )
+         in >> job.timelimit;
+      else if( key == "matrix" )
+      {
+         if( !(in >> job.numvars >> job.dim >> job.epsilon) || job.numvars <= 0 || job.dim <= 0 )
+         {
+            message = "malformed matrix header";
+            return false;
+         }
+         job.A.assign(job.dim, vector<SCIP_Real>(job.numvars, 0.0));
+         for( int i = 0; i < job.numvars; ++i )
+         {
+            if( !reader.getLine(line) )
+            {
+               message = "matrix ends after " + to_string(i) + " points";
+               return false;
+            }
+            istringstream row(line);
+            for( int j = 0; j < job.dim; ++j )
+               row >> job.A[j][i];
+            if( !row )
+            {
+               message = "malformed point " + to_string(i);
+               return false;
+            }
+         }
+         continue;
+      }
+      else if( !key.empty() )
+      {
+         message = "unknown key " + key;
+         return false;
+      }
+
+      if( in.fail() )
+      {
+         message = "malformed line: " + line;
+         return false;
+      }
+   }
+   while( reader.getLine(line) );
+
+   message = "job ends without end";
+   return false;
+}
+
+/** restores the state of a fresh instance: no problem, and the parameters of the solver and the default settings */
+static
+SCIP_RETCODE resetInstance(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           defaultsetname      /**< name of default settings file, read if it exists */
+   )
+{
+   SCIP_CALL( SCIPfreeProb(scip) );
+   SCIP_CALL( SCIPresetParams(scip) );
+   SCIP_CALL( SCIPsetDesignParams(scip) );
+   if( defaultsetname != NULL && SCIPfileExists(defaultsetname) )
+   {
+      SCIP_CALL( SCIPreadParams(scip, defaultsetname) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/** builds and solves a job on an instance in the reset state and writes its result */
+static
+SCIP_RETCODE solveJob(
+   SCIP*                 scip,               /**< SCIP data structure */
+   EventhdlrJob*         eventhdlr,          /**< event handler that streams the incumbents */
+   const char*           defaultsetname,     /**< name of default settings file */
+   DesignJob&            job                 /**< job to solve */
+   )
+{
+   Clock::time_point start = Clock::now();
+   double waitms = chrono::duration<double, milli>(start - job.queued).count();
+
+   /* a client that left while its job was queued gets no solve */
+   if( clientGone(job.fd) )
+   {
+      printf("daemon: job %d skipped, client lost while queued\n", job.id);
+      fflush(stdout);
+      return SCIP_OKAY;
+   }
+
+   if( !job.settings.empty() )
+   {
+      SCIP_CALL( SCIPreadParams(scip, job.settings.c_str()) );
+   }
+   if( job.card >= 0 )
+   {
+      SCIP_CALL( SCIPsetIntParam(scip, "reading/design/card", job.card) );
+   }
+   if( job.timelimit >= 0.0 )
+   {
+      SCIP_CALL( SCIPsetRealParam(scip, "limits/time", job.timelimit) );
+   }
+
+   if( job.file.empty() )
+   {
+      ReaderSubmodular* reader = dynamic_cast<ReaderSubmodular*>(SCIPfindObjReader(scip, "reader"));
+      assert(reader != NULL);
+      SCIP_CALL( reader->createProb(scip, ("job" + to_string(job.id)).c_str(), job.numvars, job.dim, job.card,
+            job.epsilon, job.A, 0.0) );
+   }
+   else
+   {
+      SCIP_CALL( SCIPreadProb(scip, job.file.c_str(), "design") );
+   }
+   double buildms = millisecondsSince(start);
+
+   eventhdlr->setJob(job.fd, job.id);
+   SCIP_CALL( SCIPsolve(scip) );
+   eventhdlr->setJob(-1, -1);
+
+   /* the result is taken before the reset, but written after it, so that the overhead includes the reset */
+   SCIP_STATUS status = SCIPgetStatus(scip);
+   SCIP_Real primal = SCIPgetPrimalbound(scip);
+   SCIP_Real dual = SCIPgetDualbound(scip);
+   SCIP_Real gap = SCIPgetGap(scip);
+   SCIP_Longint nnodes = SCIPgetNNodes(scip);
+   SCIP_Real solvetime = SCIPgetSolvingTime(scip);
+   SCIP_Bool lost = eventhdlr->isLost();
+
+   string design;
+   SCIP_SOL* sol = SCIPgetBestSol(scip);
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( sol != NULL && probdata != NULL )
+   {
+      for( int i = 0; i < probdata->numvars; ++i )
+      {
+         if( probdata->hasPoint(i) && SCIPgetSolVal(scip, sol, probdata->bin_vars[i]) > 0.5 )
+         {
+            if( !design.empty() )
+               design += ',';
+            design += to_string(i);
+         }
+      }
+   }
+
+   SCIP_CALL( resetInstance(scip, defaultsetname) );
+
+   double overheadms = millisecondsSince(start) - 1000.0 * solvetime;
+   if( !lost )
+   {
+      (void) writeLine(job.fd, "result job=%d status=%s primal=%.15g dual=%.15g gap=%g nodes=%lld solve=%.3f "
+         "wait_ms=%.3f build_ms=%.3f overhead_ms=%.3f design=%s", job.id, statusName(status), primal, dual, gap,
+         (long long) nnodes, solvetime, waitms, buildms, MAX(overheadms, 0.0), design.c_str());
+   }
+   printf("daemon: job %d %s in %.3f s, overhead %.3f ms%s\n", job.id, statusName(status), solvetime,
+      MAX(overheadms, 0.0), lost ? ", client lost" : "");
+   fflush(stdout);
+
+   return SCIP_OKAY;
+}
+
+/** creates the instance of a worker with all plugins, quiet, in the reset state */
+static
+SCIP_RETCODE createInstance(
+   SCIP**                scip,               /**< pointer to store the SCIP data structure */
+   EventhdlrJob**        eventhdlr,          /**< pointer to store the event handler of the instance */
+   const char*           defaultsetname      /**< name of default settings file, read if it exists */
+   )
+{
+   SCIP_CALL( SCIPcreate(scip) );
+   SCIP_CALL( SCIPincludeDesignPlugins(*scip) );
+   *eventhdlr = new EventhdlrJob(*scip);
+   SCIP_CALL( SCIPincludeObjEventhdlr(*scip, *eventhdlr, TRUE) );
+   SCIPsetMessagehdlrQuiet(*scip, TRUE);
+
+   if( defaultsetname != NULL && SCIPfileExists(defaultsetname) )
+   {
+      SCIP_CALL( SCIPreadParams(*scip, defaultsetname) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/** frees the instance of a worker after an error, which may have left it in any stage */
+static
+void discardInstance(
+   SCIP**                scip,               /**< pointer to the SCIP data structure, set to NULL */
+   int                   worker              /**< index of the worker */
+   )
+{
+   if( *scip != NULL && SCIPfree(scip) != SCIP_OKAY )
+   {
+      printf("daemon: worker %d could not free its instance\n", worker);
+      fflush(stdout);
+   }
+   *scip = NULL;
+}
+
+/** main loop of a worker: solves jobs of the queue on its instance until the queue is closed
+ *
+ *  After an error, the instance is discarded and created anew for the next job; if this fails, the job gets the error
+ *  and the worker tries again with the next one, so the queue is served as long as any worker runs.
+ */
+static
+SCIP_RETCODE work(
+   JobQueue&             queue,              /**< queue of the jobs */
+   const char*           defaultsetname,     /**< name of default settings file */
+   int                   worker              /**< index of the worker */
+   )
+{
+   SCIP* scip = NULL;
+   EventhdlrJob* eventhdlr = NULL;
+   SCIP_RETCODE retcode = createInstance(&scip, &eventhdlr, defaultsetname);
+   if( retcode != SCIP_OKAY )
+   {
+      printf("daemon: worker %d could not create its instance, SCIP error %d\n", worker, (int) retcode);
+      fflush(stdout);
+      discardInstance(&scip, worker);
+   }
+
+   DesignJob* job;
+   while( (job = queue.pop()) != NULL )
+   {
+      retcode = SCIP_OKAY;
+      if( scip == NULL )
+         retcode = createInstance(&scip, &eventhdlr, defaultsetname);
+      if( retcode == SCIP_OKAY )
+         retcode = solveJob(scip, eventhdlr, defaultsetname, *job);
+      if( retcode != SCIP_OKAY )
+      {
+         (void) writeLine(job->fd, "error job=%d SCIP error %d", job->id, (int) retcode);
+         printf("daemon: job %d failed with SCIP error %d on worker %d\n", job->id, (int) retcode, worker);
+         fflush(stdout);
+         discardInstance(&scip, worker);
+      }
+      close(job->fd);
+      delete job;
+   }
+
+   discardInstance(&scip, worker);
+
+   return SCIP_OKAY;
+}
+
+/** receives the job of a connection and queues it; a "shutdown" stops the accept loop of the service */
+static
+void receiveJob(
+   int                   fd,                 /**< socket of the connection */
+   int                   listenfd,           /**< listening socket of the service */
+   JobQueue&             queue,              /**< queue of the jobs */
+   atomic<int>&          njobs,              /**< number of jobs so far, for the job ids */
+   atomic<bool>&         stopping            /**< flag to set on shutdown */
+   )
+{
+   LineReader reader(fd);
+   string line;
+   if( !reader.getLine(line) )
+   {
+      close(fd);
+      return;
+   }
+   if( line == "shutdown" )
+   {
+      /* wakes the accept loop, which returns with an error on the shut down socket */
+      stopping = true;
+      (void) shutdown(listenfd, SHUT_RDWR);
+      close(fd);
+      return;
+   }
+
+   DesignJob* job = new DesignJob();
+   job->id = njobs++;
+   job->fd = fd;
+   string message;
+   if( !readJob(reader, line, *job, message) )
+   {
+      (void) writeLine(fd, "error job=%d %s", job->id, message.c_str());
+      close(fd);
+      delete job;
+      return;
+   }
+
+   /* the answer is written before the job is queued, since the worker writes to the connection from then on */
+   (void) writeLine(fd, "queued job=%d position=%d", job->id, queue.size());
+   job->queued = Clock::now();
+   queue.push(job);
+}
+
+/** runs the solver service on a Unix domain socket until a client sends "shutdown" */
+SCIP_RETCODE runDaemon(
+   const char*           socketpath,         /**< path of the socket */
+   int                   nworkers,           /**< number of workers, each with its own SCIP instance */
+   const char*           defaultsetname      /**< name of default settings file, read if it exists */
+   )
+{
+   assert(socketpath != NULL);
+
+   struct sockaddr_un addr;
+   memset(&addr, 0, sizeof(addr));
+   addr.sun_family = AF_UNIX;
+   if( strlen(socketpath) >= sizeof(addr.sun_path) )
+   {
+      SCIPerrorMessage("socket path <%s> is too long\n", socketpath);
+      return SCIP_PARAMETERWRONGVAL;
+   }
+   strcpy(addr.sun_path, socketpath);
+
+   int listenfd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if( listenfd < 0 )
+   {
+      SCIPerrorMessage("cannot create socket: %s\n", strerror(errno));
+      return SCIP_FILECREATEERROR;
+   }
+   (void) unlink(socketpath);
+   if( bind(listenfd, (struct sockaddr*) &addr, sizeof(addr)) < 0 || listen(listenfd, BACKLOG) < 0 )
+   {
+      SCIPerrorMessage("cannot listen on <%s>: %s\n", socketpath, strerror(errno));
+      close(listenfd);
+      return SCIP_FILECREATEERROR;
+   }
+
+   /* the instances are created by the workers, so that the first job does not wait for them */
+   JobQueue queue;
+   vector<thread> workers;
+   vector<SCIP_RETCODE> retcodes(nworkers, SCIP_OKAY);
+   for( int w = 0; w < nworkers; ++w )
+      workers.emplace_back([&queue, &retcodes, defaultsetname, w]{ retcodes[w] = work(queue, defaultsetname, w); });
+
+   printf("daemon: listening on %s with %d workers\n", socketpath, nworkers);
+   fflush(stdout);
+
+   /* the jobs are received on their own threads, so a slow client does not block the other submissions */
+   atomic<int> njobs(0);
+   atomic<bool> stopping(false);
+   ReceiverCount receivers;
+   while( !stopping )
+   {
+      int fd = accept(listenfd, NULL, NULL);
+      if( fd < 0 )
+      {
+         if( stopping )
+            break;
+         if( errno == EINTR || errno == ECONNABORTED )
+            continue;
+         SCIPerrorMessage("accept failed: %s\n", strerror(errno));
+         break;
+      }
+
+      /* a client that stalls while sending its job only holds its own thread */
+      struct timeval timeout = { RECVTIMEOUT, 0 };
+      (void) setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+      receivers.enter();
+      thread([fd, listenfd, &queue, &njobs, &stopping, &receivers]{
+            receiveJob(fd, listenfd, queue, njobs, stopping);
+            receivers.leave();
+         }).detach();
+   }
+
+   /* the jobs received completely before the shutdown are still solved */
+   receivers.wait();
+   queue.close();
+   for( thread& worker : workers )
+      worker.join();
+   close(listenfd);
+   (void) unlink(socketpath);
+
+   printf("daemon: stopped after %d jobs\n", (int) njobs);
+
+   for( SCIP_RETCODE retcode : retcodes )
+   {
+      SCIP_CALL( retcode );
+   }
+
+   return SCIP_OKAY;
+}
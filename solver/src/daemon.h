@@ -0,0 +1,63 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   daemon.h
+ * @brief  solver service that runs design jobs from a Unix domain socket on warm SCIP instances
+ * @author Liding Xu
+ *
+ * The service creates one SCIP instance with all plugins per worker once and reuses it for every job: after a job,
+ * the problem is freed and the parameters are reset to the defaults of the solver and of the default settings file.
+ * A client connects, sends one job as text lines and receives the progress of the job on the same connection:
+ *
+ *   file <path>                         instance file, or
+ *   matrix <numvars> <dim> <epsilon>    inline data, followed by numvars lines with the dim entries of a point
+ *   card <k>                            cardinality, overrides the card of a file (optional), required with matrix
+ *   time <seconds>                      time limit (optional)
+ *   settings <path>                     settings file read before the model is built (optional)
+ *   end
+ *
+ * or the single line "shutdown", which stops the service after the queued jobs. The service answers with
+ *
+ *   queued job=<id> position=<jobs ahead>
+ *   incumbent job=<id> time=<s> primal=<value>               for every new incumbent
+ *   result job=<id> status=<status> primal=<value> dual=<value> gap=<gap> nodes=<n> solve=<s>
+ *          wait_ms=<ms> build_ms=<ms> overhead_ms=<ms> design=<i1>,<i2>,...
+ *   error job=<id> <message>
+ *
+ * where wait_ms is the time in the queue, build_ms the time to apply the settings and build the model, and overhead_ms
+ * the time the worker spent on the job outside of SCIP's solving time, including the reset of the instance. Each
+ * connection is received on its own thread, so a slow client does not delay the others. If the client closes the
+ * connection, its queued job is skipped, and its running job is interrupted at the next LP solve or node; a client that
+ * only shuts down its sending side still gets the answer. A worker whose instance fails is given a new one, and a job
+ * for which this fails gets an error line.
+ *
+ * The workers solve concurrently, so SCIP must be built thread-safe (the default of its CMake build).
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_DAEMON_H__
+#define __SCIP_DAEMON_H__
+
+#include "scip/scip.h"
+
+/** runs the solver service on a Unix domain socket until a client sends "shutdown" */
+SCIP_RETCODE runDaemon(
+   const char*           socketpath,         /**< path of the socket */
+   int                   nworkers,           /**< number of workers, each with its own SCIP instance */
+   const char*           defaultsetname      /**< name of default settings file, read if it exists */
+   );
+
+#endif
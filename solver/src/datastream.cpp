@@ -0,0 +1,347 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   datastream.cpp
+ * @brief  chunked reading of plain and compressed instance files
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+
+#ifdef DOPT_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef DOPT_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include "datastream.h"
+
+using namespace std;
+
+/** returns whether a name ends with a suffix */
+static
+bool hasSuffix(
+   const char*           name,               /**< name */
+   const char*           suffix              /**< suffix */
+   )
+{
+   size_t len = strlen(name);
+   size_t slen = strlen(suffix);
+   return len >= slen && strcmp(name + len - slen, suffix) == 0;
+}
+
+DataStream::DataStream(
+   const char*           filename            /**< name of the file */
+   ) : format_(PLAIN), file_(NULL), zstd_(NULL), inpos_(0), inlen_(0), eof_(false)
+{
+   if( hasSuffix(filename, ".gz") )
+      format_ = GZIP;
+   else if( hasSuffix(filename, ".zst") )
+      format_ = ZSTD;
+
+   switch( format_ )
+   {
+   case GZIP:
+#ifdef DOPT_WITH_ZLIB
+   {
+      gzFile gz = gzopen(filename, "rb");
+      if( gz == NULL )
+      {
+         error_ = string("cannot open ") + filename;
+         return;
+      }
+      // a large internal buffer saves most of the calls into the inflater for big files
+      (void) gzbuffer(gz, 1 << 18);
+      file_ = (void*) gz;
+      return;
+   }
+#else
+      error_ = string("cannot read ") + filename + ": the solver is built without zlib";
+      return;
+#endif
+
+   case ZSTD:
+#ifdef DOPT_WITH_ZSTD
+   {
+      ZSTD_DStream* zstd = ZSTD_createDStream();
+      if( zstd == NULL )
+      {
+         error_ = "cannot create the zstd decompression stream";
+         return;
+      }
+      (void) ZSTD_initDStream(zstd);
+      zstd_ = (void*) zstd;
+      inbuf_.resize(ZSTD_DStreamInSize());
+      break;
+   }
+#else
+      error_ = string("cannot read ") + filename + ": the solver is built without zstd";
+      return;
+#endif
+
+   case PLAIN:
+   default:
+      break;
+   }
+
+   FILE* file = fopen(filename, "rb");
+   if( file == NULL )
+   {
+      error_ = string("cannot open ") + filename + ": " + strerror(errno);
+      return;
+   }
+   file_ = (void*) file;
+}
+
+DataStream::~DataStream()
+{
+   if( file_ != NULL )
+   {
+#ifdef DOPT_WITH_ZLIB
+      if( format_ == GZIP )
+         (void) gzclose((gzFile) file_);
+      else
+#endif
+         (void) fclose((FILE*) file_);
+   }
+#ifdef DOPT_WITH_ZSTD
+   if( zstd_ != NULL )
+      (void) ZSTD_freeDStream((ZSTD_DStream*) zstd_);
+#endif
+}
+
+size_t DataStream::read(
+   char*                 buf,                /**< buffer to store the bytes */
+   size_t                size                /**< size of the buffer */
+   )
+{
+   if( file_ == NULL || eof_ || !error_.empty() || size == 0 )
+      return 0;
+
+   switch( format_ )
+   {
+   case GZIP:
+#ifdef DOPT_WITH_ZLIB
+   {
+      // gzread reads at most UINT_MAX bytes at once
+      int nread = gzread((gzFile) file_, buf, (unsigned) (size < (size_t) INT_MAX ? size : (size_t) INT_MAX));
+      if( nread < 0 )
+      {
+         int errnum;
+         error_ = string("gzip: ") + gzerror((gzFile) file_, &errnum);
+         return 0;
+      }
+      if( nread == 0 )
+         eof_ = true;
+      return (size_t) nread;
+   }
+#else
+      return 0;
+#endif
+
+   case ZSTD:
+#ifdef DOPT_WITH_ZSTD
+   {
+      ZSTD_outBuffer out = { buf, size, 0 };
+      // decompresses until the output is full or the input is exhausted; a frame may span several input blocks
+      while( out.pos == 0 )
+      {
+         if( inpos_ == inlen_ )
+         {
+            inlen_ = fread(inbuf_.data(), 1, inbuf_.size(), (FILE*) file_);
+            inpos_ = 0;
+            if( inlen_ == 0 )
+            {
+               if( ferror((FILE*) file_) )
+                  error_ = "zstd: read error";
+               eof_ = true;
+               return 0;
+            }
+         }
+         ZSTD_inBuffer in = { inbuf_.data(), inlen_, inpos_ };
+         size_t ret = ZSTD_decompressStream((ZSTD_DStream*) zstd_, &out, &in);
+         inpos_ = in.pos;
+         if( ZSTD_isError(ret) )
+         {
+            error_ = string("zstd: ") + ZSTD_getErrorName(ret);
+            return 0;
+         }
+      }
+      return out.pos;
+   }
+#else
+      return 0;
+#endif
+
+   case PLAIN:
+   default:
+   {
+      size_t nread = fread(buf, 1, size, (FILE*) file_);
+      if( nread == 0 )
+      {
+         if( ferror((FILE*) file_) )
+            error_ = "read error";
+         eof_ = true;
+      }
+      return nread;
+   }
+   }
+}
+
+NumberScanner::NumberScanner(
+   DataStream&           stream,             /**< stream to scan */
+   size_t                chunksize           /**< number of bytes decompressed at once */
+   ) : stream_(stream), pos_(0), len_(0), eof_(false)
+{
+   buf_.resize(chunksize + 1);
+   buf_[0] = '\0';
+}
+
+/** returns whether a character separates tokens */
+static inline
+bool isSpace(
+   char                  c                   /**< character */
+   )
+{
+   return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool NumberScanner::nextToken(
+   char*&                begin,              /**< pointer to store the start of the token */
+   char*&                end                 /**< pointer to store the end of the token */
+   )
+{
+   for( ;; )
+   {
+      while( pos_ < len_ && isSpace(buf_[pos_]) )
+         ++pos_;
+
+      // a token is complete if it is followed by a separator, or if the stream has ended
+      size_t tokend = pos_;
+      while( tokend < len_ && !isSpace(buf_[tokend]) )
+         ++tokend;
+      if( pos_ < len_ && (tokend < len_ || eof_) )
+      {
+         begin = &buf_[pos_];
+         end = &buf_[tokend];
+         return true;
+      }
+      if( eof_ )
+         return false;
+
+      // moves the partial token to the front and appends the next chunk behind it
+      size_t carry = len_ - pos_;
+      if( carry > 0 )
+         memmove(&buf_[0], &buf_[pos_], carry);
+      pos_ = 0;
+      len_ = carry;
+      if( len_ + 1 >= buf_.size() )
+      {
+         // a single token longer than a chunk: no number is that long, but the scanner must not stall
+         buf_.resize(2 * buf_.size());
+      }
+      size_t nread = stream_.read(&buf_[len_], buf_.size() - 1 - len_);
+      if( nread == 0 )
+         eof_ = true;
+      len_ += nread;
+      buf_[len_] = '\0';
+   }
+}
+
+bool NumberScanner::nextInt(
+   int&                  value               /**< pointer to store the value */
+   )
+{
+   char* begin;
+   char* end;
+   if( !nextToken(begin, end) )
+      return false;
+
+   // strtol stops at the separator or at the terminating zero behind the token
+   char* stop;
+   errno = 0;
+   long val = strtol(begin, &stop, 10);
+   pos_ += (size_t) (end - begin);
+   if( stop != end || errno != 0 || val < INT_MIN || val > INT_MAX )
+      return false;
+   value = (int) val;
+   return true;
+}
+
+bool NumberScanner::nextReal(
+   double&               value               /**< pointer to store the value */
+   )
+{
+   char* begin;
+   char* end;
+   if( !nextToken(begin, end) )
+      return false;
+
+   char* stop;
+   value = strtod(begin, &stop);
+   pos_ += (size_t) (end - begin);
+   return stop == end;
+}
+
+bool parseDesignFile(
+   const char*           filename,           /**< name of the input file */
+   int&                  numvars,            /**< pointer to store the number of items */
+   int&                  dim,                /**< pointer to store the problem dimension */
+   int&                  card,               /**< pointer to store the cardinality */
+   double&               epsilon,            /**< pointer to store epsilon as given in the file */
+   vector<vector<double>>& A,                /**< matrix to store the data, dim * numvars */
+   string&               error               /**< string to store the message of an error */
+   )
+{
+   DataStream stream(filename);
+   if( !stream.ok() )
+   {
+      error = stream.error();
+      return false;
+   }
+   NumberScanner scanner(stream);
+
+   if( !scanner.nextInt(numvars) || !scanner.nextInt(dim) || !scanner.nextInt(card) || !scanner.nextReal(epsilon)
+      || numvars <= 0 || dim <= 0 )
+   {
+      error = string(filename) + ": invalid header";
+      return false;
+   }
+
+   A.assign(dim, vector<double>(numvars, 0));
+   for( int i = 0; i < numvars; i++ )
+   {
+      for( int j = 0; j < dim; j++ )
+      {
+         if( !scanner.nextReal(A[j][i]) )
+         {
+            if( !stream.ok() )
+               error = stream.error();
+            else
+               error = string(filename) + ": invalid or missing entry " + to_string(j + 1) + " of point " + to_string(i + 1);
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
@@ -0,0 +1,142 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   datastream.h
+ * @brief  chunked reading of plain and compressed instance files
+ * @author Liding Xu
+ *
+ * The format of a file is given by its extension: ".gz" is decompressed by zlib and ".zst" by zstd, if the solver is
+ * built with them (DOPT_WITH_ZLIB, DOPT_WITH_ZSTD); any other file is read as it is. The data are decompressed chunk by
+ * chunk into the buffer of a NumberScanner, which parses the numbers of the chunk, so no decompressed copy of the
+ * file is written or kept in memory.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __DOPT_DATASTREAM_H__
+#define __DOPT_DATASTREAM_H__
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/** sequential reader of the decompressed bytes of a file */
+class DataStream
+{
+public:
+   /** formats of files */
+   enum Format
+   {
+      PLAIN = 0,                             /**< uncompressed */
+      GZIP  = 1,                             /**< gzip, by zlib */
+      ZSTD  = 2                              /**< zstandard, by zstd */
+   };
+
+   /** opens a file in the format of its extension; see ok() and error() for the result */
+   explicit DataStream(
+      const char*        filename            /**< name of the file */
+      );
+
+   /** closes the file */
+   ~DataStream();
+
+   /** returns whether the file is open and no read failed */
+   bool ok() const
+   {
+      return error_.empty();
+   }
+
+   /** returns the message of the first error, or an empty string */
+   const std::string& error() const
+   {
+      return error_;
+   }
+
+   /** returns the format of the file */
+   Format format() const
+   {
+      return format_;
+   }
+
+   /** reads up to size decompressed bytes; returns the number of bytes read, which is 0 at the end of the file or
+    *  after an error
+    */
+   size_t read(
+      char*              buf,                /**< buffer to store the bytes */
+      size_t             size                /**< size of the buffer */
+      );
+
+private:
+   DataStream(const DataStream&);
+   DataStream& operator=(const DataStream&);
+
+   Format                format_;            /**< format of the file */
+   void*                 file_;              /**< FILE* of plain and zstd files, gzFile of gzip files */
+   void*                 zstd_;              /**< decompression stream of zstd files */
+   std::vector<char>     inbuf_;             /**< compressed input of zstd files */
+   size_t                inpos_;             /**< position of the next compressed byte in inbuf_ */
+   size_t                inlen_;             /**< number of compressed bytes in inbuf_ */
+   bool                  eof_;               /**< was the end of the file reached? */
+   std::string           error_;             /**< message of the first error */
+};
+
+/** parser of whitespace-separated numbers from a DataStream, chunk by chunk */
+class NumberScanner
+{
+public:
+   /** creates a scanner of a stream */
+   explicit NumberScanner(
+      DataStream&        stream,             /**< stream to scan */
+      size_t             chunksize = 1 << 20 /**< number of bytes decompressed at once */
+      );
+
+   /** parses the next number as integer; returns false at the end of the stream or if it is not an integer */
+   bool nextInt(
+      int&               value               /**< pointer to store the value */
+      );
+
+   /** parses the next number as real; returns false at the end of the stream or if it is not a number */
+   bool nextReal(
+      double&            value               /**< pointer to store the value */
+      );
+
+private:
+   /** makes the next token complete in the buffer; returns false at the end of the stream */
+   bool nextToken(
+      char*&             begin,              /**< pointer to store the start of the token */
+      char*&             end                 /**< pointer to store the end of the token */
+      );
+
+   DataStream&           stream_;            /**< stream to scan */
+   std::vector<char>     buf_;               /**< chunk with a terminating zero */
+   size_t                pos_;               /**< position of the next unparsed byte */
+   size_t                len_;               /**< number of bytes in the buffer */
+   bool                  eof_;               /**< was the end of the stream reached? */
+};
+
+/** parses the header "numvars dim card epsilon" and the numvars rows of the data matrix of a design file, which may be
+ *  compressed; returns false and sets error if the file cannot be read or is invalid
+ */
+bool parseDesignFile(
+   const char*           filename,           /**< name of the input file */
+   int&                  numvars,            /**< pointer to store the number of items */
+   int&                  dim,                /**< pointer to store the problem dimension */
+   int&                  card,               /**< pointer to store the cardinality */
+   double&               epsilon,            /**< pointer to store epsilon as given in the file */
+   std::vector<std::vector<double>>& A,      /**< matrix to store the data, dim * numvars */
+   std::string&          error               /**< string to store the message of an error */
+   );
+
+#endif
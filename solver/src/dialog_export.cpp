@@ -0,0 +1,74 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   dialog_export.cpp
+ * @brief  dialog "export <file>" that writes the MISOCP of the design problem in CBF or MPS
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <string>
+
+#include "dialog_export.h"
+#include "modelwriter.h"
+#include "probdata.h"
+
+using namespace scip;
+using namespace std;
+
+
+/** execution method of dialog */
+SCIP_DECL_DIALOGEXEC(DialogExport::scip_exec)
+{
+   char* filename;
+   SCIP_Bool endoffile;
+
+   SCIP_CALL( SCIPdialoghdlrGetWord(dialoghdlr, dialog, "enter filename: ", &filename, &endoffile) );
+   *nextdialog = SCIPdialoghdlrGetRoot(dialoghdlr);
+   if( endoffile )
+   {
+      *nextdialog = NULL;
+      return SCIP_OKAY;
+   }
+   if( filename[0] == '\0' )
+      return SCIP_OKAY;
+   SCIP_CALL( SCIPdialoghdlrAddHistory(dialoghdlr, dialog, filename, TRUE) );
+
+   ProbData* probdata = SCIPgetStage(scip) >= SCIP_STAGE_PROBLEM ? dynamic_cast<ProbData*>(SCIPgetObjProbData(scip))
+      : NULL;
+   if( probdata == NULL )
+   {
+      SCIPdialogMessage(scip, NULL, "no design problem exists\n");
+      return SCIP_OKAY;
+   }
+
+   SCIP_CLOCK* clock;
+   SCIP_CALL( SCIPcreateClock(scip, &clock) );
+   SCIP_CALL( SCIPstartClock(scip, clock) );
+
+   string error;
+   bool success = writeDesignModel(filename, probdata->numvars, probdata->dim, probdata->A,
+      probdata->has_cardcons ? (int) probdata->card : -1, probdata->epsilon, probdata->logdet_form, error);
+   SCIP_CALL( SCIPstopClock(scip, clock) );
+
+   if( success )
+      SCIPdialogMessage(scip, NULL, "written <%s> in %.3f s\n", filename, SCIPgetClockTime(scip, clock));
+   else
+      SCIPdialogMessage(scip, NULL, "error writing <%s>: %s\n", filename, error.c_str());
+   SCIP_CALL( SCIPfreeClock(scip, &clock) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,56 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   dialog_export.h
+ * @brief  dialog "export <file>" that writes the MISOCP of the design problem in CBF or MPS
+ * @author Liding Xu
+ *
+ * The model is written by the native writers of modelwriter.h from the data of the problem (A, card and epsilon, all
+ * points including those left to the pricer), in the objective form of "reading/design/logdetform"; the format is
+ * given by the extension, ".cbf" or ".mps". Unlike "write problem", it does not go through the SCIP variables and
+ * expressions, so it is fast for large instances.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_DIALOG_EXPORT_H__
+#define __SCIP_DIALOG_EXPORT_H__
+
+#include "objscip/objscip.h"
+
+
+/** dialog "export <file>" that writes the design problem in CBF or MPS */
+class DialogExport : public scip::ObjDialog
+{
+public:
+   /** default constructor */
+   DialogExport(
+      SCIP*              scip                /**< SCIP data structure */
+      )
+      : ObjDialog(scip, "export", "write the design problem in CBF (.cbf) or MPS (.mps) by the native writers", FALSE)
+   {
+   }
+
+   /** destructor */
+   virtual ~DialogExport()
+   {
+   }
+
+   /** execution method of dialog */
+   virtual SCIP_DECL_DIALOGEXEC(scip_exec);
+};/*lint !e1712*/
+
+
+#endif
@@ -0,0 +1,565 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   enumerate.cpp
+ * @brief  exhaustive enumeration of the designs of small instances
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+#include "enumerate.h"
+#include "linalg.h"
+
+using namespace std;
+
+#define SPLIT_TASKS_PER_THREAD 16            /**< the search is split into at least this many subtrees per thread */
+#define CLOCK_INTERVAL         4095          /**< the time limit is checked every CLOCK_INTERVAL + 1 nodes */
+
+
+/** returns the binomial coefficient C(n, k) as a floating point number, 0 if k < 0 or k > n */
+double binomialCount(
+   int                   n,                  /**< size of the set */
+   int                   k                   /**< size of the subsets */
+   )
+{
+   if( k < 0 || k > n )
+      return 0.0;
+   k = min(k, n - k);
+
+   double count = 1.0;
+   for( int i = 1; i <= k; i++ )
+      count = count * (n - k + i) / i;
+   return floor(count + 0.5);
+}
+
+
+namespace
+{
+
+/** subtree of the search: the points chosen above it and the recursion C(m, r) or C(m, r)^R below it */
+struct SearchTask
+{
+   vector<int>           prefix;             /**< positions of the points chosen above the subtree */
+   int                   m;                  /**< number of undecided candidates, the positions 0, ..., m - 1 */
+   int                   r;                  /**< number of points left to choose */
+   bool                  reversed;           /**< is the subtree enumerated in reverse order? */
+};
+
+/** best design and statistics of a subtree */
+struct TaskResult
+{
+   bool                  found;              /**< was a design above the lower bound found? */
+   double                logdet;             /**< log-determinant of the best design */
+   vector<int>           design;             /**< positions of the points of the best design */
+   long long             nnodes;             /**< number of nodes */
+   long long             nleaves;            /**< number of designs evaluated */
+   long long             npruned;            /**< number of pruned nodes */
+};
+
+/** node of the search: the information matrix of the chosen points and the leverages of the undecided ones */
+struct SearchNode
+{
+   vector<double>        Minv;               /**< inverse of the information matrix, dim * dim */
+   vector<double>        lev;                /**< leverages of the candidates, by position */
+   double                logdet;             /**< log-determinant of the information matrix */
+};
+
+/** data shared by the subtrees of an enumeration */
+class DesignSearch
+{
+public:
+   int                   dim;                /**< the dimension */
+   int                   n;                  /**< number of candidates */
+   vector<int>           start;              /**< start of the nonzeros of each position in index and value */
+   vector<int>           index;              /**< coordinates of the nonzeros of the candidates */
+   vector<double>        value;              /**< values of the nonzeros of the candidates */
+   SearchNode            root;               /**< node of the fixed points */
+   atomic<double>        best;               /**< log-determinant of the best design found in any subtree */
+   atomic<bool>          stopped;            /**< did the time limit stop the search? */
+   bool                  haslimit;           /**< is there a time limit? */
+   chrono::steady_clock::time_point deadline; /**< end of the time limit */
+
+   /** returns a^T x for the candidate at a position and a dense vector x */
+   double dot(
+      int                pos,                /**< position of the candidate */
+      const double*      x                   /**< dense vector of length dim */
+      ) const
+   {
+      double sum = 0.0;
+      for( int q = start[pos]; q < start[pos + 1]; q++ )
+         sum += value[q] * x[index[q]];
+      return sum;
+   }
+
+   /** adds the candidate at a position to a node: child = parent + a a^T, with the leverages of the positions below
+    *  m and the inverse only if needed
+    */
+   void addPoint(
+      const SearchNode&  parent,             /**< the node */
+      int                pos,                /**< position of the candidate */
+      int                m,                  /**< number of leverages to update */
+      bool               inverse,            /**< should the inverse be updated? */
+      vector<double>&    u,                  /**< buffer for M^-1 a, dim */
+      SearchNode&        child               /**< node to store the result */
+      ) const
+   {
+      /* u = M^-1 a from the rows of the symmetric inverse at the nonzeros of a */
+      u.assign(dim, 0.0);
+      for( int q = start[pos]; q < start[pos + 1]; q++ )
+      {
+         const double* row = &parent.Minv[index[q] * dim];
+         for( int i = 0; i < dim; i++ )
+            u[i] += value[q] * row[i];
+      }
+      double h = max(dot(pos, u.data()), 0.0);
+      double scale = 1.0 / (1.0 + h);
+
+      child.logdet = parent.logdet + log1p(h);
+      for( int j = 0; j < m; j++ )
+      {
+         double uj = dot(j, u.data());
+         child.lev[j] = max(parent.lev[j] - uj * uj * scale, 0.0);
+      }
+      if( inverse )
+      {
+         for( int i = 0; i < dim; i++ )
+         {
+            double ui = u[i] * scale;
+            const double* prow = &parent.Minv[i * dim];
+            double* crow = &child.Minv[i * dim];
+            for( int k = 0; k < dim; k++ )
+               crow[k] = prow[k] - ui * u[k];
+         }
+      }
+   }
+
+   /** raises the shared best value to the given one */
+   void raiseBest(
+      double             val                 /**< log-determinant of a design */
+      )
+   {
+      double cur = best.load(memory_order_relaxed);
+      while( val > cur && !best.compare_exchange_weak(cur, val, memory_order_relaxed) )
+      {
+      }
+   }
+};
+
+/** depth-first search of a subtree on one thread */
+class SearchWorker
+{
+public:
+   /** constructs a worker with room for the nodes of designs of the given size */
+   SearchWorker(
+      DesignSearch&      search,             /**< the shared data */
+      int                size                /**< number of points to choose */
+      ) : search_(search), nodes_(size + 1), result_(NULL)
+   {
+      for( size_t l = 0; l < nodes_.size(); l++ )
+      {
+         nodes_[l].Minv.resize(search.dim * search.dim);
+         nodes_[l].lev.resize(search.n);
+      }
+   }
+
+   /** searches a subtree and stores its best design and statistics */
+   void run(
+      const SearchTask&  task,               /**< the subtree */
+      TaskResult&        result              /**< result to fill */
+      )
+   {
+      result_ = &result;
+      chosen_.clear();
+
+      /* node of the prefix, from the node of the fixed points */
+      nodes_[0].Minv = search_.root.Minv;
+      nodes_[0].lev = search_.root.lev;
+      nodes_[0].logdet = search_.root.logdet;
+      int r = task.r + (int) task.prefix.size();
+      for( size_t l = 0; l < task.prefix.size(); l++ )
+      {
+         int pos = task.prefix[l];
+         r--;
+         search_.addPoint(nodes_[l], pos, pos, r >= 2, u_, nodes_[l + 1]);
+         chosen_.push_back(pos);
+      }
+
+      visit(task.m, task.r, task.reversed, (int) task.prefix.size());
+   }
+
+private:
+   /** visits the node at a level with the undecided positions 0, ..., m - 1 and r points left to choose */
+   void visit(
+      int                m,                  /**< number of undecided candidates */
+      int                r,                  /**< number of points left to choose */
+      bool               reversed,           /**< is the subtree enumerated in reverse order? */
+      int                level               /**< level of the node on the stack */
+      )
+   {
+      if( search_.stopped.load(memory_order_relaxed) )
+         return;
+      if( (++result_->nnodes & CLOCK_INTERVAL) == 0 && search_.haslimit
+         && chrono::steady_clock::now() > search_.deadline )
+      {
+         search_.stopped.store(true);
+         return;
+      }
+
+      const SearchNode& node = nodes_[level];
+      if( r == 0 )
+      {
+         result_->nleaves++;
+         record(node.logdet, -1);
+         return;
+      }
+
+      /* the designs that complete the node with one point, in enumeration order: the best has the largest leverage */
+      if( r == 1 )
+      {
+         result_->nleaves += m;
+         int bestpos = -1;
+         for( int k = 0; k < m; k++ )
+         {
+            int j = reversed ? m - 1 - k : k;
+            if( bestpos < 0 || node.lev[j] > node.lev[bestpos] )
+               bestpos = j;
+         }
+         record(node.logdet + log1p(node.lev[bestpos]), bestpos);
+         return;
+      }
+
+      /* Hadamard bound: the product of the r largest 1 + h_j of the undecided candidates against the best design */
+      if( m > r )
+      {
+         buffer_.assign(node.lev.begin(), node.lev.begin() + m);
+         nth_element(buffer_.begin(), buffer_.begin() + (r - 1), buffer_.end(), greater<double>());
+         double bound = 1.0;
+         for( int k = 0; k < r; k++ )
+            bound *= 1.0 + buffer_[k];
+         if( bound < exp(search_.best.load(memory_order_relaxed) - node.logdet) )
+         {
+            result_->npruned++;
+            return;
+         }
+      }
+
+      if( !reversed )
+      {
+         exclude(m, r, false, level);
+         include(m, r, true, level);
+      }
+      else
+      {
+         include(m, r, false, level);
+         exclude(m, r, true, level);
+      }
+   }
+
+   /** visits the child of a node without the candidate m - 1 */
+   void exclude(
+      int                m,                  /**< number of undecided candidates of the node */
+      int                r,                  /**< number of points left to choose at the node */
+      bool               reversed,           /**< is the child enumerated in reverse order? */
+      int                level               /**< level of the node */
+      )
+   {
+      if( m - 1 >= r )
+         visit(m - 1, r, reversed, level);
+   }
+
+   /** visits the child of a node with the candidate m - 1 */
+   void include(
+      int                m,                  /**< number of undecided candidates of the node */
+      int                r,                  /**< number of points left to choose at the node */
+      bool               reversed,           /**< is the child enumerated in reverse order? */
+      int                level               /**< level of the node */
+      )
+   {
+      search_.addPoint(nodes_[level], m - 1, m - 1, r - 1 >= 2, u_, nodes_[level + 1]);
+      chosen_.push_back(m - 1);
+      visit(m - 1, r - 1, reversed, level + 1);
+      chosen_.pop_back();
+   }
+
+   /** records the chosen points and the given one as best design of the subtree if it improves on it */
+   void record(
+      double             logdet,             /**< log-determinant of the design */
+      int                pos                 /**< additional position, or -1 */
+      )
+   {
+      if( logdet <= result_->logdet )
+         return;
+      result_->found = true;
+      result_->logdet = logdet;
+      result_->design = chosen_;
+      if( pos >= 0 )
+         result_->design.push_back(pos);
+      search_.raiseBest(logdet);
+   }
+
+   DesignSearch&         search_;            /**< the shared data */
+   vector<SearchNode>    nodes_;             /**< stack of the nodes of the current path */
+   vector<int>           chosen_;            /**< positions chosen on the current path */
+   vector<double>        u_;                 /**< buffer for M^-1 a */
+   vector<double>        buffer_;            /**< buffer for the bound */
+   TaskResult*           result_;            /**< result of the current subtree */
+};
+
+/** splits the search below a node into subtrees of the given depth, in enumeration order */
+void splitSearch(
+   int                   m,                  /**< number of undecided candidates */
+   int                   r,                  /**< number of points left to choose */
+   bool                  reversed,           /**< is the node enumerated in reverse order? */
+   int                   depth,              /**< remaining depth of the split */
+   vector<int>&          prefix,             /**< positions chosen above the node */
+   vector<SearchTask>&   tasks               /**< vector to append the subtrees to */
+   )
+{
+   if( depth == 0 || r <= 1 || r == m )
+   {
+      SearchTask task;
+      task.prefix = prefix;
+      task.m = m;
+      task.r = r;
+      task.reversed = reversed;
+      tasks.push_back(task);
+      return;
+   }
+
+   auto exclude = [&](bool rev)
+   {
+      if( m - 1 >= r )
+         splitSearch(m - 1, r, rev, depth - 1, prefix, tasks);
+   };
+   auto include = [&](bool rev)
+   {
+      prefix.push_back(m - 1);
+      splitSearch(m - 1, r - 1, rev, depth - 1, prefix, tasks);
+      prefix.pop_back();
+   };
+   if( !reversed )
+   {
+      exclude(false);
+      include(true);
+   }
+   else
+   {
+      include(false);
+      exclude(true);
+   }
+}
+
+} // namespace
+
+
+/** enumerates the designs that consist of the fixed points and size of the candidates, and finds the one with the
+ *  largest log det(eps2 * I + sum_i a_i a_i^T) above lowerbound; returns false if the time limit stopped the
+ *  enumeration, in which case the design is the best one found so far
+ */
+bool enumerateDesigns(
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   double                eps2,               /**< regularization added to the diagonal, must be positive */
+   const DimKernel&      kernel,             /**< kernels of the dimension of A */
+   const vector<int>&    fixed,              /**< the points that are in every design */
+   const vector<int>&    candidates,         /**< the points to choose from */
+   int                   size,               /**< the number of candidates to choose */
+   double                lowerbound,         /**< only designs with a larger log-determinant are of interest */
+   double                timelimit,          /**< limit on the wall clock time in seconds */
+   ThreadPool*           pool,               /**< thread pool of the subtrees, or NULL to run on the calling thread */
+   vector<int>&          design,             /**< vector to store the best design including the fixed points, empty if
+                                              *   no design is above lowerbound */
+   double&               logdet,             /**< pointer to store the log-determinant of the design, or lowerbound */
+   EnumerationStats&     stats               /**< statistics of the enumeration */
+   )
+{
+   int dim = (int) A.size();
+   int n = (int) candidates.size();
+   design.clear();
+   logdet = lowerbound;
+   stats.nnodes = 0;
+   stats.nleaves = 0;
+   stats.npruned = 0;
+   stats.ntasks = 0;
+   if( size < 0 || size > n || eps2 <= 0.0 )
+      return true;
+
+   /* inverse and log-determinant of the information matrix of the fixed points, M^-1 = L^-T L^-1 */
+   vector<double> L;
+   informationMatrix(A, fixed, eps2, L);
+   if( !kernel.factor(dim, L.data()) )
+      return true;
+
+   DesignSearch search;
+   search.dim = dim;
+   search.n = n;
+   search.root.logdet = kernel.logdet(dim, L.data());
+   vector<double> W(dim * dim, 0.0);
+   vector<double> col(dim);
+   for( int k = 0; k < dim; k++ )
+   {
+      col.assign(dim, 0.0);
+      col[k] = 1.0;
+      kernel.solveLower(dim, L.data(), col.data());
+      for( int i = 0; i < dim; i++ )
+         W[i * dim + k] = col[i];
+   }
+   search.root.Minv.assign(dim * dim, 0.0);
+   for( int i = 0; i < dim; i++ )
+      for( int k = 0; k < dim; k++ )
+         for( int l = max(i, k); l < dim; l++ )
+            search.root.Minv[i * dim + k] += W[l * dim + i] * W[l * dim + k];
+
+   /* greedy order: the first size positions are the greedy design, the others follow by their leverage at the
+    * fixed points; the candidates are stored sparse in that order
+    */
+   DesignSearch order;
+   order.dim = dim;
+   order.n = n;
+   order.start.push_back(0);
+   for( int c = 0; c < n; c++ )
+   {
+      for( int j = 0; j < dim; j++ )
+      {
+         if( A[j][candidates[c]] != 0.0 )
+         {
+            order.index.push_back(j);
+            order.value.push_back(A[j][candidates[c]]);
+         }
+      }
+      order.start.push_back((int) order.index.size());
+   }
+   SearchNode cur = search.root;
+   cur.lev.resize(n);
+   vector<double> u(dim);
+   for( int c = 0; c < n; c++ )
+   {
+      u.assign(dim, 0.0);
+      for( int q = order.start[c]; q < order.start[c + 1]; q++ )
+         for( int i = 0; i < dim; i++ )
+            u[i] += order.value[q] * search.root.Minv[order.index[q] * dim + i];
+      cur.lev[c] = max(order.dot(c, u.data()), 0.0);
+   }
+   vector<double> rootlev = cur.lev;
+
+   vector<int> perm;
+   vector<bool> taken(n, false);
+   SearchNode next = cur;
+   for( int k = 0; k < size; k++ )
+   {
+      int bestc = -1;
+      for( int c = 0; c < n; c++ )
+      {
+         if( !taken[c] && (bestc < 0 || cur.lev[c] > cur.lev[bestc]) )
+            bestc = c;
+      }
+      taken[bestc] = true;
+      perm.push_back(bestc);
+      order.addPoint(cur, bestc, n, true, u, next);
+      swap(cur, next);
+   }
+   vector<int> rest;
+   for( int c = 0; c < n; c++ )
+   {
+      if( !taken[c] )
+         rest.push_back(c);
+   }
+   stable_sort(rest.begin(), rest.end(), [&rootlev](int c1, int c2) { return rootlev[c1] > rootlev[c2]; });
+   perm.insert(perm.end(), rest.begin(), rest.end());
+
+   search.start.push_back(0);
+   search.root.lev.resize(n);
+   for( int pos = 0; pos < n; pos++ )
+   {
+      int c = perm[pos];
+      for( int q = order.start[c]; q < order.start[c + 1]; q++ )
+      {
+         search.index.push_back(order.index[q]);
+         search.value.push_back(order.value[q]);
+      }
+      search.start.push_back((int) search.index.size());
+      search.root.lev[pos] = rootlev[c];
+   }
+
+   /* the subtrees in enumeration order */
+   int nthreads = pool != NULL ? pool->getNThreads() : 1;
+   int depth = 0;
+   while( nthreads > 1 && (1 << depth) < SPLIT_TASKS_PER_THREAD * nthreads && depth < 30 )
+      depth++;
+   vector<SearchTask> tasks;
+   vector<int> prefix;
+   splitSearch(n, size, false, depth, prefix, tasks);
+
+   search.best.store(lowerbound);
+   search.stopped.store(false);
+   search.haslimit = timelimit < 1e20;
+   if( search.haslimit )
+      search.deadline = chrono::steady_clock::now()
+         + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(max(timelimit, 0.0)));
+
+   vector<TaskResult> results(tasks.size());
+   for( size_t k = 0; k < results.size(); k++ )
+   {
+      results[k].found = false;
+      results[k].logdet = lowerbound;
+      results[k].nnodes = 0;
+      results[k].nleaves = 0;
+      results[k].npruned = 0;
+   }
+   vector<SearchWorker*> workers(nthreads, NULL);
+   auto runTask = [&](int k, int thread)
+   {
+      if( workers[thread] == NULL )
+         workers[thread] = new SearchWorker(search, size);
+      workers[thread]->run(tasks[k], results[k]);
+   };
+   if( pool != NULL )
+      pool->parallelFor((int) tasks.size(), runTask);
+   else
+   {
+      for( int k = 0; k < (int) tasks.size(); k++ )
+         runTask(k, 0);
+   }
+   for( int t = 0; t < nthreads; t++ )
+      delete workers[t];
+
+   /* the first best design in enumeration order */
+   int bestk = -1;
+   for( size_t k = 0; k < results.size(); k++ )
+   {
+      stats.nnodes += results[k].nnodes;
+      stats.nleaves += results[k].nleaves;
+      stats.npruned += results[k].npruned;
+      if( results[k].found && (bestk < 0 || results[k].logdet > results[bestk].logdet) )
+         bestk = (int) k;
+   }
+   stats.ntasks = (int) tasks.size();
+
+   if( bestk >= 0 )
+   {
+      logdet = results[bestk].logdet;
+      design = fixed;
+      for( size_t k = 0; k < results[bestk].design.size(); k++ )
+         design.push_back(candidates[perm[results[bestk].design[k]]]);
+   }
+
+   return !search.stopped.load();
+}
@@ -0,0 +1,89 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   enumerate.h
+ * @brief  exhaustive enumeration of the designs of small instances
+ * @author Liding Xu
+ *
+ * The designs that contain the fixed points and size of the n candidate points are enumerated in revolving-door
+ * order (Knuth, TAOCP 7.2.1.3, algorithm R), in which consecutive subsets differ by the exchange of one point. The
+ * order is the leaf order of the recursion
+ *
+ *    C(m, r) = C(m - 1, r), C(m - 1, r - 1)^R + {m - 1},     C(m, r)^R = C(m - 1, r - 1) + {m - 1}, C(m - 1, r)^R,
+ *
+ * where ^R is the reverse order, so the enumeration is a depth-first search that decides the candidates from the
+ * last to the first. A node of the search keeps M^-1 and log det M of the information matrix M of its points, and the
+ * leverages h_j = a_j^T M^-1 a_j of the undecided candidates. Adding a point a is a rank-one update: with u = M^-1 a,
+ *
+ *    log det M' = log det M + log(1 + h),   M'^-1 = M^-1 - u u^T / (1 + h),   h'_j = h_j - (a_j^T u)^2 / (1 + h),
+ *
+ * which costs O(dim^2) for M'^-1 and O(nnz) per leverage for sparse points, and the designs that complete a node with
+ * one point are evaluated in O(1) each from the leverages of the node. Nodes are kept on a stack instead of being
+ * downdated, which would lose accuracy when 1 - h is small.
+ *
+ * A node with r points left to choose is pruned if its bound log det M + the sum of the r largest log(1 + h_j), which
+ * holds by the Hadamard inequality for det(I + V^T M^-1 V), is below the best design found. The candidates are
+ * ordered greedily, so that the first design of the enumeration is the greedy design.
+ *
+ * The search tree is split at a fixed depth into subtrees that run on a thread pool and share the value of the best
+ * design for pruning. The best design of every subtree is kept in a slot of its own and the slots are merged in the
+ * enumeration order, so the result does not depend on the number of threads; without the regularization eps2 > 0,
+ * the information matrices of small designs are singular and nothing is enumerated.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __DOPT_ENUMERATE_H__
+#define __DOPT_ENUMERATE_H__
+
+#include <vector>
+#include "linalgkernel.h"
+#include "threadpool.h"
+
+/** statistics of an enumeration */
+struct EnumerationStats
+{
+   long long             nnodes;             /**< number of nodes of the search, i.e., of partial designs */
+   long long             nleaves;            /**< number of designs evaluated */
+   long long             npruned;            /**< number of nodes pruned by their bound */
+   int                   ntasks;             /**< number of subtrees the search was split into */
+};
+
+/** returns the binomial coefficient C(n, k) as a floating point number, 0 if k < 0 or k > n */
+double binomialCount(
+   int                   n,                  /**< size of the set */
+   int                   k                   /**< size of the subsets */
+   );
+
+/** enumerates the designs that consist of the fixed points and size of the candidates, and finds the one with the
+ *  largest log det(eps2 * I + sum_i a_i a_i^T) above lowerbound; returns false if the time limit stopped the
+ *  enumeration, in which case the design is the best one found so far
+ */
+bool enumerateDesigns(
+   const std::vector<std::vector<double>>& A, /**< data matrix: dim * numvars */
+   double                eps2,               /**< regularization added to the diagonal, must be positive */
+   const DimKernel&      kernel,             /**< kernels of the dimension of A */
+   const std::vector<int>& fixed,            /**< the points that are in every design */
+   const std::vector<int>& candidates,       /**< the points to choose from */
+   int                   size,               /**< the number of candidates to choose */
+   double                lowerbound,         /**< only designs with a larger log-determinant are of interest */
+   double                timelimit,          /**< limit on the wall clock time in seconds */
+   ThreadPool*           pool,               /**< thread pool of the subtrees, or NULL to run on the calling thread */
+   std::vector<int>&     design,             /**< vector to store the best design including the fixed points, empty if
+                                              *   no design is above lowerbound */
+   double&               logdet,             /**< pointer to store the log-determinant of the design, or lowerbound */
+   EnumerationStats&     stats               /**< statistics of the enumeration */
+   );
+
+#endif
@@ -0,0 +1,419 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   event_cache.cpp
+ * @brief  content-addressed cache of the root state of design instances
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <array>
+#include <atomic>
+#include <map>
+#include <set>
+#include <string>
+
+#include "event_cache.h"
+#include "probdata.h"
+
+using namespace scip;
+using namespace std;
+
+#define EVENTHDLR_NAME         "designcache"
+#define EVENTHDLR_DESC         "event handler that loads and stores the root cuts and the best design of instances"
+
+#define DEFAULT_DIR            ""            /**< cache directory, or empty to disable the cache */
+#define DEFAULT_MAXPERCONE     3             /**< maximal number of cached cuts of a cone */
+#define DEFAULT_MAXCUTS        20000         /**< maximal number of cached cuts of an instance */
+
+#define CUTKEY_TOL             1e-6          /**< rounding of the unit coefficients of the duplicate detection */
+
+
+/** adds the bytes of a value to an FNV-1a hash */
+static
+void hashBytes(
+   uint64_t&             hash,               /**< hash to update */
+   const void*           data,               /**< the value */
+   size_t                size                /**< size of the value in bytes */
+   )
+{
+   const unsigned char* bytes = (const unsigned char*) data;
+   for( size_t k = 0; k < size; k++ )
+   {
+      hash ^= bytes[k];
+      hash *= 1099511628211ULL;
+   }
+}
+
+/** returns the name of the cache file of a key */
+static
+string cacheFileName(
+   const char*           dir,                /**< cache directory */
+   uint64_t              key                 /**< cache key */
+   )
+{
+   char name[32];
+   (void) SCIPsnprintf(name, 32, "%016llx.dcache", (unsigned long long) key);
+   return string(dir) + "/" + name;
+}
+
+/** merges the root cuts of the last solve into the cached cuts: the cuts, whose right hand side is 0, are scaled to
+ *  unit norm, a cut whose coefficients agree with those of a newer cut after rounding to multiples of CUTKEY_TOL is
+ *  dropped, and at most maxpercone cuts of each cone and maxcuts cuts in total are kept, the newest first, so the
+ *  entry does not grow with the number of solves
+ */
+static
+void mergeConeCuts(
+   const vector<SepaCone::ConeCut>& newcuts, /**< root cuts of the last solve */
+   vector<SepaCone::ConeCut>& cuts,          /**< cached cuts, replaced by the merged cuts */
+   int                   maxpercone,         /**< maximal number of cuts of a cone */
+   int                   maxcuts             /**< maximal number of cuts */
+   )
+{
+   vector<SepaCone::ConeCut> merged;
+   set<array<long long, 5>> keys;
+   map<pair<int, int>, int> ncone;
+
+   for( int pass = 0; pass < 2; pass++ )
+   {
+      const vector<SepaCone::ConeCut>& source = (pass == 0 ? newcuts : cuts);
+      for( size_t k = 0; k < source.size() && (int) merged.size() < maxcuts; k++ )
+      {
+         SepaCone::ConeCut cut = source[k];
+         SCIP_Real norm = sqrt(cut.coefs[0] * cut.coefs[0] + cut.coefs[1] * cut.coefs[1] + cut.coefs[2] * cut.coefs[2]);
+         if( !(norm > 0.0) )
+            continue;
+         for( int c = 0; c < 3; c++ )
+            cut.coefs[c] /= norm;
+
+         array<long long, 5> key = {{cut.i, cut.j, llround(cut.coefs[0] / CUTKEY_TOL), llround(cut.coefs[1] / CUTKEY_TOL),
+               llround(cut.coefs[2] / CUTKEY_TOL)}};
+         int& count = ncone[make_pair(cut.i, cut.j)];
+         if( count >= maxpercone || !keys.insert(key).second )
+            continue;
+         count++;
+         merged.push_back(cut);
+      }
+   }
+
+   cuts.swap(merged);
+}
+
+
+/** returns the cache key of the instance of a problem data */
+uint64_t designCacheKey(
+   const ProbData*       probdata            /**< problem data */
+   )
+{
+   uint64_t hash = 14695981039346656037ULL;
+   SCIP_Real dim = probdata->dim;
+
+   hashBytes(hash, &probdata->numvars, sizeof(int));
+   hashBytes(hash, &dim, sizeof(SCIP_Real));
+   hashBytes(hash, &probdata->card, sizeof(SCIP_Real));
+   hashBytes(hash, &probdata->epsilon, sizeof(SCIP_Real));
+   for( int j = 0; j < probdata->dim; j++ )
+      hashBytes(hash, probdata->A[j].data(), probdata->numvars * sizeof(SCIP_Real));
+
+   return hash;
+}
+
+/** reads the entry of a key from a cache directory; returns SCIP_NOFILE if there is none */
+SCIP_RETCODE readDesignCache(
+   const char*           dir,                /**< cache directory */
+   uint64_t              key,                /**< cache key */
+   DesignCacheEntry&     entry               /**< entry to store the data */
+   )
+{
+   FILE* file = fopen(cacheFileName(dir, key).c_str(), "r");
+   if( file == NULL )
+      return SCIP_NOFILE;
+
+   int ndesign = -1;
+   int ncuts = -1;
+   SCIP_Bool success = fscanf(file, " designcache %d %d %lf %lf", &entry.numvars, &entry.dim, &entry.card,
+         &entry.epsilon) == 4
+      && fscanf(file, " rootdual %lf", &entry.rootdual) == 1
+      && fscanf(file, " design %d", &ndesign) == 1 && ndesign >= 0 && ndesign <= entry.numvars;
+
+   entry.design.resize(success ? ndesign : 0);
+   for( int k = 0; success && k < ndesign; k++ )
+      success = fscanf(file, "%d", &entry.design[k]) == 1 && entry.design[k] >= 0 && entry.design[k] < entry.numvars;
+
+   success = success && fscanf(file, " cuts %d", &ncuts) == 1 && ncuts >= 0;
+   entry.cuts.resize(success ? ncuts : 0);
+   for( int k = 0; success && k < ncuts; k++ )
+   {
+      SepaCone::ConeCut& cut = entry.cuts[k];
+      success = fscanf(file, "%d %d %lf %lf %lf", &cut.i, &cut.j, &cut.coefs[0], &cut.coefs[1], &cut.coefs[2]) == 5
+         && cut.i >= 0 && cut.i < entry.numvars && cut.j >= 0 && cut.j < entry.dim;
+   }
+   fclose(file);
+
+   if( !success )
+   {
+      SCIPerrorMessage("corrupt design cache file <%s>\n", cacheFileName(dir, key).c_str());
+      return SCIP_READERROR;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** writes the entry of a key to a cache directory */
+SCIP_RETCODE writeDesignCache(
+   const char*           dir,                /**< cache directory */
+   uint64_t              key,                /**< cache key */
+   const DesignCacheEntry& entry             /**< entry to write */
+   )
+{
+   /* the entry is written to a temporary file and renamed, so that concurrent solves never read a partial entry; the
+    * temporary file is unique to the process and the call, since the daemon solves in several threads
+    */
+   static std::atomic<unsigned> nwrites(0);
+   string filename = cacheFileName(dir, key);
+   string tmpname = filename + "." + std::to_string((long) getpid()) + "." + std::to_string(nwrites++) + ".tmp";
+   FILE* file = fopen(tmpname.c_str(), "w");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot write design cache file <%s>\n", tmpname.c_str());
+      return SCIP_NOFILE;
+   }
+
+   fprintf(file, "designcache %d %d %.17g %.17g\n", entry.numvars, entry.dim, entry.card, entry.epsilon);
+   fprintf(file, "rootdual %.17g\n", entry.rootdual);
+   fprintf(file, "design %d", (int) entry.design.size());
+   for( size_t k = 0; k < entry.design.size(); k++ )
+      fprintf(file, " %d", entry.design[k]);
+   fprintf(file, "\ncuts %d\n", (int) entry.cuts.size());
+   for( size_t k = 0; k < entry.cuts.size(); k++ )
+   {
+      const SepaCone::ConeCut& cut = entry.cuts[k];
+      fprintf(file, "%d %d %.17g %.17g %.17g\n", cut.i, cut.j, cut.coefs[0], cut.coefs[1], cut.coefs[2]);
+   }
+
+   SCIP_Bool success = !ferror(file);
+   success = (fclose(file) == 0) && success;
+   if( !success || rename(tmpname.c_str(), filename.c_str()) != 0 )
+   {
+      SCIPerrorMessage("cannot write design cache file <%s>\n", filename.c_str());
+      (void) remove(tmpname.c_str());
+      return SCIP_WRITEERROR;
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** default constructor */
+EventhdlrCache::EventhdlrCache(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjEventhdlr(scip, EVENTHDLR_NAME, EVENTHDLR_DESC),
+     dir_(NULL),
+     maxpercone_(DEFAULT_MAXPERCONE),
+     maxcuts_(DEFAULT_MAXCUTS),
+     branched_(FALSE)
+{
+   SCIP_CALL_ABORT( SCIPaddStringParam(scip, "eventhdlr/" EVENTHDLR_NAME "/dir",
+         "directory of the cache of root cuts and best designs of instances (empty: no cache)",
+         &dir_, FALSE, DEFAULT_DIR, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "eventhdlr/" EVENTHDLR_NAME "/maxpercone",
+         "maximal number of cached root cuts of a cone, the newest are kept",
+         &maxpercone_, FALSE, DEFAULT_MAXPERCONE, 1, INT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "eventhdlr/" EVENTHDLR_NAME "/maxcuts",
+         "maximal number of cached root cuts of an instance, the newest are kept",
+         &maxcuts_, FALSE, DEFAULT_MAXCUTS, 0, INT_MAX, NULL, NULL) );
+}
+
+
+/** adds the cached cuts and design of the instance of the original problem, if the cache is enabled and has an
+ *  entry for it
+ */
+SCIP_RETCODE EventhdlrCache::loadInstance(
+   SCIP*                 scip,               /**< SCIP data structure */
+   ProbData*             probdata            /**< original problem data */
+   )
+{
+   assert(probdata != NULL && probdata->orig_data == NULL);
+
+   if( dir_ == NULL || dir_[0] == '\0' )
+      return SCIP_OKAY;
+
+   uint64_t key = designCacheKey(probdata);
+   DesignCacheEntry entry;
+   SCIP_RETCODE retcode = readDesignCache(dir_, key, entry);
+   if( retcode != SCIP_OKAY )
+   {
+      /* a corrupt or truncated entry is a miss and is replaced at the end of the solve */
+      if( retcode != SCIP_NOFILE )
+      {
+         SCIPwarningMessage(scip, "design cache: ignoring the unreadable entry of key %016llx\n", (unsigned long long) key);
+      }
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "design cache: miss for key %016llx\n", (unsigned long long) key);
+      return SCIP_OKAY;
+   }
+
+   /* a hash collision is ignored */
+   if( entry.numvars != probdata->numvars || entry.dim != probdata->dim || entry.card != probdata->card
+      || entry.epsilon != probdata->epsilon )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "design cache: key %016llx belongs to another instance\n",
+         (unsigned long long) key);
+      return SCIP_OKAY;
+   }
+
+   /* points of the design that are not in the model of the pricing mode are added to it */
+   for( size_t k = 0; k < entry.design.size(); k++ )
+   {
+      if( !probdata->hasPoint(entry.design[k]) )
+      {
+         SCIP_CALL( probdata->addPoint(scip, entry.design[k], 0.0) );
+      }
+   }
+
+   SCIP_Bool stored = FALSE;
+   if( !entry.design.empty() && probdata->designObjective(entry.design) != SCIP_INVALID )
+   {
+      SCIP_SOL* sol;
+      SCIP_CALL( probdata->createDesignSol(scip, entry.design, &sol) );
+      SCIP_CALL( SCIPaddSolFree(scip, &sol, &stored) );
+   }
+
+   /* the cuts of points that are not in the model have no columns */
+   int ncuts = 0;
+   for( size_t k = 0; k < entry.cuts.size(); k++ )
+   {
+      if( probdata->hasPoint(entry.cuts[k].i) )
+      {
+         SCIP_CALL( probdata->addConeCut(scip, entry.cuts[k].i, entry.cuts[k].j, entry.cuts[k].coefs) );
+         ncuts++;
+      }
+   }
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+      "design cache: hit for key %016llx, design of %d points %s, %d root cuts, cached root dual bound %.9g\n",
+      (unsigned long long) key, (int) entry.design.size(), stored ? "stored" : "not stored", ncuts, entry.rootdual);
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+SCIP_DECL_EVENTINITSOL(EventhdlrCache::scip_initsol)
+{
+   if( dir_ == NULL || dir_[0] == '\0' )
+      return SCIP_OKAY;
+
+   if( !SCIPisInRestart(scip) )
+      branched_ = FALSE;
+   if( !branched_ )
+   {
+      SCIP_CALL( SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODEBRANCHED, eventhdlr, NULL, NULL) );
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+SCIP_DECL_EVENTEXITSOL(EventhdlrCache::scip_exitsol)
+{
+   if( dir_ == NULL || dir_[0] == '\0' )
+      return SCIP_OKAY;
+
+   if( !branched_ )
+   {
+      SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_NODEBRANCHED, eventhdlr, NULL, -1) );
+   }
+
+   /* the root state of a restart is superseded by the one of the next run */
+   if( SCIPisInRestart(scip) )
+      return SCIP_OKAY;
+
+   if( !branched_ )
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "design cache: no branching after %.2f s\n", SCIPgetSolvingTime(scip));
+
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   assert(probdata != NULL);
+   uint64_t key = designCacheKey(probdata);
+
+   /* the new entry extends the old one of the same instance */
+   DesignCacheEntry entry;
+   if( readDesignCache(dir_, key, entry) != SCIP_OKAY || entry.numvars != probdata->numvars || entry.dim != probdata->dim
+      || entry.card != probdata->card || entry.epsilon != probdata->epsilon )
+   {
+      entry.design.clear();
+      entry.cuts.clear();
+   }
+   entry.numvars = probdata->numvars;
+   entry.dim = probdata->dim;
+   entry.card = probdata->card;
+   entry.epsilon = probdata->epsilon;
+   entry.rootdual = SCIPgetDualboundRoot(scip);
+
+   /* the better of the cached design and the design of the incumbent is kept */
+   SCIP_SOL* sol = SCIPgetBestSol(scip);
+   if( sol != NULL )
+   {
+      vector<int> design;
+      for( int i = 0; i < probdata->numvars; i++ )
+      {
+         if( probdata->hasPoint(i) && SCIPgetSolVal(scip, sol, probdata->bin_vars[i]) > 0.5 )
+            design.push_back(i);
+      }
+
+      SCIP_Real value = design.empty() ? SCIP_INVALID : probdata->designObjective(design);
+      SCIP_Real cachedvalue = entry.design.empty() ? SCIP_INVALID : probdata->designObjective(entry.design);
+      if( value != SCIP_INVALID && (cachedvalue == SCIP_INVALID || value > cachedvalue) )
+         entry.design.swap(design);
+   }
+
+   SepaCone* sepa = dynamic_cast<SepaCone*>(SCIPfindObjSepa(scip, "conegrid"));
+   if( sepa != NULL )
+   {
+      mergeConeCuts(sepa->rootCuts(), entry.cuts, maxpercone_, maxcuts_);
+   }
+
+   /* the solve is finished, so a cache that cannot be written only loses the entry */
+   if( writeDesignCache(dir_, key, entry) != SCIP_OKAY )
+   {
+      SCIPwarningMessage(scip, "design cache: the entry of key %016llx is not stored\n", (unsigned long long) key);
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** execution method of event handler */
+SCIP_DECL_EVENTEXEC(EventhdlrCache::scip_exec)
+{
+   assert(SCIPeventGetType(event) == SCIP_EVENTTYPE_NODEBRANCHED);
+
+   if( branched_ )
+      return SCIP_OKAY;
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "design cache: first branching after %.2f s\n", SCIPgetSolvingTime(scip));
+   branched_ = TRUE;
+   SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_NODEBRANCHED, eventhdlr, NULL, -1) );
+
+   return SCIP_OKAY;
+}
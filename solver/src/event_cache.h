@@ -0,0 +1,119 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   event_cache.h
+ * @brief  content-addressed cache of the root state of design instances
+ * @author Liding Xu
+ *
+ * The key of an instance is the 64-bit FNV-1a hash of numvars, dim, card, epsilon and the data matrix A. For each
+ * key, the cache directory holds a text file <key>.dcache with the root dual bound, the best design found and the
+ * gradient cuts of the cones found by the separator "conegrid" at the root node. When the reader builds a model whose
+ * key is in the cache, the cuts are added as removable rows of the initial LP and the design as starting solution,
+ * so the root node starts from the final LP of the earlier solve and the incumbent. At the end of every solve, the
+ * entry is written, keeping the better of the cached and the new design and merging the new root cuts into the
+ * cached ones: cuts are scaled to unit norm, near-identical cuts are dropped, and the newest "maxpercone" cuts of each
+ * cone and "maxcuts" cuts in total are kept, so neither the file nor the initial LP grows with repeated solves. The
+ * cache never fails a read or a solve: an unreadable entry is a miss, and an entry that cannot be written is lost.
+ *
+ * The event handler also reports the solving time of the first branching, which is the time spent before the tree
+ * search starts.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENT_CACHE_H__
+#define __SCIP_EVENT_CACHE_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "objscip/objscip.h"
+#include "sepa_cone.h"
+
+class ProbData;
+
+
+/** cached root state of an instance */
+struct DesignCacheEntry
+{
+   int                   numvars;            /**< the number of points */
+   int                   dim;                /**< the dimension */
+   SCIP_Real             card;               /**< the cardinality */
+   SCIP_Real             epsilon;            /**< square root of the regularization */
+   SCIP_Real             rootdual;           /**< dual bound of the root node */
+   std::vector<int>      design;             /**< points of the best design found */
+   std::vector<SepaCone::ConeCut> cuts;      /**< cone cuts of the root node */
+};
+
+/** returns the cache key of the instance of a problem data */
+uint64_t designCacheKey(
+   const ProbData*       probdata            /**< problem data */
+   );
+
+/** reads the entry of a key from a cache directory; returns SCIP_NOFILE if there is none */
+SCIP_RETCODE readDesignCache(
+   const char*           dir,                /**< cache directory */
+   uint64_t              key,                /**< cache key */
+   DesignCacheEntry&     entry               /**< entry to store the data */
+   );
+
+/** writes the entry of a key to a cache directory */
+SCIP_RETCODE writeDesignCache(
+   const char*           dir,                /**< cache directory */
+   uint64_t              key,                /**< cache key */
+   const DesignCacheEntry& entry             /**< entry to write */
+   );
+
+
+/** event handler that loads and stores the root state of design instances */
+class EventhdlrCache : public scip::ObjEventhdlr
+{
+public:
+   /** default constructor */
+   EventhdlrCache(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~EventhdlrCache()
+   {
+   }
+
+   /** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_EVENTINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_EVENTEXITSOL(scip_exitsol);
+
+   /** execution method of event handler */
+   virtual SCIP_DECL_EVENTEXEC(scip_exec);
+
+   /** adds the cached cuts and design of the instance of the original problem, if the cache is enabled and has an
+    *  entry for it
+    */
+   SCIP_RETCODE loadInstance(
+      SCIP*              scip,               /**< SCIP data structure */
+      ProbData*          probdata            /**< original problem data */
+      );
+
+private:
+   char*                 dir_;               /**< cache directory, or empty to disable the cache */
+   int                   maxpercone_;        /**< maximal number of cached cuts of a cone */
+   int                   maxcuts_;           /**< maximal number of cached cuts of an instance */
+   SCIP_Bool             branched_;          /**< was the first branching of the solve reported? */
+};/*lint !e1712*/
+
+
+#endif
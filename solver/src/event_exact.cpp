@@ -0,0 +1,117 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   event_exact.cpp
+ * @brief  event handler that replaces new incumbents by the exact lifted solution of their design
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <vector>
+
+#include "event_exact.h"
+#include "probdata.h"
+
+using namespace scip;
+using namespace std;
+
+#define EVENTHDLR_NAME         "designexact"
+#define EVENTHDLR_DESC         "event handler that submits the exact lifted solution of the design of new incumbents"
+
+#define DEFAULT_ENABLED        TRUE          /**< should new incumbents be repaired? */
+
+
+/** default constructor */
+EventhdlrExact::EventhdlrExact(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjEventhdlr(scip, EVENTHDLR_NAME, EVENTHDLR_DESC),
+     enabled_(DEFAULT_ENABLED),
+     caught_(FALSE),
+     nrepaired_(0)
+{
+   SCIP_CALL_ABORT( SCIPaddBoolParam(scip, "eventhdlr/" EVENTHDLR_NAME "/enabled",
+         "should every new incumbent be replaced by the exact lifted solution of its design if this is better?",
+         &enabled_, FALSE, DEFAULT_ENABLED, NULL, NULL) );
+}
+
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+SCIP_DECL_EVENTINITSOL(EventhdlrExact::scip_initsol)
+{
+   nrepaired_ = 0;
+   caught_ = FALSE;
+
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( !enabled_ || probdata == NULL || probdata->obj_var == NULL )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPcatchEvent(scip, SCIP_EVENTTYPE_BESTSOLFOUND, eventhdlr, NULL, NULL) );
+   caught_ = TRUE;
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+SCIP_DECL_EVENTEXITSOL(EventhdlrExact::scip_exitsol)
+{
+   if( !caught_ )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_BESTSOLFOUND, eventhdlr, NULL, -1) );
+   caught_ = FALSE;
+   if( nrepaired_ > 0 )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "designexact: %d incumbents replaced by their exact lifting\n",
+         nrepaired_);
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** execution method of event handler */
+SCIP_DECL_EVENTEXEC(EventhdlrExact::scip_exec)
+{
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   SCIP_SOL* sol = SCIPeventGetSol(event);
+   if( probdata == NULL || sol == NULL )
+      return SCIP_OKAY;
+
+   vector<int> points;
+   for( int i = 0; i < probdata->numvars; i++ )
+   {
+      if( probdata->bin_vars[i] != NULL && SCIPgetSolVal(scip, sol, probdata->bin_vars[i]) > 0.5 )
+         points.push_back(i);
+   }
+
+   /* the exact lifting of a design reaches its value, so it is not repaired again; the objective is -obj_var */
+   SCIP_Real exact = probdata->designObjective(points);
+   if( exact == SCIP_INVALID || !SCIPisLT(scip, -exact, SCIPgetSolOrigObj(scip, sol)) )
+      return SCIP_OKAY;
+
+   SCIP_SOL* repaired;
+   SCIP_Bool stored;
+   SCIP_CALL( probdata->createDesignSol(scip, points, &repaired) );
+   SCIP_CALL( SCIPtrySolFree(scip, &repaired, FALSE, FALSE, TRUE, TRUE, TRUE, &stored) );
+   if( stored )
+      nrepaired_++;
+   SCIPdebugMsg(scip, "designexact: incumbent obj %g, exact obj %g of %d points, %s\n", -SCIPgetSolOrigObj(scip, sol),
+      exact, (int) points.size(), stored ? "stored" : "rejected");
+
+   return SCIP_OKAY;
+}
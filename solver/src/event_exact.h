@@ -0,0 +1,66 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   event_exact.h
+ * @brief  event handler that replaces new incumbents by the exact lifted solution of their design
+ * @author Liding Xu
+ *
+ * The obj of an incumbent can differ from the exact value of its design: solutions of the LP, of sub-SCIPs or of
+ * heuristics that do not lift the design optimally have a smaller obj, and with polyhedral cones
+ * ("reading/design/polydepth"), whose approximation is a relaxation of the cones, obj can be larger by the cone
+ * error. On every new incumbent, the handler evaluates its design exactly and submits the lifted solution of
+ * ProbData::createDesignSol() if it is better, so the incumbent is repaired during the solve, while the subtree
+ * that contains it is still open. A larger obj cannot be lowered, since SCIP keeps its best solution; the exact value
+ * of the final incumbent is reported by the problem data at the end of a solve with polyhedral cones.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENT_EXACT_H__
+#define __SCIP_EVENT_EXACT_H__
+
+#include "objscip/objscip.h"
+
+
+/** event handler that lifts the design of every new incumbent exactly */
+class EventhdlrExact : public scip::ObjEventhdlr
+{
+public:
+   /** default constructor */
+   EventhdlrExact(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~EventhdlrExact()
+   {
+   }
+
+   /** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_EVENTINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_EVENTEXITSOL(scip_exitsol);
+
+   /** execution method of event handler */
+   virtual SCIP_DECL_EVENTEXEC(scip_exec);
+
+private:
+   SCIP_Bool             enabled_;           /**< should new incumbents be repaired? */
+   SCIP_Bool             caught_;            /**< is the event caught in the current solve? */
+   int                   nrepaired_;         /**< number of repaired incumbents in the current solve */
+};/*lint !e1712*/
+
+
+#endif
@@ -0,0 +1,232 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   event_trace.cpp
+ * @brief  event handler that traces primal and dual bounds over time
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+
+#include "event_trace.h"
+
+using namespace scip;
+using namespace std;
+
+#define EVENTHDLR_NAME         "trace"
+#define EVENTHDLR_DESC         "event handler that writes a primal/dual bound trace as JSON lines"
+
+#define DEFAULT_FILENAME       ""            /**< name of the trace file, or empty to disable the trace */
+#define DEFAULT_INTERVAL       10.0          /**< maximal time between two records */
+
+#define EVENTTYPE_TRACE        (SCIP_EVENTTYPE_BESTSOLFOUND | SCIP_EVENTTYPE_NODESOLVED)
+
+
+/** writes a bound as JSON number, or null if it is infinite */
+static
+void writeBound(
+   SCIP*                 scip,               /**< SCIP data structure */
+   FILE*                 file,               /**< output file */
+   SCIP_Real             bound               /**< bound to write */
+   )
+{
+   if( SCIPisInfinity(scip, REALABS(bound)) )
+      fputs("null", file);
+   else
+      fprintf(file, "%.15g", bound);
+}
+
+/** returns the relative gap of a bound to a reference value as used for the primal integral */
+static
+SCIP_Real gapFunction(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_Real             bound,              /**< primal or dual bound */
+   SCIP_Real             ref                 /**< reference value */
+   )
+{
+   if( SCIPisInfinity(scip, REALABS(bound)) || bound * ref < 0.0 )
+      return 1.0;
+   if( SCIPisEQ(scip, bound, ref) )
+      return 0.0;
+   return MIN(1.0, REALABS(bound - ref) / MAX(REALABS(bound), REALABS(ref)));
+}
+
+
+/** default constructor */
+EventhdlrTrace::EventhdlrTrace(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjEventhdlr(scip, EVENTHDLR_NAME, EVENTHDLR_DESC),
+     filename_(NULL),
+     interval_(DEFAULT_INTERVAL),
+     refvalue_(SCIP_INVALID),
+     file_(NULL),
+     lastlowerbound_(SCIP_INVALID),
+     lasttime_(0.0)
+{
+   SCIP_CALL_ABORT( SCIPaddStringParam(scip, "eventhdlr/" EVENTHDLR_NAME "/filename",
+         "name of the JSON lines file for the bound trace (empty: no trace)",
+         &filename_, FALSE, DEFAULT_FILENAME, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "eventhdlr/" EVENTHDLR_NAME "/interval",
+         "maximal solving time in seconds between two records of the trace",
+         &interval_, FALSE, DEFAULT_INTERVAL, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "eventhdlr/" EVENTHDLR_NAME "/refvalue",
+         "reference objective value for the primal and dual integral (1e+99: use the final primal bound)",
+         &refvalue_, FALSE, SCIP_INVALID, -SCIP_INVALID, SCIP_INVALID, NULL, NULL) );
+}
+
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+SCIP_DECL_EVENTINITSOL(EventhdlrTrace::scip_initsol)
+{
+   samples_.clear();
+   lastlowerbound_ = SCIP_INVALID;
+   lasttime_ = 0.0;
+
+   if( filename_ == NULL || filename_[0] == '\0' )
+      return SCIP_OKAY;
+
+   file_ = fopen(filename_, "w");
+   if( file_ == NULL )
+   {
+      SCIPerrorMessage("cannot open trace file <%s>\n", filename_);
+      return SCIP_NOFILE;
+   }
+
+   SCIP_CALL( SCIPcatchEvent(scip, EVENTTYPE_TRACE, eventhdlr, NULL, NULL) );
+   record(scip, "start");
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+SCIP_DECL_EVENTEXITSOL(EventhdlrTrace::scip_exitsol)
+{
+   if( file_ == NULL )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPdropEvent(scip, EVENTTYPE_TRACE, eventhdlr, NULL, -1) );
+   record(scip, "end");
+
+   /* the reference is the given value, or the best known bound at the end of the solve */
+   SCIP_Real ref = refvalue_;
+   if( ref == SCIP_INVALID )
+      ref = SCIPisInfinity(scip, REALABS(SCIPgetPrimalbound(scip))) ? SCIPgetDualbound(scip) : SCIPgetPrimalbound(scip);
+
+   SCIP_Real endtime = SCIPgetSolvingTime(scip);
+   SCIP_Real primalintegral = integral(scip, ref, endtime, TRUE);
+   SCIP_Real dualintegral = integral(scip, ref, endtime, FALSE);
+
+   fprintf(file_, "{\"event\":\"summary\",\"time\":%.6g,\"ref\":", endtime);
+   writeBound(scip, file_, ref);
+   fprintf(file_, ",\"primalintegral\":%.9g,\"dualintegral\":%.9g,\"nsamples\":%d}\n", primalintegral, dualintegral,
+      (int) samples_.size());
+   fclose(file_);
+   file_ = NULL;
+
+   SCIPinfoMessage(scip, NULL, "Bound trace       : %d records written to <%s>\n", (int) samples_.size(), filename_);
+   SCIPinfoMessage(scip, NULL, "  primal integral : %.6g\n", primalintegral);
+   SCIPinfoMessage(scip, NULL, "  dual integral   : %.6g\n", dualintegral);
+
+   return SCIP_OKAY;
+}
+
+
+/** execution method of event handler */
+SCIP_DECL_EVENTEXEC(EventhdlrTrace::scip_exec)
+{
+   assert(file_ != NULL);
+
+   if( SCIPeventGetType(event) == SCIP_EVENTTYPE_BESTSOLFOUND )
+   {
+      record(scip, "primal");
+      return SCIP_OKAY;
+   }
+
+   /* the global dual bound can only change if the solved node attained it, so the tree is only scanned then */
+   SCIP_NODE* node = SCIPeventGetNode(event);
+   if( lastlowerbound_ == SCIP_INVALID || node == NULL || SCIPisLE(scip, SCIPnodeGetLowerbound(node), lastlowerbound_) )
+   {
+      SCIP_Real lowerbound = SCIPgetLowerbound(scip);
+      if( lastlowerbound_ == SCIP_INVALID || SCIPisGT(scip, lowerbound, lastlowerbound_) )
+      {
+         lastlowerbound_ = lowerbound;
+         record(scip, "dual");
+         return SCIP_OKAY;
+      }
+   }
+
+   if( SCIPgetSolvingTime(scip) - lasttime_ >= interval_ )
+      record(scip, "interval");
+
+   return SCIP_OKAY;
+}
+
+
+/** records the current bounds and writes them with the given event name */
+void EventhdlrTrace::record(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           eventname           /**< name of the event that triggered the record */
+   )
+{
+   assert(file_ != NULL);
+
+   Sample sample;
+   sample.time = SCIPgetSolvingTime(scip);
+   sample.primal = SCIPgetPrimalbound(scip);
+   sample.dual = SCIPgetDualbound(scip);
+   samples_.push_back(sample);
+   lasttime_ = sample.time;
+
+   fprintf(file_, "{\"event\":\"%s\",\"time\":%.6g,\"primal\":", eventname, sample.time);
+   writeBound(scip, file_, sample.primal);
+   fputs(",\"dual\":", file_);
+   writeBound(scip, file_, sample.dual);
+   fprintf(file_, ",\"nodes\":%lld,\"lpiters\":%lld}\n", (long long) SCIPgetNNodes(scip), (long long) SCIPgetNLPIterations(scip));
+
+   /* incumbents are flushed at once, so that the trace of a killed run is still useful */
+   if( strcmp(eventname, "primal") == 0 )
+      fflush(file_);
+}
+
+
+/** computes the integral of the gap between a bound and the reference value over the trace */
+SCIP_Real EventhdlrTrace::integral(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_Real             ref,                /**< reference objective value */
+   SCIP_Real             endtime,            /**< end of the integration interval */
+   SCIP_Bool             primal              /**< integrate the primal (TRUE) or the dual (FALSE) bound? */
+   )
+{
+   SCIP_Real result = 0.0;
+   SCIP_Real prevtime = 0.0;
+   SCIP_Real prevgap = 1.0;
+
+   for( size_t k = 0; k < samples_.size(); k++ )
+   {
+      SCIP_Real time = MIN(samples_[k].time, endtime);
+      result += prevgap * MAX(0.0, time - prevtime);
+      prevtime = MAX(prevtime, time);
+      prevgap = gapFunction(scip, primal ? samples_[k].primal : samples_[k].dual, ref);
+   }
+   result += prevgap * MAX(0.0, endtime - prevtime);
+
+   return result;
+}
@@ -0,0 +1,91 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   event_trace.h
+ * @brief  event handler that traces primal and dual bounds over time
+ * @author Liding Xu
+ *
+ * The trace is written as JSON lines. A line is written whenever a new incumbent is found, whenever the dual bound
+ * improves, and when no line has been written for the given interval. At the end of the solve, the primal and the
+ * dual integral are computed from the trace and written as a final summary line.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_EVENT_TRACE_H__
+#define __SCIP_EVENT_TRACE_H__
+
+#include <stdio.h>
+#include <vector>
+#include "objscip/objscip.h"
+
+
+/** event handler that records a bound trace of the solving process */
+class EventhdlrTrace : public scip::ObjEventhdlr
+{
+public:
+   /** default constructor */
+   EventhdlrTrace(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~EventhdlrTrace()
+   {
+   }
+
+   /** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_EVENTINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_EVENTEXITSOL(scip_exitsol);
+
+   /** execution method of event handler */
+   virtual SCIP_DECL_EVENTEXEC(scip_exec);
+
+private:
+   /** one point of the trace */
+   struct Sample
+   {
+      SCIP_Real          time;               /**< solving time */
+      SCIP_Real          primal;             /**< primal bound */
+      SCIP_Real          dual;               /**< dual bound */
+   };
+
+   /** records the current bounds and writes them with the given event name */
+   void record(
+      SCIP*              scip,               /**< SCIP data structure */
+      const char*        eventname           /**< name of the event that triggered the record */
+      );
+
+   /** computes the integral of the gap between a bound and the reference value over the trace */
+   SCIP_Real integral(
+      SCIP*              scip,               /**< SCIP data structure */
+      SCIP_Real          ref,                /**< reference objective value */
+      SCIP_Real          endtime,            /**< end of the integration interval */
+      SCIP_Bool          primal              /**< integrate the primal (TRUE) or the dual (FALSE) bound? */
+      );
+
+   char*                 filename_;          /**< name of the trace file, or empty to disable the trace */
+   SCIP_Real             interval_;          /**< maximal time between two records */
+   SCIP_Real             refvalue_;          /**< reference objective value for the integrals, or infinity */
+   FILE*                 file_;              /**< trace file */
+   std::vector<Sample>   samples_;           /**< recorded trace */
+   SCIP_Real             lastlowerbound_;    /**< global lower bound (transformed space) at the last check */
+   SCIP_Real             lasttime_;          /**< solving time of the last record */
+};/*lint !e1712*/
+
+
+#endif
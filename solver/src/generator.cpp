@@ -0,0 +1,148 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   generator.cpp
+ * @brief  generator of synthetic D-optimal design instances
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "generator.h"
+#include "textwriter.h"
+
+using namespace std;
+
+/** writes the header line of an instance */
+static
+void writeHeader(
+   TextWriter&           writer,             /**< writer */
+   int                   numvars,            /**< the number of items */
+   int                   dim,                /**< the problem dimension */
+   int                   card,               /**< the cardinality */
+   double                epsilon             /**< regularization epsilon */
+   )
+{
+   char str[128];
+   int len = snprintf(str, sizeof(str), "%d %d %d %g\n", numvars, dim, card, epsilon);
+   writer.put(str, (size_t) len);
+}
+
+
+/** writes a normal_* instance; returns false if the file cannot be written */
+bool writeNormalInstance(
+   const string&         filename,           /**< name of the file to write */
+   int                   numvars,            /**< the number of items */
+   int                   dim,                /**< the problem dimension */
+   int                   card,               /**< the cardinality */
+   double                epsilon,            /**< regularization epsilon */
+   unsigned long long    seed                /**< random seed */
+   )
+{
+   TextWriter writer(filename);
+   if( !writer.ok() )
+      return false;
+
+   mt19937_64 rng(seed);
+   normal_distribution<double> gauss(0.0, 1.0 / sqrt((double) numvars));
+
+   writeHeader(writer, numvars, dim, card, epsilon);
+   for( int i = 0; i < numvars; i++ )
+   {
+      for( int j = 0; j < dim; j++ )
+         writer.putReal(gauss(rng));
+      writer.put("\n", 1);
+   }
+
+   return writer.close();
+}
+
+
+/** writes a block2_* instance on t treatments with numedges comparisons; returns false if the file cannot be written */
+bool writeBlockInstance(
+   const string&         filename,           /**< name of the file to write */
+   int                   t,                  /**< the number of treatments, dim = t - 1 */
+   int                   numedges,           /**< the number of comparisons (items) */
+   int                   card,               /**< the cardinality */
+   double                epsilon,            /**< regularization epsilon */
+   unsigned long long    seed                /**< random seed */
+   )
+{
+   if( t < 2 || numedges < 1 )
+      return false;
+
+   TextWriter writer(filename);
+   if( !writer.ok() )
+      return false;
+
+   mt19937_64 rng(seed);
+   long long npairs = (long long) t * (t - 1) / 2;
+   int dim = t - 1;
+
+   /* choose the pairs: all pairs in lexicographic order, or a random subset of them kept in that order */
+   vector<pair<int, int>> edges;
+   edges.reserve((size_t) numedges);
+   if( numedges < npairs )
+   {
+      /* Floyd's algorithm for a uniform subset of the pair indices */
+      unordered_set<long long> chosen;
+      for( long long r = npairs - numedges; r < npairs; r++ )
+      {
+         long long k = uniform_int_distribution<long long>(0, r)(rng);
+         chosen.insert(chosen.count(k) ? r : k);
+      }
+      long long k = 0;
+      for( int u = 0; u < t; u++ )
+         for( int v = u + 1; v < t; v++, k++ )
+            if( chosen.count(k) )
+               edges.push_back(make_pair(u, v));
+   }
+   else
+   {
+      for( int u = 0; u < t; u++ )
+         for( int v = u + 1; v < t; v++ )
+            edges.push_back(make_pair(u, v));
+
+      /* repeated comparisons on random pairs */
+      uniform_int_distribution<int> node(0, t - 1);
+      while( (int) edges.size() < numedges )
+      {
+         int u = node(rng);
+         int v = node(rng);
+         if( u != v )
+            edges.push_back(make_pair(min(u, v), max(u, v)));
+      }
+   }
+
+   writeHeader(writer, numedges, dim, card, epsilon);
+   string row;
+   for( size_t e = 0; e < edges.size(); e++ )
+   {
+      row.clear();
+      for( int j = 0; j < dim; j++ )
+         row += j == edges[e].first ? "1 " : (j == edges[e].second ? "-1 " : "0 ");
+      row += "\n";
+      writer.put(row.data(), row.size());
+   }
+
+   return writer.close();
+}
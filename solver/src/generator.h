@@ -0,0 +1,57 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   generator.h
+ * @brief  generator of synthetic D-optimal design instances
+ * @author Liding Xu
+ *
+ * Two families are generated, as by data.py:
+ *  - normal: numvars rows with i.i.d. N(0, 1/numvars) entries in dimension dim;
+ *  - block2: pairwise comparisons of t treatments, one row e_u - e_v per edge {u,v} of a graph on t nodes,
+ *    with the coordinate of the last treatment dropped, so dim = t - 1. If the number of edges is at least
+ *    t(t-1)/2, all pairs are listed in the order of data.py and further edges are drawn at random (repeated
+ *    comparisons); otherwise the edges are a uniform random subset of all pairs.
+ *
+ * The rows are written directly to the file, so instances with millions of rows do not need to be kept in memory.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __DOPT_GENERATOR_H__
+#define __DOPT_GENERATOR_H__
+
+#include <string>
+
+/** writes a normal_* instance; returns false if the file cannot be written */
+bool writeNormalInstance(
+   const std::string&    filename,           /**< name of the file to write */
+   int                   numvars,            /**< the number of items */
+   int                   dim,                /**< the problem dimension */
+   int                   card,               /**< the cardinality */
+   double                epsilon,            /**< regularization epsilon */
+   unsigned long long    seed                /**< random seed */
+   );
+
+/** writes a block2_* instance on t treatments with numedges comparisons; returns false if the file cannot be written */
+bool writeBlockInstance(
+   const std::string&    filename,           /**< name of the file to write */
+   int                   t,                  /**< the number of treatments, dim = t - 1 */
+   int                   numedges,           /**< the number of comparisons (items) */
+   int                   card,               /**< the cardinality */
+   double                epsilon,            /**< regularization epsilon */
+   unsigned long long    seed                /**< random seed */
+   );
+
+#endif
@@ -0,0 +1,368 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   heur_designlns.cpp
+ * @brief  large neighborhood search heuristic that exchanges points of the design of the incumbent
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <algorithm>
+#include <utility>
+
+#include "heur_designlns.h"
+#include "probdata.h"
+#include "linalg.h"
+#include "table_profile.h"
+
+using namespace scip;
+using namespace std;
+
+#define HEUR_NAME              "designlns"
+#define HEUR_DESC              "large neighborhood search on the exchanges of points of the incumbent design"
+#define HEUR_DISPCHAR          'X'
+#define HEUR_PRIORITY          -1100500
+#define HEUR_FREQ              20
+#define HEUR_FREQOFS           0
+#define HEUR_MAXDEPTH          -1
+#define HEUR_TIMING            SCIP_HEURTIMING_AFTERLPNODE
+#define HEUR_USESSUBSCIP       TRUE          /**< does the heuristic use a secondary SCIP instance? */
+
+#define DEFAULT_MINFREE        4             /**< minimal number of free points */
+#define DEFAULT_MAXFREE        60            /**< maximal number of free points */
+#define DEFAULT_INITFREE       12            /**< number of free points of the first call */
+#define DEFAULT_GROWFACTOR     1.5           /**< factor by which the number of free points grows or shrinks */
+#define DEFAULT_NODESOFS       500           /**< number of nodes added to the node limit of the sub-SCIP */
+#define DEFAULT_NODESQUOT      0.1           /**< node limit of the sub-SCIP as fraction of the nodes of the main search */
+#define DEFAULT_MINNODES       50            /**< minimal node limit of the sub-SCIP */
+#define DEFAULT_MAXNODES       5000          /**< maximal node limit of the sub-SCIP */
+#define DEFAULT_MINIMPROVE     0.01          /**< fraction of the gap by which the sub-SCIP must improve the incumbent */
+#define DEFAULT_LPWEIGHT       1.0           /**< weight of the LP values in the scores of the points */
+
+
+/** default constructor */
+HeurDesignLns::HeurDesignLns(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjHeur(scip, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ, HEUR_FREQOFS, HEUR_MAXDEPTH,
+      HEUR_TIMING, HEUR_USESSUBSCIP),
+     minfree_(DEFAULT_MINFREE),
+     maxfree_(DEFAULT_MAXFREE),
+     initfree_(DEFAULT_INITFREE),
+     growfactor_(DEFAULT_GROWFACTOR),
+     nodesofs_(DEFAULT_NODESOFS),
+     nodesquot_(DEFAULT_NODESQUOT),
+     minnodes_(DEFAULT_MINNODES),
+     maxnodes_(DEFAULT_MAXNODES),
+     minimprove_(DEFAULT_MINIMPROVE),
+     lpweight_(DEFAULT_LPWEIGHT),
+     nfree_(DEFAULT_INITFREE),
+     lastsol_(-1),
+     lastnfree_(0),
+     usednodes_(0),
+     ncalls_(0),
+     nsuccess_(0)
+{
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "heuristics/" HEUR_NAME "/minfree",
+         "minimal number of free points of the neighborhood",
+         &minfree_, FALSE, DEFAULT_MINFREE, 1, INT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "heuristics/" HEUR_NAME "/maxfree",
+         "maximal number of free points of the neighborhood",
+         &maxfree_, FALSE, DEFAULT_MAXFREE, 1, INT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "heuristics/" HEUR_NAME "/initfree",
+         "number of free points of the neighborhood of the first call",
+         &initfree_, FALSE, DEFAULT_INITFREE, 1, INT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "heuristics/" HEUR_NAME "/growfactor",
+         "factor by which the neighborhood grows after a complete search and shrinks after a search stopped by the node limit",
+         &growfactor_, FALSE, DEFAULT_GROWFACTOR, 1.0, 100.0, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddLongintParam(scip, "heuristics/" HEUR_NAME "/nodesofs",
+         "number of nodes added to the node limit of the sub-SCIP",
+         &nodesofs_, FALSE, DEFAULT_NODESOFS, 0LL, SCIP_LONGINT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "heuristics/" HEUR_NAME "/nodesquot",
+         "node limit of the sub-SCIP as fraction of the nodes of the main search",
+         &nodesquot_, FALSE, DEFAULT_NODESQUOT, 0.0, 1.0, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddLongintParam(scip, "heuristics/" HEUR_NAME "/minnodes",
+         "minimal node limit of the sub-SCIP, below which the heuristic does not run",
+         &minnodes_, FALSE, DEFAULT_MINNODES, 0LL, SCIP_LONGINT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddLongintParam(scip, "heuristics/" HEUR_NAME "/maxnodes",
+         "maximal node limit of the sub-SCIP",
+         &maxnodes_, FALSE, DEFAULT_MAXNODES, 0LL, SCIP_LONGINT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "heuristics/" HEUR_NAME "/minimprove",
+         "fraction of the gap by which a design of the sub-SCIP must improve the incumbent",
+         &minimprove_, FALSE, DEFAULT_MINIMPROVE, 0.0, 1.0, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "heuristics/" HEUR_NAME "/lpweight",
+         "weight of the distance of the LP value of a binary from the incumbent in the score of a point",
+         &lpweight_, FALSE, DEFAULT_LPWEIGHT, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+}
+
+
+/** selects the free points of the neighborhood of the incumbent design: the points of the design with the smallest
+ *  loss log(1 - h_i) of log det M on removal and the other points with the largest gain log(1 + h_i) on addition,
+ *  where h_i = a_i^T M^-1 a_i; returns FALSE if the information matrix of the design is singular
+ */
+static
+bool selectFreePoints(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const ProbData*       probdata,           /**< problem data */
+   const vector<char>&   indesign,           /**< for each point, is it in the incumbent design? */
+   int                   nfree,              /**< number of points to free */
+   SCIP_Real             lpweight,           /**< weight of the LP values in the scores */
+   vector<char>&         isfree              /**< vector to store for each point whether it is free */
+   )
+{
+   int numvars = probdata->numvars;
+   int dim = probdata->dim;
+   SCIP_Real eps2 = probdata->epsilon * probdata->epsilon;
+
+   vector<int> design;
+   for( int i = 0; i < numvars; i++ )
+   {
+      if( indesign[i] )
+         design.push_back(i);
+   }
+   vector<SCIP_Real> L;
+   informationMatrix(probdata->A, design, eps2, L);
+   if( !probdata->kernel.factor(dim, L.data()) )
+      return false;
+
+   SCIP_Bool haslp = SCIPhasCurrentNodeLP(scip) && SCIPgetLPSolstat(scip) == SCIP_LPSOLSTAT_OPTIMAL;
+
+   /* scores of the points whose binaries are not fixed globally, larger is more promising */
+   vector<pair<SCIP_Real, int>> removals;
+   vector<pair<SCIP_Real, int>> additions;
+   vector<SCIP_Real> x(dim);
+   for( int i = 0; i < numvars; i++ )
+   {
+      SCIP_VAR* var = probdata->bin_vars[i];
+      if( var == NULL || SCIPvarGetLbGlobal(var) > 0.5 || SCIPvarGetUbGlobal(var) < 0.5 )
+         continue;
+
+      for( int j = 0; j < dim; j++ )
+         x[j] = probdata->A[j][i];
+      probdata->kernel.solveLower(dim, L.data(), x.data());
+      SCIP_Real h = 0.0;
+      for( int j = 0; j < dim; j++ )
+         h += x[j] * x[j];
+
+      SCIP_Real lpdist = haslp ? REALABS(SCIPgetSolVal(scip, NULL, var) - (indesign[i] ? 1.0 : 0.0)) : 0.0;
+      if( indesign[i] )
+         removals.push_back(make_pair(log1p(-MIN(h, 1.0 - 1e-12)) + lpweight * lpdist, i));
+      else
+         additions.push_back(make_pair(log1p(h) + lpweight * lpdist, i));
+   }
+
+   /* half of the free points from each side, the rest from the other side if one side is short */
+   int nremove = MIN(nfree / 2, (int) removals.size());
+   int nadd = MIN(nfree - nremove, (int) additions.size());
+   nremove = MIN(nfree - nadd, (int) removals.size());
+
+   isfree.assign(numvars, 0);
+   partial_sort(removals.begin(), removals.begin() + nremove, removals.end(), greater<pair<SCIP_Real, int>>());
+   partial_sort(additions.begin(), additions.begin() + nadd, additions.end(), greater<pair<SCIP_Real, int>>());
+   for( int k = 0; k < nremove; k++ )
+      isfree[removals[k].second] = 1;
+   for( int k = 0; k < nadd; k++ )
+      isfree[additions[k].second] = 1;
+
+   return true;
+}
+
+
+/** creates the sub-SCIP with the fixings, solves it and transfers its solutions */
+static
+SCIP_RETCODE solveSubscip(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP*                 subscip,            /**< the sub-SCIP */
+   SCIP_HEUR*            heur,               /**< the heuristic */
+   vector<SCIP_VAR*>&    fixedvars,          /**< the fixed binaries */
+   vector<SCIP_Real>&    fixedvals,          /**< the values of the fixed binaries */
+   SCIP_Longint          nnodes,             /**< node limit */
+   SCIP_Real             cutoff,             /**< objective limit */
+   SCIP_Bool*            success,            /**< pointer to store whether a solution was stored, FALSE if the copy is
+                                              *   not valid */
+   SCIP_Longint*         nsubnodes,          /**< pointer to store the nodes of the sub-SCIP */
+   SCIP_STATUS*          status              /**< pointer to store the status of the sub-SCIP */
+   )
+{
+   int nvars = SCIPgetNVars(scip);
+   SCIP_VAR** vars = SCIPgetVars(scip);
+
+   SCIP_HASHMAP* varmap;
+   SCIP_Bool valid;
+   SCIP_CALL( SCIPhashmapCreate(&varmap, SCIPblkmem(subscip), nvars) );
+   SCIP_CALL( SCIPcopyConsCompression(scip, subscip, varmap, NULL, HEUR_NAME, fixedvars.data(), fixedvals.data(),
+         (int) fixedvars.size(), TRUE, FALSE, FALSE, TRUE, &valid) );
+   vector<SCIP_VAR*> subvars(nvars);
+   for( int k = 0; k < nvars; k++ )
+      subvars[k] = (SCIP_VAR*) SCIPhashmapGetImage(varmap, vars[k]);
+   SCIPhashmapFree(&varmap);
+
+   /* a copy that is not valid, e.g., since a plugin of a constraint is not copied, may have designs that are not
+    * feasible in the problem, so it is not solved
+    */
+   if( !valid )
+   {
+      SCIPdebugMsg(scip, "designlns: the copy of the problem is not valid\n");
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( SCIPsetBoolParam(subscip, "misc/catchctrlc", FALSE) );
+   SCIP_CALL( SCIPsetIntParam(subscip, "display/verblevel", 0) );
+   SCIP_CALL( SCIPsetSubscipsOff(subscip, TRUE) );
+   SCIP_CALL( SCIPcopyLimits(scip, subscip) );
+   SCIP_CALL( SCIPsetLongintParam(subscip, "limits/nodes", nnodes) );
+   SCIP_CALL( SCIPsetPresolving(subscip, SCIP_PARAMSETTING_FAST, TRUE) );
+   SCIP_CALL( SCIPsetHeuristics(subscip, SCIP_PARAMSETTING_FAST, TRUE) );
+   SCIP_CALL( SCIPsetObjlimit(subscip, cutoff) );
+
+   SCIP_CALL( SCIPsolve(subscip) );
+
+   SCIP_CALL( SCIPtranslateSubSols(scip, subscip, heur, subvars.data(), success, NULL) );
+   *nsubnodes = SCIPgetNNodes(subscip);
+   *status = SCIPgetStatus(subscip);
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+SCIP_DECL_HEURINITSOL(HeurDesignLns::scip_initsol)
+{
+   nfree_ = MAX(MIN(initfree_, maxfree_), minfree_);
+   lastsol_ = -1;
+   lastnfree_ = 0;
+   usednodes_ = 0;
+   ncalls_ = 0;
+   nsuccess_ = 0;
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of primal heuristic (called before branch and bound process data is freed) */
+SCIP_DECL_HEUREXITSOL(HeurDesignLns::scip_exitsol)
+{
+   if( ncalls_ > 0 )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+         "designlns heuristic: %d calls, %d improvements, %lld nodes, neighborhood of %d points\n",
+         ncalls_, nsuccess_, usednodes_, nfree_);
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** execution method of primal heuristic */
+SCIP_DECL_HEUREXEC(HeurDesignLns::scip_exec)
+{
+   DOPT_PROFILE(scip, "designlns/exec");
+   *result = SCIP_DIDNOTRUN;
+
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   SCIP_SOL* incumbent = SCIPgetBestSol(scip);
+   if( probdata == NULL || incumbent == NULL )
+      return SCIP_OKAY;
+
+   /* the neighborhood of this size around the incumbent was searched in the last call */
+   if( SCIPsolGetIndex(incumbent) == lastsol_ && nfree_ == lastnfree_ )
+      return SCIP_OKAY;
+
+   /* the node limit grows with the main search and the success rate of the heuristic */
+   SCIP_Longint nnodes = (SCIP_Longint) (nodesquot_ * (nsuccess_ + 1.0) / (ncalls_ + 1.0) * SCIPgetNNodes(scip))
+      + nodesofs_ - usednodes_;
+   nnodes = MIN(nnodes, maxnodes_);
+   if( nnodes < minnodes_ )
+      return SCIP_OKAY;
+
+   SCIP_Bool success;
+   SCIP_CALL( SCIPcheckCopyLimits(scip, &success) );
+   if( !success )
+      return SCIP_OKAY;
+
+   vector<char> indesign(probdata->numvars, 0);
+   for( int i = 0; i < probdata->numvars; i++ )
+   {
+      if( probdata->bin_vars[i] != NULL && SCIPgetSolVal(scip, incumbent, probdata->bin_vars[i]) > 0.5 )
+         indesign[i] = 1;
+   }
+
+   vector<char> isfree;
+   if( !selectFreePoints(scip, probdata, indesign, nfree_, lpweight_, isfree) )
+      return SCIP_OKAY;
+
+   vector<SCIP_VAR*> fixedvars;
+   vector<SCIP_Real> fixedvals;
+   int nfree = 0;
+   for( int i = 0; i < probdata->numvars; i++ )
+   {
+      if( probdata->bin_vars[i] == NULL )
+         continue;
+      if( isfree[i] )
+         nfree++;
+      else
+      {
+         fixedvars.push_back(probdata->bin_vars[i]);
+         fixedvals.push_back(indesign[i] ? 1.0 : 0.0);
+      }
+   }
+   if( nfree == 0 )
+      return SCIP_OKAY;
+
+   /* a design of the sub-SCIP must close at least minimprove of the gap */
+   SCIP_Real upperbound = SCIPgetUpperbound(scip);
+   SCIP_Real lowerbound = SCIPgetLowerbound(scip);
+   SCIP_Real cutoff;
+   if( SCIPisInfinity(scip, -lowerbound) )
+      cutoff = upperbound - minimprove_ * REALABS(upperbound);
+   else
+      cutoff = (1.0 - minimprove_) * upperbound + minimprove_ * lowerbound;
+
+   *result = SCIP_DIDNOTFIND;
+   lastsol_ = SCIPsolGetIndex(incumbent);
+   lastnfree_ = nfree_;
+
+   SCIP* subscip;
+   SCIP_Longint nsubnodes = 0;
+   SCIP_STATUS status = SCIP_STATUS_UNKNOWN;
+   success = FALSE;
+   SCIP_CALL( SCIPcreate(&subscip) );
+   SCIP_RETCODE retcode = solveSubscip(scip, subscip, heur, fixedvars, fixedvals, nnodes, cutoff, &success,
+      &nsubnodes, &status);
+   SCIP_CALL( SCIPfree(&subscip) );
+   SCIP_CALL( retcode );
+
+   ncalls_++;
+   usednodes_ += nsubnodes;
+
+   /* the neighborhood grows if it has no better design and shrinks if the node limit was too small to search it */
+   if( success )
+   {
+      nsuccess_++;
+      *result = SCIP_FOUNDSOL;
+   }
+   else if( status == SCIP_STATUS_OPTIMAL || status == SCIP_STATUS_INFEASIBLE || status == SCIP_STATUS_INFORUNBD )
+      nfree_ = MIN((int) ceil(nfree_ * growfactor_), maxfree_);
+   else if( status == SCIP_STATUS_NODELIMIT )
+      nfree_ = MAX((int) floor(nfree_ / growfactor_), minfree_);
+
+   SCIPdebugMsg(scip, "designlns: %d free points, %lld of %lld nodes, status %d, %s, next neighborhood %d points\n",
+      nfree, nsubnodes, nnodes, (int) status, success ? "improved" : "no improvement", nfree_);
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,86 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   heur_designlns.h
+ * @brief  large neighborhood search heuristic that exchanges points of the design of the incumbent
+ * @author Liding Xu
+ *
+ * The heuristic frees k points and fixes the binaries of all other points to their values in the incumbent, so the
+ * designs of the sub-SCIP are those within Hamming distance k of the incumbent design. Half of the free points are
+ * points of the design whose removal decreases log det M the least, i.e., with the smallest leverage
+ * a_i^T M^-1 a_i, the other half are points outside of the design whose addition increases it the most, i.e., with
+ * the largest leverage; if the LP solution of the node is available, the distance of a binary from its value in the
+ * incumbent is added to the score of a point. The sub-SCIP is solved with a node limit and an objective limit that
+ * requires an improvement of "minimprove" of the gap.
+ *
+ * The neighborhood size k adapts to the outcome of the calls: it grows by the factor "growfactor" when the sub-SCIP
+ * was solved without finding a better design, since the neighborhood contains none, and shrinks by this factor when
+ * the node limit stopped it without a better design. The node limit grows with the nodes of the main search and the
+ * success rate of the heuristic, as for the large neighborhood search heuristics of SCIP. The heuristic is not copied
+ * to sub-SCIPs.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_HEUR_DESIGNLNS_H__
+#define __SCIP_HEUR_DESIGNLNS_H__
+
+#include <vector>
+#include "objscip/objscip.h"
+
+
+/** large neighborhood search heuristic on the exchanges of points of the incumbent design */
+class HeurDesignLns : public scip::ObjHeur
+{
+public:
+   /** default constructor */
+   HeurDesignLns(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~HeurDesignLns()
+   {
+   }
+
+   /** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_HEURINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of primal heuristic (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_HEUREXITSOL(scip_exitsol);
+
+   /** execution method of primal heuristic */
+   virtual SCIP_DECL_HEUREXEC(scip_exec);
+
+private:
+   int                   minfree_;           /**< minimal number of free points */
+   int                   maxfree_;           /**< maximal number of free points */
+   int                   initfree_;          /**< number of free points of the first call */
+   SCIP_Real             growfactor_;        /**< factor by which the number of free points grows or shrinks */
+   SCIP_Longint          nodesofs_;          /**< number of nodes added to the node limit of the sub-SCIP */
+   SCIP_Real             nodesquot_;         /**< node limit of the sub-SCIP as fraction of the nodes of the main search */
+   SCIP_Longint          minnodes_;          /**< minimal node limit of the sub-SCIP */
+   SCIP_Longint          maxnodes_;          /**< maximal node limit of the sub-SCIP */
+   SCIP_Real             minimprove_;        /**< fraction of the gap by which the sub-SCIP must improve the incumbent */
+   SCIP_Real             lpweight_;          /**< weight of the LP values in the scores of the points */
+   int                   nfree_;             /**< current number of free points */
+   int                   lastsol_;           /**< index of the incumbent of the last call, -1 before the first call */
+   int                   lastnfree_;         /**< number of free points of the last call */
+   SCIP_Longint          usednodes_;         /**< nodes of the sub-SCIPs in the current solve */
+   int                   ncalls_;            /**< number of sub-SCIPs solved in the current solve */
+   int                   nsuccess_;          /**< number of calls that found a better design in the current solve */
+};/*lint !e1712*/
+
+
+#endif
@@ -0,0 +1,444 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   heur_designround.cpp
+ * @brief  rounding heuristic that turns the LP values of the binaries into a design of card points
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <algorithm>
+
+#include "heur_designround.h"
+#include "probdata.h"
+#include "linalg.h"
+#include "table_profile.h"
+
+using namespace scip;
+using namespace std;
+
+#define HEUR_NAME              "designround"
+#define HEUR_DESC              "rounding of the LP values of the binaries to designs of card points"
+#define HEUR_DISPCHAR          'W'
+#define HEUR_PRIORITY          -1100
+#define HEUR_FREQ              1
+#define HEUR_FREQOFS           0
+#define HEUR_MAXDEPTH          -1
+#define HEUR_TIMING            SCIP_HEURTIMING_AFTERLPNODE
+#define HEUR_USESSUBSCIP       FALSE         /**< does the heuristic use a secondary SCIP instance? */
+
+#define DEFAULT_NRANDOM        4             /**< number of randomized pipage roundings per call */
+#define DEFAULT_MAXSWAPS       3             /**< maximal number of exchanges of the best candidate */
+#define DEFAULT_RANDSEED       71            /**< initial seed of the random number generator */
+
+#define PIPAGE_EPS             1e-9          /**< weights this close to 0 or 1 are integral in the pipage rounding */
+#define MINIMPROVE             1e-9          /**< minimal relative increase of the determinant by an exchange */
+
+
+/** default constructor */
+HeurDesignRound::HeurDesignRound(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjHeur(scip, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ, HEUR_FREQOFS, HEUR_MAXDEPTH,
+      HEUR_TIMING, HEUR_USESSUBSCIP),
+     nrandom_(DEFAULT_NRANDOM),
+     maxswaps_(DEFAULT_MAXSWAPS),
+     randnumgen_(NULL),
+     clock_(NULL),
+     ncalls_(0),
+     ncands_(0),
+     nsols_(0),
+     corelogdet_(0.0),
+     ncore_(0)
+{
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "heuristics/" HEUR_NAME "/nrandom",
+         "number of randomized pipage roundings per call, besides the rounding to the card largest LP values",
+         &nrandom_, FALSE, DEFAULT_NRANDOM, 0, INT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "heuristics/" HEUR_NAME "/maxswaps",
+         "maximal number of exchanges of a point that improve the best rounded design",
+         &maxswaps_, FALSE, DEFAULT_MAXSWAPS, 0, INT_MAX, NULL, NULL) );
+}
+
+
+/** rounds a continuous design in place by randomized pipage rounding: each step moves weight between the carried
+ *  fractional point and the next one until one of them is 0 or 1, up with the probability that keeps the expected
+ *  weights, so the sum of the weights is kept and each point ends at 1 with the probability of its weight
+ */
+static
+void pipageRound(
+   SCIP_RANDNUMGEN*      randnumgen,         /**< random number generator */
+   const vector<int>&    points,             /**< the points to round */
+   vector<SCIP_Real>&    w                   /**< the weights of the points, rounded on output except at most one */
+   )
+{
+   int carry = -1;
+   for( size_t k = 0; k < points.size(); k++ )
+   {
+      int i = points[k];
+      if( w[i] <= PIPAGE_EPS || w[i] >= 1.0 - PIPAGE_EPS )
+         continue;
+      if( carry < 0 )
+      {
+         carry = i;
+         continue;
+      }
+
+      /* the carried point rises by up or falls by down, and point i moves the other way */
+      SCIP_Real up = MIN(1.0 - w[carry], w[i]);
+      SCIP_Real down = MIN(w[carry], 1.0 - w[i]);
+      if( SCIPrandomGetReal(randnumgen, 0.0, up + down) < down )
+      {
+         w[carry] += up;
+         w[i] -= up;
+      }
+      else
+      {
+         w[carry] -= down;
+         w[i] += down;
+      }
+
+      if( w[carry] <= PIPAGE_EPS || w[carry] >= 1.0 - PIPAGE_EPS )
+         carry = (w[i] > PIPAGE_EPS && w[i] < 1.0 - PIPAGE_EPS) ? i : -1;
+   }
+}
+
+
+/** computes the log-determinant of a design that contains the core points and leaves its inverse information
+ *  matrix in minv_; returns false if the matrix is singular
+ */
+bool HeurDesignRound::evaluate(
+   const ProbData*       probdata,           /**< problem data */
+   const vector<int>&    design,             /**< the points of the design */
+   SCIP_Real&            logdet              /**< pointer to store the log-determinant */
+   )
+{
+   int dim = probdata->dim;
+
+   minv_ = coreinv_;
+   logdet = corelogdet_;
+   for( size_t k = 0; k < design.size(); k++ )
+   {
+      int i = design[k];
+      if( incore_[i] )
+         continue;
+      for( int j = 0; j < dim; j++ )
+         a_[j] = probdata->A[j][i];
+
+      /* matrix determinant lemma: det(M + a a^T) = det(M) (1 + a^T M^-1 a) */
+      SCIP_Real q = probdata->kernel.rankOne(dim, minv_.data(), a_.data(), 1.0, u_.data());
+      if( !(q > -1.0) )
+         return false;
+      logdet += log1p(q);
+   }
+   ncands_++;
+
+   return true;
+}
+
+
+/** improves a design by at most maxswaps_ best exchanges of a point of the design with another point, starting
+ *  from its inverse information matrix in minv_
+ *
+ *  Exchanging the point i of the design for the point j multiplies the determinant by
+ *  (1 - d_i) (1 + d_j) + d_ij^2, where d_ij = a_i^T M^-1 a_j and d_i = d_ii (Fedorov). The core points stay.
+ */
+void HeurDesignRound::exchange(
+   const ProbData*       probdata,           /**< problem data */
+   vector<int>&          design,             /**< the design, replaced by the improved design */
+   SCIP_Real&            logdet              /**< its log-determinant, replaced by the improved one */
+   )
+{
+   int dim = probdata->dim;
+   int npoints = (int) order_.size();
+
+   points_.resize((size_t) npoints * dim);
+   U_.resize((size_t) npoints * dim);
+   for( int k = 0; k < npoints; k++ )
+   {
+      for( int j = 0; j < dim; j++ )
+         points_[(size_t) k * dim + j] = probdata->A[j][order_[k]];
+   }
+
+   indesign_.assign(probdata->numvars, 0);
+   for( size_t k = 0; k < design.size(); k++ )
+      indesign_[design[k]] = 1;
+
+   vector<SCIP_Real> d(npoints);
+   for( int s = 0; s < maxswaps_; s++ )
+   {
+      for( int k = 0; k < npoints; k++ )
+      {
+         const SCIP_Real* a = &points_[(size_t) k * dim];
+         SCIP_Real* u = &U_[(size_t) k * dim];
+         SCIP_Real dk = 0.0;
+         for( int p = 0; p < dim; p++ )
+         {
+            const SCIP_Real* row = &minv_[(size_t) p * dim];
+            SCIP_Real sum = 0.0;
+            for( int q = 0; q < dim; q++ )
+               sum += row[q] * a[q];
+            u[p] = sum;
+            dk += a[p] * sum;
+         }
+         d[k] = dk;
+      }
+
+      SCIP_Real bestratio = 1.0 + MINIMPROVE;
+      int bestout = -1;
+      int bestin = -1;
+      for( int k1 = 0; k1 < npoints; k1++ )
+      {
+         int i = order_[k1];
+         if( !indesign_[i] || incore_[i] )
+            continue;
+         const SCIP_Real* u = &U_[(size_t) k1 * dim];
+         for( int k2 = 0; k2 < npoints; k2++ )
+         {
+            if( indesign_[order_[k2]] )
+               continue;
+            const SCIP_Real* a = &points_[(size_t) k2 * dim];
+            SCIP_Real dij = 0.0;
+            for( int p = 0; p < dim; p++ )
+               dij += u[p] * a[p];
+            SCIP_Real ratio = (1.0 - d[k1]) * (1.0 + d[k2]) + dij * dij;
+            if( ratio > bestratio )
+            {
+               bestratio = ratio;
+               bestout = k1;
+               bestin = k2;
+            }
+         }
+      }
+      if( bestout < 0 )
+         break;
+
+      /* M + a_j a_j^T - a_i a_i^T stays positive definite, since its determinant is positive */
+      probdata->kernel.rankOne(dim, minv_.data(), &points_[(size_t) bestin * dim], 1.0, u_.data());
+      probdata->kernel.rankOne(dim, minv_.data(), &points_[(size_t) bestout * dim], -1.0, u_.data());
+      logdet += log(bestratio);
+      indesign_[order_[bestout]] = 0;
+      indesign_[order_[bestin]] = 1;
+      replace(design.begin(), design.end(), order_[bestout], order_[bestin]);
+   }
+}
+
+
+/** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+SCIP_DECL_HEURINITSOL(HeurDesignRound::scip_initsol)
+{
+   SCIP_CALL( SCIPcreateRandom(scip, &randnumgen_, DEFAULT_RANDSEED, TRUE) );
+   SCIP_CALL( SCIPcreateClock(scip, &clock_) );
+   ncalls_ = 0;
+   ncands_ = 0;
+   nsols_ = 0;
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of primal heuristic (called before branch and bound process data is freed) */
+SCIP_DECL_HEUREXITSOL(HeurDesignRound::scip_exitsol)
+{
+   if( ncalls_ > 0 )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+         "designround heuristic: %d calls, %d candidate designs, %d solutions, %.3f ms per call\n",
+         ncalls_, ncands_, nsols_, 1000.0 * SCIPgetClockTime(scip, clock_) / ncalls_);
+   }
+
+   SCIPfreeRandom(scip, &randnumgen_);
+   SCIP_CALL( SCIPfreeClock(scip, &clock_) );
+
+   return SCIP_OKAY;
+}
+
+
+/** execution method of primal heuristic */
+SCIP_DECL_HEUREXEC(HeurDesignRound::scip_exec)
+{
+   DOPT_PROFILE(scip, "designround/exec");
+   *result = SCIP_DIDNOTRUN;
+
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( probdata == NULL || !probdata->has_cardcons || probdata->has_knapcons || probdata->epsilon <= 0.0 )
+      return SCIP_OKAY;
+   if( !SCIPhasCurrentNodeLP(scip) || SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL )
+      return SCIP_OKAY;
+
+   int numvars = probdata->numvars;
+   int dim = probdata->dim;
+   int size = (int) floor(probdata->card + 0.5);
+
+   /* the LP values of the points that are not fixed to 0, which are the eligible points */
+   lpvals_.assign(numvars, 0.0);
+   order_.clear();
+   for( int i = 0; i < numvars; i++ )
+   {
+      SCIP_VAR* var = probdata->bin_vars[i];
+      if( var == NULL || SCIPvarGetUbGlobal(var) < 0.5 )
+         continue;
+      SCIP_Real val = SCIPvarGetLbGlobal(var) > 0.5 ? 1.0 : SCIPgetSolVal(scip, NULL, var);
+      lpvals_[i] = MAX(MIN(val, 1.0), 0.0);
+      order_.push_back(i);
+   }
+   if( size <= 0 || size > (int) order_.size() )
+      return SCIP_OKAY;
+
+   *result = SCIP_DIDNOTFIND;
+   SCIP_CALL( SCIPstartClock(scip, clock_) );
+   ncalls_++;
+
+   const vector<SCIP_Real>& lpvals = lpvals_;
+   sort(order_.begin(), order_.end(), [&lpvals](int i1, int i2) {
+         return lpvals[i1] > lpvals[i2] || (lpvals[i1] == lpvals[i2] && i1 < i2); });
+
+   /* the core points at 1 are in every candidate: inverse of their information matrix, from its Cholesky factor L
+    * by M^-1 = L^-T L^-1
+    */
+   SCIP_Real feastol = SCIPfeastol(scip);
+   incore_.assign(numvars, 0);
+   ncore_ = 0;
+   while( ncore_ < size && lpvals_[order_[ncore_]] >= 1.0 - feastol )
+      incore_[order_[ncore_++]] = 1;
+   design_.assign(order_.begin(), order_.begin() + ncore_);
+   informationMatrix(probdata->A, design_, probdata->epsilon * probdata->epsilon, minv_);
+   if( !probdata->kernel.factor(dim, minv_.data()) )
+   {
+      SCIP_CALL( SCIPstopClock(scip, clock_) );
+      return SCIP_OKAY;
+   }
+   corelogdet_ = probdata->kernel.logdet(dim, minv_.data());
+
+   a_.resize(dim);
+   u_.resize(dim);
+   U_.assign((size_t) dim * dim, 0.0);
+   for( int k = 0; k < dim; k++ )
+   {
+      SCIP_Real* y = &U_[(size_t) k * dim];
+      y[k] = 1.0;
+      probdata->kernel.solveLower(dim, minv_.data(), y);
+   }
+   coreinv_.assign((size_t) dim * dim, 0.0);
+   for( int p = 0; p < dim; p++ )
+   {
+      for( int q = 0; q <= p; q++ )
+      {
+         SCIP_Real sum = 0.0;
+         for( int r = 0; r < dim; r++ )
+            sum += U_[(size_t) p * dim + r] * U_[(size_t) q * dim + r];
+         coreinv_[(size_t) p * dim + q] = sum;
+         coreinv_[(size_t) q * dim + p] = sum;
+      }
+   }
+
+   /* efficient rounding: the size points with the largest LP values */
+   SCIP_Real bestlogdet = -HUGE_VAL;
+   SCIP_Real logdet;
+   design_.assign(order_.begin(), order_.begin() + size);
+   if( evaluate(probdata, design_, logdet) )
+   {
+      bestlogdet = logdet;
+      best_ = design_;
+   }
+
+   /* randomized pipage roundings, whose number of points is corrected by the LP values if the weights do not sum up
+    * to size exactly
+    */
+   for( int r = 0; r < nrandom_; r++ )
+   {
+      weights_ = lpvals_;
+      for( int k = 0; k < ncore_; k++ )
+         weights_[order_[k]] = 1.0;
+      pipageRound(randnumgen_, order_, weights_);
+
+      indesign_.assign(numvars, 0);
+      int count = 0;
+      for( size_t k = 0; k < order_.size(); k++ )
+      {
+         if( weights_[order_[k]] > 0.5 )
+         {
+            indesign_[order_[k]] = 1;
+            count++;
+         }
+      }
+      for( int k = (int) order_.size() - 1; k >= 0 && count > size; k-- )
+      {
+         if( indesign_[order_[k]] && !incore_[order_[k]] )
+         {
+            indesign_[order_[k]] = 0;
+            count--;
+         }
+      }
+      for( size_t k = 0; k < order_.size() && count < size; k++ )
+      {
+         if( !indesign_[order_[k]] )
+         {
+            indesign_[order_[k]] = 1;
+            count++;
+         }
+      }
+
+      design_.clear();
+      for( size_t k = 0; k < order_.size(); k++ )
+      {
+         if( indesign_[order_[k]] )
+            design_.push_back(order_[k]);
+      }
+      if( evaluate(probdata, design_, logdet) && logdet > bestlogdet )
+      {
+         bestlogdet = logdet;
+         best_ = design_;
+      }
+   }
+
+   if( bestlogdet == -HUGE_VAL )
+   {
+      SCIP_CALL( SCIPstopClock(scip, clock_) );
+      return SCIP_OKAY;
+   }
+
+   /* exchanges from the inverse information matrix of the best candidate */
+   if( maxswaps_ > 0 )
+   {
+      SCIP_Bool valid = evaluate(probdata, best_, logdet);
+      assert(valid);
+      (void) valid;
+      exchange(probdata, best_, bestlogdet);
+   }
+
+   /* the lifted solution is only built for a design better than the incumbent; the objective is -obj_var */
+   SCIP_Real value = probdata->objectiveOfLogdet(bestlogdet);
+   if( SCIPisLT(scip, -value, SCIPgetPrimalbound(scip)) )
+   {
+      SCIP_SOL* sol;
+      SCIP_Bool stored;
+      SCIP_CALL( probdata->createDesignSol(scip, best_, &sol) );
+      SCIPsolSetHeur(sol, heur);
+      SCIP_CALL( SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored) );
+      if( stored )
+      {
+         nsols_++;
+         *result = SCIP_FOUNDSOL;
+      }
+      SCIPdebugMsg(scip, "designround: design with log-determinant %g, obj %g, %s\n", bestlogdet, value,
+         stored ? "stored" : "rejected");
+   }
+   SCIP_CALL( SCIPstopClock(scip, clock_) );
+
+   return SCIP_OKAY;
+}
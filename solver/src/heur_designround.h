@@ -0,0 +1,112 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   heur_designround.h
+ * @brief  rounding heuristic that turns the LP values of the binaries into a design of card points
+ * @author Liding Xu
+ *
+ * The LP values w of the binaries are a continuous design with sum_i w_i = card. The heuristic rounds it to designs
+ * of exactly card points: the card points with the largest w_i, which is the efficient rounding of Pukelsheim and
+ * Rieder for designs without repeated points, and "nrandom" randomized pipage roundings, which move weight between
+ * pairs of fractional points until all are 0 or 1, so each point is in the design with probability w_i. The points
+ * with w_i = 1 are in every candidate, so the inverse of their information matrix is computed once per call and the
+ * log-determinant of each candidate follows from rank-one updates for its other points. The best candidate is
+ * improved by at most "maxswaps" best exchanges of a point of the design with another point, and if it is better than
+ * the incumbent, the lifted solution of its design is built by createDesignSol() of the problem data.
+ *
+ * A call costs O(numvars log numvars + dim^3 + (nrandom + 1) card dim^2 + maxswaps numvars dim^2) operations, so
+ * the heuristic runs at every node with an LP solution. It needs a cardinality constraint and epsilon > 0, so that
+ * the information matrices are nonsingular.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_HEUR_DESIGNROUND_H__
+#define __SCIP_HEUR_DESIGNROUND_H__
+
+#include <vector>
+#include "objscip/objscip.h"
+
+class ProbData;
+
+/** rounding heuristic for the LP values of the binaries */
+class HeurDesignRound : public scip::ObjHeur
+{
+public:
+   /** default constructor */
+   HeurDesignRound(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~HeurDesignRound()
+   {
+   }
+
+   /** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_HEURINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of primal heuristic (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_HEUREXITSOL(scip_exitsol);
+
+   /** execution method of primal heuristic */
+   virtual SCIP_DECL_HEUREXEC(scip_exec);
+
+private:
+   /** computes the log-determinant of a design that contains the core points and leaves its inverse information
+    *  matrix in minv_; returns false if the matrix is singular
+    */
+   bool evaluate(
+      const ProbData*    probdata,           /**< problem data */
+      const std::vector<int>& design,        /**< the points of the design */
+      SCIP_Real&         logdet              /**< pointer to store the log-determinant */
+      );
+
+   /** improves a design by at most maxswaps_ best exchanges of a point of the design with another point, starting
+    *  from its inverse information matrix in minv_
+    */
+   void exchange(
+      const ProbData*    probdata,           /**< problem data */
+      std::vector<int>&  design,             /**< the design, replaced by the improved design */
+      SCIP_Real&         logdet              /**< its log-determinant, replaced by the improved one */
+      );
+
+   int                   nrandom_;           /**< number of randomized pipage roundings per call */
+   int                   maxswaps_;          /**< maximal number of exchanges of the best candidate */
+   SCIP_RANDNUMGEN*      randnumgen_;        /**< random number generator of the pipage rounding */
+   SCIP_CLOCK*           clock_;             /**< time spent in the calls */
+   int                   ncalls_;            /**< number of calls in the current solve */
+   int                   ncands_;            /**< number of candidate designs in the current solve */
+   int                   nsols_;             /**< number of solutions found in the current solve */
+
+   /* workspace of a call, kept between calls */
+   std::vector<SCIP_Real> lpvals_;           /**< LP values of the binaries */
+   std::vector<SCIP_Real> weights_;          /**< weights of the pipage rounding */
+   std::vector<int>      order_;             /**< the eligible points by decreasing LP value */
+   std::vector<char>     incore_;            /**< for each point, is it in every candidate? */
+   std::vector<char>     indesign_;          /**< for each point, is it in the current design? */
+   std::vector<int>      design_;            /**< the current candidate */
+   std::vector<int>      best_;              /**< the best candidate */
+   std::vector<SCIP_Real> coreinv_;          /**< inverse information matrix of the core points, dim * dim */
+   SCIP_Real             corelogdet_;        /**< log-determinant of the information matrix of the core points */
+   int                   ncore_;             /**< number of core points */
+   std::vector<SCIP_Real> minv_;             /**< inverse information matrix of the last evaluated design */
+   std::vector<SCIP_Real> a_;                /**< a point, dim */
+   std::vector<SCIP_Real> u_;                /**< a point times minv_, dim */
+   std::vector<SCIP_Real> points_;           /**< the eligible points in the order of order_, each with dim entries */
+   std::vector<SCIP_Real> U_;                /**< minv_ times the eligible points, in the order of order_ */
+};/*lint !e1712*/
+
+
+#endif
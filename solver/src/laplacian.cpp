@@ -0,0 +1,407 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   laplacian.cpp
+ * @brief  graph Laplacian machinery for designs of pairwise comparisons
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+#include <algorithm>
+#include <map>
+
+#include "laplacian.h"
+
+using namespace std;
+
+
+/** returns entry (a, b) of M^-1 extended by a zero row and column for the dropped treatment */
+static inline
+double inverseEntry(
+   const vector<double>& Minv,               /**< inverse of the reduced Laplacian, dim * dim */
+   int                   dim,                /**< the dimension */
+   int                   a,                  /**< row, at most dim */
+   int                   b                   /**< column, at most dim */
+   )
+{
+   return (a == dim || b == dim) ? 0.0 : Minv[a * dim + b];
+}
+
+/** returns b_e^T M^-1 b_f for the incidence vectors b_e = e_u - e_v of two edges */
+static inline
+double inverseForm(
+   const vector<double>& Minv,               /**< inverse of the reduced Laplacian, dim * dim */
+   int                   dim,                /**< the dimension */
+   const pair<int, int>& e,                  /**< first edge */
+   const pair<int, int>& f                   /**< second edge */
+   )
+{
+   return inverseEntry(Minv, dim, e.first, f.first) - inverseEntry(Minv, dim, e.first, f.second)
+      - inverseEntry(Minv, dim, e.second, f.first) + inverseEntry(Minv, dim, e.second, f.second);
+}
+
+/** updates M^-1 to (M + sign * b b^T)^-1 by the Sherman-Morrison formula; returns 1 + sign * b^T M^-1 b */
+static
+double laplacianUpdate(
+   vector<double>&       Minv,               /**< inverse of the reduced Laplacian, dim * dim */
+   int                   dim,                /**< the dimension */
+   const pair<int, int>& e,                  /**< the edge of b */
+   double                sign,               /**< +1 to add the edge, -1 to remove it */
+   vector<double>&       u                   /**< buffer for M^-1 b */
+   )
+{
+   u.resize(dim);
+   for( int j = 0; j < dim; j++ )
+      u[j] = inverseEntry(Minv, dim, j, e.first) - inverseEntry(Minv, dim, j, e.second);
+   double denom = 1.0 + sign * inverseForm(Minv, dim, e, e);
+   assert(denom > 0.0);
+
+   for( int j1 = 0; j1 < dim; j1++ )
+   {
+      double s = sign * u[j1] / denom;
+      if( s == 0.0 )
+         continue;
+      double* row = &Minv[j1 * dim];
+      for( int j2 = 0; j2 < dim; j2++ )
+         row[j2] -= s * u[j2];
+   }
+   return denom;
+}
+
+/** computes M^-1 of the reduced Laplacian of a design by a dense Cholesky factorization with the given kernels;
+ *  returns false if M is singular
+ */
+static
+bool laplacianInverse(
+   int                   dim,                /**< the dimension */
+   const vector<pair<int, int>>& edges,      /**< edges of all points */
+   const vector<int>&    points,             /**< the points of the design */
+   double                eps2,               /**< regularization added to the diagonal */
+   const DimKernel&      kernel,             /**< kernels of the dimension */
+   vector<double>&       Minv                /**< matrix to store M^-1, dim * dim */
+   )
+{
+   vector<double> L(dim * dim, 0.0);
+   for( int j = 0; j < dim; j++ )
+      L[j * dim + j] = eps2;
+   for( size_t k = 0; k < points.size(); k++ )
+   {
+      int u = edges[points[k]].first;
+      int v = edges[points[k]].second;
+      L[u * dim + u] += 1.0;
+      if( v < dim )
+      {
+         L[v * dim + v] += 1.0;
+         L[u * dim + v] -= 1.0;
+         L[v * dim + u] -= 1.0;
+      }
+   }
+   if( !kernel.factor(dim, L.data()) )
+      return false;
+
+   // M^-1 = L^-T L^-1, where row j of Linvt is the solution of L x = e_j
+   vector<double> Linvt(dim * dim, 0.0);
+   for( int j = 0; j < dim; j++ )
+   {
+      double* x = &Linvt[j * dim];
+      x[j] = 1.0;
+      kernel.solveLower(dim, L.data(), x);
+   }
+   Minv.assign(dim * dim, 0.0);
+   for( int j1 = 0; j1 < dim; j1++ )
+   {
+      for( int j2 = j1; j2 < dim; j2++ )
+      {
+         double s = 0.0;
+         for( int k = 0; k < dim; k++ )
+            s += Linvt[j1 * dim + k] * Linvt[j2 * dim + k];
+         Minv[j1 * dim + j2] = s;
+         Minv[j2 * dim + j1] = s;
+      }
+   }
+   return true;
+}
+
+
+/** returns whether point i of a data matrix is the incidence vector of an edge, and stores the edge */
+bool incidenceEdge(
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   int                   i,                  /**< index of the point */
+   pair<int, int>&       edge                /**< pair to store the edge (u, v), u < v, where v = dim is the dropped treatment */
+   )
+{
+   int dim = (int) A.size();
+   int nnonzeros = 0;
+   int ends[2] = {dim, dim};
+   double sum = 0.0;
+
+   for( int j = 0; j < dim; j++ )
+   {
+      double a = A[j][i];
+      if( a == 0.0 )
+         continue;
+      if( (a != 1.0 && a != -1.0) || nnonzeros == 2 )
+         return false;
+      ends[nnonzeros++] = j;
+      sum += a;
+   }
+
+   // one entry +-1, or two entries of opposite signs
+   if( nnonzeros == 0 || (nnonzeros == 2 && sum != 0.0) )
+      return false;
+
+   edge = make_pair(ends[0], ends[1]);
+   return true;
+}
+
+/** returns whether all points of a data matrix are incidence vectors of edges, and stores the edges */
+bool incidenceEdges(
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   vector<pair<int, int>>& edges             /**< vector to store the edges of the points */
+   )
+{
+   int numvars = A.empty() ? 0 : (int) A[0].size();
+
+   edges.resize(numvars);
+   for( int i = 0; i < numvars; i++ )
+   {
+      if( !incidenceEdge(A, i, edges[i]) )
+      {
+         edges.clear();
+         return false;
+      }
+   }
+   return numvars > 0;
+}
+
+
+/** returns log det(eps2 * I + sum_i b_i b_i^T) of the reduced Laplacian of the given edges, or -HUGE_VAL if it is
+ *  not positive definite
+ */
+double laplacianLogdet(
+   int                   dim,                /**< the dimension, i.e., the number of treatments - 1 */
+   const vector<pair<int, int>>& edges,      /**< edges of all points */
+   const vector<int>&    points,             /**< the points of the design */
+   double                eps2                /**< regularization added to the diagonal */
+   )
+{
+   // the diagonal and the off-diagonal entries of the rows of the treatments that are not yet eliminated
+   vector<double> diag(dim, eps2);
+   vector<map<int, double>> offdiag(dim);
+   for( size_t k = 0; k < points.size(); k++ )
+   {
+      int u = edges[points[k]].first;
+      int v = edges[points[k]].second;
+      diag[u] += 1.0;
+      if( v < dim )
+      {
+         diag[v] += 1.0;
+         offdiag[u][v] -= 1.0;
+         offdiag[v][u] -= 1.0;
+      }
+   }
+
+   // LDL^T elimination: log det M is the sum of the logarithms of the pivots
+   vector<char> eliminated(dim, 0);
+   vector<pair<int, double>> nbrs;
+   double logdet = 0.0;
+   for( int step = 0; step < dim; step++ )
+   {
+      int p = -1;
+      for( int j = 0; j < dim; j++ )
+      {
+         if( !eliminated[j] && (p < 0 || offdiag[j].size() < offdiag[p].size()) )
+            p = j;
+      }
+
+      double pivot = diag[p];
+      if( pivot <= 0.0 )
+         return -HUGE_VAL;
+      logdet += log(pivot);
+      eliminated[p] = 1;
+
+      // the Schur complement adds the clique of the neighbors of p
+      nbrs.assign(offdiag[p].begin(), offdiag[p].end());
+      offdiag[p].clear();
+      for( size_t a = 0; a < nbrs.size(); a++ )
+         offdiag[nbrs[a].first].erase(p);
+      for( size_t a = 0; a < nbrs.size(); a++ )
+      {
+         int ja = nbrs[a].first;
+         double sa = nbrs[a].second / pivot;
+         diag[ja] -= sa * nbrs[a].second;
+         for( size_t b = 0; b < nbrs.size(); b++ )
+         {
+            if( b != a )
+               offdiag[ja][nbrs[b].first] -= sa * nbrs[b].second;
+         }
+      }
+   }
+
+   return logdet;
+}
+
+
+/** selects edges greedily by maximal effective resistance, which maximizes the increase of log det M in each step,
+ *  like greedyDesign(); the points are returned in the order of selection
+ */
+void laplacianGreedyDesign(
+   int                   dim,                /**< the dimension, i.e., the number of treatments - 1 */
+   const vector<pair<int, int>>& edges,      /**< edges of all points */
+   double                eps2,               /**< regularization of the empty design, M = eps2 * I */
+   int                   size,               /**< the number of points to select */
+   vector<int>&          points              /**< vector to store the selected points */
+   )
+{
+   int numvars = (int) edges.size();
+   assert(eps2 > 0.0);
+
+   points.clear();
+   if( size > numvars )
+      size = numvars;
+
+   vector<double> Minv(dim * dim, 0.0);
+   for( int j = 0; j < dim; j++ )
+      Minv[j * dim + j] = 1.0 / eps2;
+
+   vector<char> selected(numvars, 0);
+   vector<double> u;
+   while( (int) points.size() < size )
+   {
+      // the resistances need three entries of the current inverse each
+      int best = -1;
+      double bestlev = -1.0;
+      for( int i = 0; i < numvars; i++ )
+      {
+         if( selected[i] )
+            continue;
+         double lev = inverseForm(Minv, dim, edges[i], edges[i]);
+         if( lev > bestlev )
+         {
+            best = i;
+            bestlev = lev;
+         }
+      }
+      assert(best >= 0);
+      points.push_back(best);
+      selected[best] = 1;
+
+      (void) laplacianUpdate(Minv, dim, edges[best], 1.0, u);
+   }
+}
+
+
+/** improves a design by exchanges of one edge of the design for one edge outside of it, taking the exchange with
+ *  the largest ratio (1 - r_e)(1 + r_f) + (b_e^T M^-1 b_f)^2 of the determinants until no exchange increases the
+ *  determinant; returns the number of exchanges
+ */
+int laplacianExchange(
+   int                   dim,                /**< the dimension, i.e., the number of treatments - 1 */
+   const vector<pair<int, int>>& edges,      /**< edges of all points */
+   double                eps2,               /**< regularization added to the diagonal */
+   int                   maxexchanges,       /**< maximal number of exchanges */
+   const DimKernel&      kernel,             /**< kernels of the dimension, see dimKernel() */
+   vector<int>&          points              /**< the points of the design, replaced by the improved design */
+   )
+{
+   const int refresh = 50;
+   const double mingain = 1e-9;
+   int numvars = (int) edges.size();
+   int size = (int) points.size();
+
+   vector<char> selected(numvars, 0);
+   for( int k = 0; k < size; k++ )
+      selected[points[k]] = 1;
+
+   vector<double> Minv;
+   vector<double> lev(numvars);
+   vector<double> u;
+   int nexchanges = 0;
+   while( nexchanges < maxexchanges )
+   {
+      // the inverse is recomputed from time to time against the rounding errors of the updates
+      if( nexchanges % refresh == 0 && !laplacianInverse(dim, edges, points, eps2, kernel, Minv) )
+         break;
+
+      for( int i = 0; i < numvars; i++ )
+         lev[i] = inverseForm(Minv, dim, edges[i], edges[i]);
+
+      int bestk = -1;
+      int bestf = -1;
+      double bestratio = 1.0 + mingain;
+      for( int k = 0; k < size; k++ )
+      {
+         int e = points[k];
+         for( int f = 0; f < numvars; f++ )
+         {
+            if( selected[f] )
+               continue;
+            double cross = inverseForm(Minv, dim, edges[e], edges[f]);
+            double ratio = (1.0 - lev[e]) * (1.0 + lev[f]) + cross * cross;
+            if( ratio > bestratio )
+            {
+               bestk = k;
+               bestf = f;
+               bestratio = ratio;
+            }
+         }
+      }
+      if( bestk < 0 )
+         break;
+
+      // the new edge is added first, so that the matrix stays positive definite
+      int e = points[bestk];
+      (void) laplacianUpdate(Minv, dim, edges[bestf], 1.0, u);
+      (void) laplacianUpdate(Minv, dim, edges[e], -1.0, u);
+      selected[e] = 0;
+      selected[bestf] = 1;
+      points[bestk] = bestf;
+      nexchanges++;
+   }
+
+   return nexchanges;
+}
+
+
+/** returns an upper bound on log det(eps2 * I + sum_i b_i b_i^T) over all designs of at most nedges edges
+ *
+ *  Let L be the Laplacian of the design graph on t = dim + 1 treatments with eigenvalues 0 = l_1 <= ... <= l_t,
+ *  whose sum is 2m. The Schur complement of the dropped treatment in L + eps2 * I gives
+ *  det(M) = prod_{k >= 2} (l_k + eps2) / D with D = 1 + sum_k (1^T v_k)^2 mu_k / (mu_k + eps2) over the eigenpairs of
+ *  the reduced Laplacian. If the graph is connected, the resistances to the dropped treatment are at most the
+ *  distances, so mu_k >= 2 / (dim (dim + 1)) and D >= 1 + dim / (1 + eps2 dim (dim + 1) / 2). Otherwise, the reduced
+ *  Laplacian has the eigenvalue 0 and det(M) <= eps2 (2m / (dim - 1) + eps2)^(dim - 1). The bound is the larger of
+ *  the two cases, with the products bounded by the means of the factors.
+ */
+double laplacianLogdetBound(
+   int                   dim,                /**< the dimension, i.e., the number of treatments - 1 */
+   int                   nedges,             /**< the maximal number of edges of a design */
+   double                eps2                /**< regularization added to the diagonal */
+   )
+{
+   assert(dim > 0 && eps2 > 0.0);
+   nedges = max(nedges, 0);
+
+   double bound = log(eps2) + (dim > 1 ? (dim - 1) * log(2.0 * nedges / (dim - 1) + eps2) : 0.0);
+   if( nedges >= dim )
+   {
+      double c = 1.0 / (1.0 + eps2 * dim * (dim + 1) / 2.0);
+      bound = max(bound, dim * log(2.0 * nedges / dim + eps2) - log(1.0 + c * dim));
+   }
+   return bound;
+}
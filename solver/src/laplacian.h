@@ -0,0 +1,100 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   laplacian.h
+ * @brief  graph Laplacian machinery for designs of pairwise comparisons
+ * @author Liding Xu
+ *
+ * In a comparison design, every point is the incidence vector +-(e_u - e_v) of an edge between two of the dim + 1
+ * treatments, where the coordinate of treatment dim is dropped, so the edges to it have the vector +-e_u. The
+ * information matrix eps2 * I + sum_i b_i b_i^T of a design is then the regularized Laplacian of its graph reduced by
+ * the row and column of treatment dim, whose determinant for eps2 = 0 is the number of spanning trees of the graph.
+ *
+ * Edges are stored as pairs (u, v) with u < v <= dim. The leverage b_e^T M^-1 b_e of an edge is its effective
+ * resistance and needs only three entries of M^-1, so the greedy and the exchange heuristic below cost O(numedges)
+ * per evaluation of all points instead of O(numvars * dim) for dense points.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __DOPT_LAPLACIAN_H__
+#define __DOPT_LAPLACIAN_H__
+
+#include <utility>
+#include <vector>
+#include "linalgkernel.h"
+
+/** returns whether point i of a data matrix is the incidence vector of an edge, and stores the edge */
+bool incidenceEdge(
+   const std::vector<std::vector<double>>& A, /**< data matrix: dim * numvars */
+   int                   i,                  /**< index of the point */
+   std::pair<int, int>&  edge                /**< pair to store the edge (u, v), u < v, where v = dim is the dropped treatment */
+   );
+
+/** returns whether all points of a data matrix are incidence vectors of edges, and stores the edges */
+bool incidenceEdges(
+   const std::vector<std::vector<double>>& A, /**< data matrix: dim * numvars */
+   std::vector<std::pair<int, int>>& edges   /**< vector to store the edges of the points */
+   );
+
+/** returns log det(eps2 * I + sum_i b_i b_i^T) of the reduced Laplacian of the given edges, or -HUGE_VAL if it is
+ *  not positive definite
+ *
+ *  The matrix is factorized by a sparse Cholesky factorization that eliminates the treatments in minimum degree
+ *  order, so a design graph of bounded degree costs O(dim) instead of O(dim^3).
+ */
+double laplacianLogdet(
+   int                   dim,                /**< the dimension, i.e., the number of treatments - 1 */
+   const std::vector<std::pair<int, int>>& edges, /**< edges of all points */
+   const std::vector<int>& points,           /**< the points of the design */
+   double                eps2                /**< regularization added to the diagonal */
+   );
+
+/** selects edges greedily by maximal effective resistance, which maximizes the increase of log det M in each step,
+ *  like greedyDesign(); the points are returned in the order of selection
+ */
+void laplacianGreedyDesign(
+   int                   dim,                /**< the dimension, i.e., the number of treatments - 1 */
+   const std::vector<std::pair<int, int>>& edges, /**< edges of all points */
+   double                eps2,               /**< regularization of the empty design, M = eps2 * I */
+   int                   size,               /**< the number of points to select */
+   std::vector<int>&     points              /**< vector to store the selected points */
+   );
+
+/** improves a design by exchanges of one edge of the design for one edge outside of it, taking the exchange with
+ *  the largest ratio (1 - r_e)(1 + r_f) + (b_e^T M^-1 b_f)^2 of the determinants until no exchange increases the
+ *  determinant; returns the number of exchanges
+ */
+int laplacianExchange(
+   int                   dim,                /**< the dimension, i.e., the number of treatments - 1 */
+   const std::vector<std::pair<int, int>>& edges, /**< edges of all points */
+   double                eps2,               /**< regularization added to the diagonal */
+   int                   maxexchanges,       /**< maximal number of exchanges */
+   const DimKernel&      kernel,             /**< kernels of the dimension, see dimKernel() */
+   std::vector<int>&     points              /**< the points of the design, replaced by the improved design */
+   );
+
+/** returns an upper bound on log det(eps2 * I + sum_i b_i b_i^T) over all designs of at most nedges edges
+ *
+ *  The bound extends the spanning tree bound tau(G) <= (2m / (t - 1))^(t - 1) / t of a graph with m edges on t
+ *  treatments to eps2 > 0.
+ */
+double laplacianLogdetBound(
+   int                   dim,                /**< the dimension, i.e., the number of treatments - 1 */
+   int                   nedges,             /**< the maximal number of edges of a design */
+   double                eps2                /**< regularization added to the diagonal */
+   );
+
+#endif
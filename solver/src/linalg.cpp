@@ -0,0 +1,377 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   linalg.cpp
+ * @brief  dense linear algebra for information matrices of designs
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+#include <algorithm>
+
+#include "linalg.h"
+#include "linalgkernel.h"
+
+using namespace std;
+
+
+/** computes the information matrix eps2 * I + sum_i a_i a_i^T of the given points */
+void informationMatrix(
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   const vector<int>&    points,             /**< the points of the design */
+   double                eps2,               /**< regularization added to the diagonal */
+   vector<double>&       M                   /**< matrix to store the result, dim * dim */
+   )
+{
+   int dim = (int) A.size();
+   M.assign(dim * dim, 0.0);
+
+   for( int j = 0; j < dim; j++ )
+      M[j * dim + j] = eps2;
+
+   for( size_t k = 0; k < points.size(); k++ )
+   {
+      int i = points[k];
+      for( int j1 = 0; j1 < dim; j1++ )
+      {
+         double a = A[j1][i];
+         if( a == 0.0 )
+            continue;
+         for( int j2 = 0; j2 <= j1; j2++ )
+            M[j1 * dim + j2] += a * A[j2][i];
+      }
+   }
+
+   for( int j1 = 0; j1 < dim; j1++ )
+      for( int j2 = j1 + 1; j2 < dim; j2++ )
+         M[j1 * dim + j2] = M[j2 * dim + j1];
+}
+
+
+/** overwrites the lower triangle of a symmetric matrix by its Cholesky factor L, M = L L^T, and zeroes the upper
+ *  triangle; returns false if the matrix is not positive definite
+ */
+bool choleskyFactor(
+   int                   dim,                /**< the dimension */
+   vector<double>&       M                   /**< matrix, dim * dim */
+   )
+{
+   assert((int) M.size() == dim * dim);
+
+   return dimKernel(dim, false).factor(dim, M.data());
+}
+
+
+/** solves L x = b by forward substitution, in place */
+void choleskySolveLower(
+   int                   dim,                /**< the dimension */
+   const vector<double>& L,                  /**< Cholesky factor, dim * dim */
+   double*               x                   /**< right hand side b on input, solution x on output */
+   )
+{
+   dimKernel(dim, false).solveLower(dim, L.data(), x);
+}
+
+
+/** returns log det(L L^T) of a Cholesky factor */
+double choleskyLogdet(
+   int                   dim,                /**< the dimension */
+   const vector<double>& L                   /**< Cholesky factor, dim * dim */
+   )
+{
+   return dimKernel(dim, false).logdet(dim, L.data());
+}
+
+
+/** selects points greedily by maximal leverage a_i^T M^-1 a_i, which maximizes the increase of log det M in each
+ *  step; the points are returned in the order of selection
+ */
+void greedyDesign(
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   double                eps2,               /**< regularization of the empty design, M = eps2 * I */
+   int                   size,               /**< the number of points to select */
+   vector<int>&          points              /**< vector to store the selected points */
+   )
+{
+   int dim = (int) A.size();
+   int numvars = dim > 0 ? (int) A[0].size() : 0;
+   assert(eps2 > 0.0);
+
+   DimKernel kernel = dimKernel(dim);
+   points.clear();
+   if( size > numvars )
+      size = numvars;
+
+   // Minv = M^-1 and lev[i] = a_i^T M^-1 a_i for the empty design
+   vector<double> Minv(dim * dim, 0.0);
+   for( int j = 0; j < dim; j++ )
+      Minv[j * dim + j] = 1.0 / eps2;
+
+   vector<double> lev(numvars, 0.0);
+   vector<char> selected(numvars, 0);
+   for( int j = 0; j < dim; j++ )
+   {
+      const double* row = A[j].data();
+      for( int i = 0; i < numvars; i++ )
+         lev[i] += row[i] * row[i] / eps2;
+   }
+
+   vector<double> a(dim);
+   vector<double> u(dim);
+   vector<double> v(numvars);
+   while( (int) points.size() < size )
+   {
+      int best = -1;
+      for( int i = 0; i < numvars; i++ )
+      {
+         if( !selected[i] && (best < 0 || lev[i] > lev[best]) )
+            best = i;
+      }
+      assert(best >= 0);
+      points.push_back(best);
+      selected[best] = 1;
+
+      // Sherman-Morrison: (M + a a^T)^-1 = Minv - u u^T / (1 + a^T u) with u = Minv a
+      for( int j = 0; j < dim; j++ )
+         a[j] = A[j][best];
+      double denom = 1.0 + kernel.rankOne(dim, Minv.data(), a.data(), 1.0, u.data());
+
+      // the leverage of point i decreases by (a_i^T u)^2 / (1 + a^T u)
+      v.assign(numvars, 0.0);
+      for( int j = 0; j < dim; j++ )
+      {
+         const double* row = A[j].data();
+         double uj = u[j];
+         if( uj == 0.0 )
+            continue;
+         for( int i = 0; i < numvars; i++ )
+            v[i] += uj * row[i];
+      }
+      for( int i = 0; i < numvars; i++ )
+         lev[i] -= v[i] * v[i] / denom;
+   }
+}
+
+
+/** computes the information matrix eps2 * I + sum_i w_i a_i a_i^T of a continuous design */
+void weightedInformationMatrix(
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   const vector<double>& w,                  /**< the weights of the points, numvars */
+   double                eps2,               /**< regularization added to the diagonal */
+   vector<double>&       M                   /**< matrix to store the result, dim * dim */
+   )
+{
+   int dim = (int) A.size();
+   M.assign(dim * dim, 0.0);
+
+   for( int j = 0; j < dim; j++ )
+      M[j * dim + j] = eps2;
+
+   for( size_t i = 0; i < w.size(); i++ )
+   {
+      if( w[i] == 0.0 )
+         continue;
+      for( int j1 = 0; j1 < dim; j1++ )
+      {
+         double a = w[i] * A[j1][i];
+         if( a == 0.0 )
+            continue;
+         for( int j2 = 0; j2 <= j1; j2++ )
+            M[j1 * dim + j2] += a * A[j2][i];
+      }
+   }
+
+   for( int j1 = 0; j1 < dim; j1++ )
+      for( int j2 = j1 + 1; j2 < dim; j2++ )
+         M[j1 * dim + j2] = M[j2 * dim + j1];
+}
+
+
+/** computes M^-1 = L^-T L^-1 from the Cholesky factor L of M */
+static
+void choleskyInverse(
+   const DimKernel&      kernel,             /**< kernels of the dimension */
+   int                   dim,                /**< the dimension */
+   const vector<double>& L,                  /**< Cholesky factor, dim * dim */
+   vector<double>&       Minv                /**< matrix to store the inverse, dim * dim */
+   )
+{
+   // row j of Linvt is column j of L^-1, i.e., the solution of L x = e_j
+   vector<double> Linvt(dim * dim, 0.0);
+   for( int j = 0; j < dim; j++ )
+   {
+      double* x = &Linvt[j * dim];
+      x[j] = 1.0;
+      kernel.solveLower(dim, L.data(), x);
+   }
+
+   Minv.assign(dim * dim, 0.0);
+   for( int j1 = 0; j1 < dim; j1++ )
+      for( int j2 = 0; j2 <= j1; j2++ )
+      {
+         double s = 0.0;
+         for( int k = 0; k < dim; k++ )
+            s += Linvt[j1 * dim + k] * Linvt[j2 * dim + k];
+         Minv[j1 * dim + j2] = s;
+         Minv[j2 * dim + j1] = s;
+      }
+}
+
+
+/** adds gamma a a^T to M, given by its inverse and the leverages of all points, by the Sherman-Morrison formula;
+ *  gamma may be negative
+ */
+static
+void rankOneUpdate(
+   const DimKernel&      kernel,             /**< kernels of the dimension */
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   int                   i,                  /**< the point a */
+   double                gamma,              /**< the weight of the update */
+   vector<double>&       Minv,               /**< inverse of M, dim * dim */
+   vector<double>&       lev,                /**< leverages a_i^T M^-1 a_i of all points */
+   vector<double>&       a,                  /**< buffer of length dim */
+   vector<double>&       u,                  /**< buffer of length dim */
+   vector<double>&       v                   /**< buffer of length numvars */
+   )
+{
+   int dim = (int) A.size();
+   int numvars = (int) lev.size();
+
+   // (M + gamma a a^T)^-1 = Minv - gamma u u^T / (1 + gamma a^T u) with u = Minv a
+   for( int j = 0; j < dim; j++ )
+      a[j] = A[j][i];
+   double scale = gamma / (1.0 + gamma * kernel.rankOne(dim, Minv.data(), a.data(), gamma, u.data()));
+
+   v.assign(numvars, 0.0);
+   for( int j = 0; j < dim; j++ )
+   {
+      const double* row = A[j].data();
+      double uj = u[j];
+      if( uj == 0.0 )
+         continue;
+      for( int k = 0; k < numvars; k++ )
+         v[k] += uj * row[k];
+   }
+   for( int k = 0; k < numvars; k++ )
+      lev[k] -= scale * v[k] * v[k];
+}
+
+
+/** computes an optimal continuous design, i.e., weights 0 <= w_i <= 1 with sum_i w_i = size that maximize
+ *  log det(eps2 * I + sum_i w_i a_i a_i^T), by pairwise Frank-Wolfe steps (vertex exchange)
+ *
+ *  The gradient of the log-determinant is the vector of leverages g_i = a_i^T M^-1 a_i, so the vertex of the linear
+ *  subproblem has weight 1 on the size points of largest leverage, and the sum of their leverages minus g^T w is the
+ *  duality gap. A step moves weight from the point of smallest leverage with w_a > 0 to the point of largest leverage
+ *  with w_t < 1. Along this direction, det(M + gamma (a_t a_t^T - a_a a_a^T)) / det M is the concave quadratic
+ *  (1 + gamma g_t)(1 - gamma g_a) + gamma^2 g_ta^2 with g_ta = a_t^T M^-1 a_a, so the line search is exact. M^-1 and
+ *  the leverages are updated by rank-one formulas and recomputed from a Cholesky factor every 100 steps.
+ */
+double continuousDesign(
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   double                eps2,               /**< regularization of the empty design, M = eps2 * I */
+   int                   size,               /**< the sum of the weights */
+   int                   maxiter,            /**< maximal number of iterations */
+   double                gaptol,             /**< the iterations stop as soon as the duality gap is at most gaptol */
+   vector<double>&       w,                  /**< vector to store the weights of the points */
+   int&                  niters              /**< pointer to store the number of iterations */
+   )
+{
+   int dim = (int) A.size();
+   int numvars = dim > 0 ? (int) A[0].size() : 0;
+   DimKernel kernel = dimKernel(dim);
+   assert(eps2 > 0.0);
+
+   niters = 0;
+   w.assign(numvars, 0.0);
+   if( size >= numvars )
+   {
+      w.assign(numvars, 1.0);
+      return 0.0;
+   }
+   if( size <= 0 )
+      return 0.0;
+
+   vector<int> points;
+   greedyDesign(A, eps2, size, points);
+   for( size_t k = 0; k < points.size(); k++ )
+      w[points[k]] = 1.0;
+
+   vector<double> L;
+   vector<double> Minv;
+   vector<double> lev;
+   vector<double> sorted(numvars);
+   vector<double> a(dim);
+   vector<double> u(dim);
+   vector<double> v(numvars);
+   double gap = HUGE_VAL;
+   for( ; niters < maxiter; niters++ )
+   {
+      if( niters % 100 == 0 )
+      {
+         weightedInformationMatrix(A, w, eps2, L);
+         if( !kernel.factor(dim, L.data()) )
+            break;
+         choleskyInverse(kernel, dim, L, Minv);
+         lev.resize(numvars);
+         kernel.leverages(dim, A, L.data(), 0, numvars, lev.data());
+      }
+
+      // duality gap and the points of the exchange
+      int toward = -1;
+      int away = -1;
+      double wg = 0.0;
+      for( int i = 0; i < numvars; i++ )
+      {
+         wg += w[i] * lev[i];
+         if( w[i] < 1.0 && (toward < 0 || lev[i] > lev[toward]) )
+            toward = i;
+         if( w[i] > 0.0 && (away < 0 || lev[i] < lev[away]) )
+            away = i;
+      }
+      sorted = lev;
+      nth_element(sorted.begin(), sorted.begin() + size - 1, sorted.end(), greater<double>());
+      gap = -wg;
+      for( int k = 0; k < size; k++ )
+         gap += sorted[k];
+      if( gap <= gaptol || toward < 0 || away < 0 || lev[toward] <= lev[away] )
+         break;
+
+      double gt = lev[toward];
+      double ga = lev[away];
+      double gta = 0.0;
+      for( int j1 = 0; j1 < dim; j1++ )
+      {
+         double s = 0.0;
+         for( int j2 = 0; j2 < dim; j2++ )
+            s += Minv[j1 * dim + j2] * A[j2][away];
+         gta += A[j1][toward] * s;
+      }
+      double gamma = min(1.0 - w[toward], w[away]);
+      double curv = gt * ga - gta * gta;
+      if( curv > 0.0 )
+         gamma = min(gamma, (gt - ga) / (2.0 * curv));
+
+      rankOneUpdate(kernel, A, toward, gamma, Minv, lev, a, u, v);
+      rankOneUpdate(kernel, A, away, -gamma, Minv, lev, a, u, v);
+      w[toward] = min(w[toward] + gamma, 1.0);
+      w[away] = w[away] - gamma < 1e-12 ? 0.0 : w[away] - gamma;
+   }
+
+   return gap;
+}
@@ -0,0 +1,97 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   linalg.h
+ * @brief  dense linear algebra for information matrices of designs
+ * @author Liding Xu
+ *
+ * Matrices are dim * dim, stored row-major in a std::vector<double>. The data matrix is given as in the problem
+ * data, i.e., A[j][i] is coordinate j of point i.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __DOPT_LINALG_H__
+#define __DOPT_LINALG_H__
+
+#include <vector>
+
+/** computes the information matrix eps2 * I + sum_i a_i a_i^T of the given points */
+void informationMatrix(
+   const std::vector<std::vector<double>>& A, /**< data matrix: dim * numvars */
+   const std::vector<int>& points,           /**< the points of the design */
+   double                eps2,               /**< regularization added to the diagonal */
+   std::vector<double>&  M                   /**< matrix to store the result, dim * dim */
+   );
+
+/** computes the information matrix eps2 * I + sum_i w_i a_i a_i^T of a continuous design */
+void weightedInformationMatrix(
+   const std::vector<std::vector<double>>& A, /**< data matrix: dim * numvars */
+   const std::vector<double>& w,             /**< the weights of the points, numvars */
+   double                eps2,               /**< regularization added to the diagonal */
+   std::vector<double>&  M                   /**< matrix to store the result, dim * dim */
+   );
+
+/** overwrites the lower triangle of a symmetric matrix by its Cholesky factor L, M = L L^T, and zeroes the upper
+ *  triangle; returns false if the matrix is not positive definite
+ */
+bool choleskyFactor(
+   int                   dim,                /**< the dimension */
+   std::vector<double>&  M                   /**< matrix, dim * dim */
+   );
+
+/** solves L x = b by forward substitution, in place */
+void choleskySolveLower(
+   int                   dim,                /**< the dimension */
+   const std::vector<double>& L,             /**< Cholesky factor, dim * dim */
+   double*               x                   /**< right hand side b on input, solution x on output */
+   );
+
+/** returns log det(L L^T) of a Cholesky factor */
+double choleskyLogdet(
+   int                   dim,                /**< the dimension */
+   const std::vector<double>& L              /**< Cholesky factor, dim * dim */
+   );
+
+/** selects points greedily by maximal leverage a_i^T M^-1 a_i, which maximizes the increase of log det M in each
+ *  step; the points are returned in the order of selection
+ *
+ *  The inverse of M and the leverages of all points are updated by rank-one formulas, so a step costs O(numvars * dim).
+ */
+void greedyDesign(
+   const std::vector<std::vector<double>>& A, /**< data matrix: dim * numvars */
+   double                eps2,               /**< regularization of the empty design, M = eps2 * I */
+   int                   size,               /**< the number of points to select */
+   std::vector<int>&     points              /**< vector to store the selected points */
+   );
+
+/** computes an optimal continuous design, i.e., weights 0 <= w_i <= 1 with sum_i w_i = size that maximize
+ *  log det(eps2 * I + sum_i w_i a_i a_i^T), by pairwise Frank-Wolfe steps with exact line search, starting from the
+ *  greedy design; returns the Frank-Wolfe duality gap of the final weights, which bounds the distance of their
+ *  log-determinant to the optimum
+ *
+ *  A step moves weight between two points and costs O(numvars * dim) like a step of greedyDesign().
+ */
+double continuousDesign(
+   const std::vector<std::vector<double>>& A, /**< data matrix: dim * numvars */
+   double                eps2,               /**< regularization of the empty design, M = eps2 * I */
+   int                   size,               /**< the sum of the weights */
+   int                   maxiter,            /**< maximal number of iterations */
+   double                gaptol,             /**< the iterations stop as soon as the duality gap is at most gaptol */
+   std::vector<double>&  w,                  /**< vector to store the weights of the points */
+   int&                  niters              /**< pointer to store the number of iterations */
+   );
+
+#endif
@@ -0,0 +1,270 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   linalgkernel.cpp
+ * @brief  dense kernels of the information matrix compiled for fixed dimensions
+ * @author Liding Xu
+ *
+ * Each kernel is a template on the dimension D; D = 0 is the generic version, which reads the dimension from its
+ * argument. The table of all instantiations is filled on first use.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+
+#include "linalgkernel.h"
+
+using namespace std;
+
+
+/** Cholesky factorization in place */
+template <int D>
+static
+bool factorKernel(
+   int                   dim,                /**< the dimension */
+   double*               M                   /**< matrix, dim * dim */
+   )
+{
+   assert(D == 0 || dim == D);
+   const int n = D > 0 ? D : dim;
+
+   for( int j = 0; j < n; j++ )
+   {
+      double* rowj = &M[j * n];
+      for( int k = 0; k < j; k++ )
+      {
+         const double* rowk = &M[k * n];
+         double s = rowj[k];
+         for( int l = 0; l < k; l++ )
+            s -= rowj[l] * rowk[l];
+         rowj[k] = s / rowk[k];
+      }
+
+      double d = rowj[j];
+      for( int l = 0; l < j; l++ )
+         d -= rowj[l] * rowj[l];
+      if( !(d > 0.0) )
+         return false;
+      rowj[j] = sqrt(d);
+
+      for( int k = j + 1; k < n; k++ )
+         rowj[k] = 0.0;
+   }
+
+   return true;
+}
+
+
+/** forward substitution in place */
+template <int D>
+static
+void solveLowerKernel(
+   int                   dim,                /**< the dimension */
+   const double*         L,                  /**< Cholesky factor, dim * dim */
+   double*               x                   /**< right hand side b on input, solution x on output */
+   )
+{
+   assert(D == 0 || dim == D);
+   const int n = D > 0 ? D : dim;
+
+   for( int j = 0; j < n; j++ )
+   {
+      const double* rowj = &L[j * n];
+      double s = x[j];
+      for( int l = 0; l < j; l++ )
+         s -= rowj[l] * x[l];
+      x[j] = s / rowj[j];
+   }
+}
+
+
+/** log-determinant of a Cholesky factor */
+template <int D>
+static
+double logdetKernel(
+   int                   dim,                /**< the dimension */
+   const double*         L                   /**< Cholesky factor, dim * dim */
+   )
+{
+   assert(D == 0 || dim == D);
+   const int n = D > 0 ? D : dim;
+
+   double logdet = 0.0;
+   for( int j = 0; j < n; j++ )
+      logdet += 2.0 * log(L[j * n + j]);
+   return logdet;
+}
+
+
+/** leverages of a range of points; the forward substitution runs on the rows of A for blocks of points, so the data
+ *  is read contiguously and the loops over the points of a block vectorize
+ *
+ *  With a fixed dimension, a block of 32 KB is kept on the stack and stays in the L1 cache.
+ */
+template <int D>
+static
+void leveragesKernel(
+   int                   dim,                /**< the dimension */
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   const double*         L,                  /**< Cholesky factor, dim * dim */
+   int                   begin,              /**< first point */
+   int                   end,                /**< last point + 1 */
+   double*               lev                 /**< array to store the leverages, indexed by the points */
+   )
+{
+   assert(D == 0 || dim == D);
+   const int n = D > 0 ? D : dim;
+   const int blocksize = D > 0 ? (4096 / D > 8 ? 4096 / D / 8 * 8 : 8) : 256;
+
+   // the block and the inverse diagonal of L, on the stack for a fixed dimension
+   double stackY[D > 0 ? D * blocksize : 1];
+   double stackrdiag[D > 0 ? D : 1];
+   vector<double> heap(D > 0 ? 0 : (size_t) n * (blocksize + 1));
+   double* Y = D > 0 ? stackY : heap.data();
+   double* rdiag = D > 0 ? stackrdiag : heap.data() + (size_t) n * blocksize;
+   for( int j = 0; j < n; j++ )
+      rdiag[j] = 1.0 / L[j * n + j];
+
+   for( int first = begin; first < end; first += blocksize )
+   {
+      int m = end - first < blocksize ? end - first : blocksize;
+      double* out = &lev[first];
+      for( int k = 0; k < m; k++ )
+         out[k] = 0.0;
+
+      for( int j = 0; j < n; j++ )
+      {
+         double* y = &Y[(size_t) j * blocksize];
+         const double* a = &A[j][first];
+         for( int k = 0; k < m; k++ )
+            y[k] = a[k];
+         for( int l = 0; l < j; l++ )
+         {
+            double c = L[j * n + l];
+            const double* yl = &Y[(size_t) l * blocksize];
+            for( int k = 0; k < m; k++ )
+               y[k] -= c * yl[k];
+         }
+         double d = rdiag[j];
+         for( int k = 0; k < m; k++ )
+         {
+            y[k] *= d;
+            out[k] += y[k] * y[k];
+         }
+      }
+   }
+}
+
+
+/** Sherman-Morrison update (M + gamma a a^T)^-1 = Minv - gamma u u^T / (1 + gamma a^T u) with u = Minv a */
+template <int D>
+static
+double rankOneKernel(
+   int                   dim,                /**< the dimension */
+   double*               Minv,               /**< inverse of M, dim * dim */
+   const double*         a,                  /**< the vector a */
+   double                gamma,              /**< the weight of the update */
+   double*               u                   /**< array to store Minv a */
+   )
+{
+   assert(D == 0 || dim == D);
+   const int n = D > 0 ? D : dim;
+
+   double lev = 0.0;
+   for( int j1 = 0; j1 < n; j1++ )
+   {
+      const double* row = &Minv[j1 * n];
+      double s = 0.0;
+      for( int j2 = 0; j2 < n; j2++ )
+         s += row[j2] * a[j2];
+      u[j1] = s;
+      lev += a[j1] * s;
+   }
+
+   double scale = gamma / (1.0 + gamma * lev);
+   for( int j1 = 0; j1 < n; j1++ )
+   {
+      double* row = &Minv[j1 * n];
+      double c = scale * u[j1];
+      for( int j2 = 0; j2 < n; j2++ )
+         row[j2] -= c * u[j2];
+   }
+
+   return lev;
+}
+
+
+/** returns the kernels instantiated for dimension D */
+template <int D>
+static
+DimKernel makeDimKernel()
+{
+   DimKernel kernel;
+   kernel.fixeddim = D;
+   kernel.factor = factorKernel<D>;
+   kernel.solveLower = solveLowerKernel<D>;
+   kernel.logdet = logdetKernel<D>;
+   kernel.leverages = leveragesKernel<D>;
+   kernel.rankOne = rankOneKernel<D>;
+   return kernel;
+}
+
+
+/** fills the entries 0, ..., D of the table of kernels */
+template <int D>
+struct DimKernelTable
+{
+   static void fill(
+      DimKernel*         table               /**< table of DIMKERNEL_MAXDIM + 1 entries */
+      )
+   {
+      table[D] = makeDimKernel<D>();
+      DimKernelTable<D - 1>::fill(table);
+   }
+};
+
+template <>
+struct DimKernelTable<0>
+{
+   static void fill(
+      DimKernel*         table               /**< table of DIMKERNEL_MAXDIM + 1 entries */
+      )
+   {
+      table[0] = makeDimKernel<0>();
+   }
+};
+
+
+/** returns the kernels for the given dimension: the specialized ones for dim <= DIMKERNEL_MAXDIM, unless
+ *  specialized is false, and the generic ones otherwise
+ */
+DimKernel dimKernel(
+   int                   dim,                /**< the dimension */
+   bool                  specialized         /**< should the specialized kernels be used if available? */
+   )
+{
+   static const vector<DimKernel> table = []()
+   {
+      vector<DimKernel> kernels(DIMKERNEL_MAXDIM + 1);
+      DimKernelTable<DIMKERNEL_MAXDIM>::fill(kernels.data());
+      return kernels;
+   }();
+
+   if( specialized && dim >= 1 && dim <= DIMKERNEL_MAXDIM )
+      return table[dim];
+   return table[0];
+}
@@ -0,0 +1,76 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   linalgkernel.h
+ * @brief  dense kernels of the information matrix compiled for fixed dimensions
+ * @author Liding Xu
+ *
+ * The Cholesky factorization, the log-determinant, the triangular solve, the leverages of the points and the
+ * rank-one update of an inverse are templates on the dimension. They are instantiated for every dimension up to
+ * DIMKERNEL_MAXDIM, where the compiler unrolls and vectorizes the loops with constant trip counts, and once with the
+ * dimension as runtime argument for larger problems. dimKernel() selects the instantiation; it is called once per
+ * problem (ProbData::kernel) or per call of the design heuristics, not per operation.
+ *
+ * Matrices are dim * dim, stored row-major, as in linalg.h.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __DOPT_LINALGKERNEL_H__
+#define __DOPT_LINALGKERNEL_H__
+
+#include <vector>
+
+/** largest dimension with specialized kernels */
+#define DIMKERNEL_MAXDIM 64
+
+/** the kernels for one dimension; all functions take the dimension as first argument, which must equal fixeddim
+ *  unless the kernels are generic
+ */
+struct DimKernel
+{
+   int                   fixeddim;           /**< dimension the kernels are compiled for, 0: generic */
+
+   /** overwrites the lower triangle of a symmetric matrix by its Cholesky factor L and zeroes the upper triangle;
+    *  returns false if the matrix is not positive definite
+    */
+   bool (*factor)(int dim, double* M);
+
+   /** solves L x = b by forward substitution, in place */
+   void (*solveLower)(int dim, const double* L, double* x);
+
+   /** returns log det(L L^T) of a Cholesky factor */
+   double (*logdet)(int dim, const double* L);
+
+   /** computes the leverages lev[i] = |L^-1 a_i|^2 of the points begin <= i < end of the data matrix A, which is
+    *  dim * numvars
+    */
+   void (*leverages)(int dim, const std::vector<std::vector<double>>& A, const double* L, int begin, int end, double* lev);
+
+   /** replaces the inverse Minv of M by the inverse of M + gamma a a^T (Sherman-Morrison), stores u = Minv a for the
+    *  old inverse, and returns a^T u
+    */
+   double (*rankOne)(int dim, double* Minv, const double* a, double gamma, double* u);
+};
+
+/** returns the kernels for the given dimension: the specialized ones for dim <= DIMKERNEL_MAXDIM, unless
+ *  specialized is false, and the generic ones otherwise
+ */
+DimKernel dimKernel(
+   int                   dim,                /**< the dimension */
+   bool                  specialized = true  /**< should the specialized kernels be used if available? */
+   );
+
+#endif
@@ -18,11 +18,14 @@
  * @author Liding Xu
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "scip/scip.h"
 #include "scip/scipshell.h"
-#include "scip/scipdefplugins.h"
 
-#include "reader_sub.h"
+#include "plugins.h"
+#include "daemon.h"
 
 /** creates a SCIP instance with default plugins, evaluates command line parameters, runs SCIP appropriately,
  *  and frees the SCIP instance
@@ -46,20 +49,8 @@ SCIP_RETCODE runShell(
    /* we explicitly enable the use of a debug solution for this main SCIP instance */
    SCIPenableDebugSol(scip);
 
-   /* include default SCIP plugins */
-   SCIP_CALL( SCIPincludeDefaultPlugins(scip) );
-
-
-   /* include submodular problem plugins */
-   SCIP_CALL( SCIPincludeObjReader(scip, new ReaderSubmodular(scip), TRUE));
-
-   /* parameter setting */
-   SCIP_CALL(SCIPsetRealParam(scip, "limits/gap", 1e-4));
-   SCIP_CALL(SCIPsetRealParam(scip, "limits/absgap", 1e-6));
-   SCIP_CALL(SCIPsetRealParam(scip, "limits/time", 3600));
-   SCIP_CALL(SCIPsetIntParam(scip, "timing/clocktype", 1));
- 
- 
+   /* include default SCIP plugins and submodular problem plugins, and set the parameters */
+   SCIP_CALL( SCIPincludeDesignPlugins(scip) );
 
    /**********************************
     * Process command line arguments *
@@ -85,7 +76,11 @@ main(
 {
    SCIP_RETCODE retcode;
 
-   retcode = runShell(argc, argv, "scip.set");
+   /* dopt --daemon <socket> [<workers>] runs the solver service instead of the shell */
+   if( argc >= 3 && strcmp(argv[1], "--daemon") == 0 )
+      retcode = runDaemon(argv[2], argc >= 4 ? MAX(atoi(argv[3]), 1) : 1, "scip.set");
+   else
+      retcode = runShell(argc, argv, "scip.set");
    if( retcode != SCIP_OKAY )
    {
       SCIPprintError(retcode);
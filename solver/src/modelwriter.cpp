@@ -0,0 +1,574 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   modelwriter.cpp
+ * @brief  native writers of the MISOCP of a D-optimal design instance in CBF and MPS
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <math.h>
+#include <string.h>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "modelwriter.h"
+#include "textwriter.h"
+
+using namespace std;
+
+/** numbering of the variables of the model */
+struct ModelLayout
+{
+   long long             n;                  /**< the number of items */
+   long long             dim;                /**< the problem dimension */
+   long long             npad;               /**< number of leaves of the geometric mean tree, a power of two >= dim */
+
+   /** creates the layout of an instance */
+   ModelLayout(
+      int                numvars,            /**< the number of items */
+      int                dim_                /**< the problem dimension */
+      ) : n(numvars), dim(dim_), npad(1)
+   {
+      while( npad < dim )
+         npad *= 2;
+   }
+
+   long long bvar(long long i) const { return i; }
+   long long zvar(long long i, long long j) const { return n + i * dim + j; }
+   long long tvar(long long i, long long j) const { return n + n * dim + i * dim + j; }
+   long long epszvar(long long j1, long long j2) const { return n + (2 * n + 1) * dim + j1 * dim + j2; }
+   long long epsz2var(long long j1, long long j2) const { return epszvar(j1, j2) + dim * dim; }
+   long long jvar(long long j) const { return n + (2 * n + 1) * dim + 2 * dim * dim + j; }
+   long long objvar() const { return jvar(dim); }
+   long long auxbase() const { return objvar() + 1; }
+
+   /** index of the row A_j1 Z_j2 + epsilon epsZ_j1j2 = J_j1j2, j1 <= j2, among the rows of the lower triangle */
+   long long azjrow(long long j1, long long j2) const { return j1 * dim - j1 * (j1 - 1) / 2 + (j2 - j1); }
+   long long nazj() const { return dim * (dim + 1) / 2; }
+};
+
+/** builds the tree of rotated cones u^2 <= v w of the geometric mean objective; returns the variable of the root,
+ *  which is at most the geometric mean of J_jj if it is at least obj
+ */
+static
+long long buildMeanTree(
+   const ModelLayout&    layout,             /**< layout of the model */
+   vector<array<long long, 3>>& nodes        /**< vector to store (v, w, u) of every cone */
+   )
+{
+   vector<long long> level((size_t) layout.npad);
+   for( long long k = 0; k < layout.npad; k++ )
+      level[k] = k < layout.dim ? layout.jvar(k) : layout.objvar();
+
+   long long next = layout.auxbase();
+   nodes.clear();
+   while( level.size() > 1 )
+   {
+      vector<long long> up(level.size() / 2);
+      for( size_t k = 0; k < up.size(); k++ )
+      {
+         up[k] = next++;
+         nodes.push_back(array<long long, 3>{{level[2 * k], level[2 * k + 1], up[k]}});
+      }
+      level.swap(up);
+   }
+   return level[0];
+}
+
+/** returns the number of nonzeros of each row of A */
+static
+vector<long long> rowNonzeros(
+   const vector<vector<double>>& A           /**< data matrix: dim * numvars */
+   )
+{
+   vector<long long> nnz(A.size(), 0);
+   for( size_t j = 0; j < A.size(); j++ )
+   {
+      for( size_t i = 0; i < A[j].size(); i++ )
+         nnz[j] += A[j][i] != 0.0;
+   }
+   return nnz;
+}
+
+/** writes the entry of a column in a row of the ACOORD section */
+static
+void putCoord(
+   TextWriter&           writer,             /**< writer */
+   long long             row,                /**< row */
+   long long             col,                /**< column */
+   double                val                 /**< coefficient */
+   )
+{
+   writer.putInt(row, ' ');
+   writer.putInt(col, ' ');
+   writer.putDouble(val, '\n');
+}
+
+bool writeDesignCbf(
+   const string&         filename,           /**< name of the file to write */
+   int                   numvars,            /**< the number of items */
+   int                   dim,                /**< the problem dimension */
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   int                   card,               /**< the cardinality, -1: no cardinality constraint */
+   double                epsilon,            /**< square root of the regularization epsilon */
+   bool                  logdetform,         /**< objective in log-determinant form instead of the geometric mean? */
+   string&               error               /**< string to store the message of an error */
+   )
+{
+   TextWriter writer(filename);
+   if( !writer.ok() )
+   {
+      error = "cannot open " + filename;
+      return false;
+   }
+
+   ModelLayout layout(numvars, dim);
+   const long long n = layout.n;
+   const long long d = layout.dim;
+   vector<array<long long, 3>> tree;
+   long long root = logdetform ? -1 : buildMeanTree(layout, tree);
+   long long naux = logdetform ? d : (long long) tree.size();
+   double emptyvalue = 2 * log(epsilon);
+   bool hascard = card >= 0;
+
+   writer.putf("# D-optimal design MISOCP: %d points, dimension %d, card %d\n", numvars, dim, card);
+   writer.put("VER\n3\n\nOBJSENSE\nMAX\n\n");
+
+   // domains of the variables
+   writer.putf("VAR\n%lld %d\n", layout.auxbase() + naux, naux > 0 ? 8 : 7);
+   writer.putf("L+ %lld\n", n);
+   writer.putf("F %lld\n", n * d);
+   writer.putf("L+ %lld\n", (n + 1) * d);
+   writer.putf("F %lld\n", d * d);
+   writer.putf("L+ %lld\n", d * d);
+   writer.putf("L+ %lld\n", d);
+   writer.put("F 1\n");
+   if( naux > 0 )
+      writer.putf("%s %lld\n", logdetform ? "F" : "L+", naux);
+   writer.put("\n");
+
+   writer.putf("INT\n%lld\n", n);
+   for( long long i = 0; i < n; i++ )
+      writer.putInt(layout.bvar(i), '\n');
+   writer.put("\n");
+
+   // rows: equations, inequalities, then the cones
+   long long neq = layout.nazj() + (hascard ? 1 : 0);
+   long long nineq = 2 * d + n + 1;
+   long long ncones = n * d + d * d + (logdetform ? d : (long long) tree.size());
+   long long ebase = 0;
+   long long gbase = neq;
+   long long qbase = gbase + nineq;
+   long long epsconebase = qbase + 3 * n * d;
+   long long auxconebase = epsconebase + 3 * d * d;
+   long long sumtrow = gbase;
+   long long epssocrow = gbase + d;
+   long long bubrow = gbase + 2 * d;
+   long long objrow = gbase + 2 * d + n;
+
+   writer.putf("CON\n%lld %lld\n", qbase + 3 * ncones, 2 + ncones);
+   writer.putf("L= %lld\n", neq);
+   writer.putf("L+ %lld\n", nineq);
+   for( long long k = 0; k < n * d + d * d + (long long) tree.size(); k++ )
+      writer.put("QR 3\n", 5);
+   if( logdetform )
+   {
+      for( long long j = 0; j < d; j++ )
+         writer.put("EXP 3\n", 6);
+   }
+   writer.put("\n");
+
+   writer.putf("OBJACOORD\n1\n%lld 1\n\n", layout.objvar());
+
+   vector<long long> nnz = rowNonzeros(A);
+   long long nacoord = layout.nazj() + d + (hascard ? n : 0) + d * (n + 2) + d * (d + 1) + n
+      + (logdetform ? d + 1 : 2) + 3 * n * d + 2 * d * d + (logdetform ? 2 * d : 3 * (long long) tree.size());
+   for( long long j1 = 0; j1 < d; j1++ )
+      nacoord += nnz[j1] * (d - j1);
+   writer.putf("ACOORD\n%lld\n", nacoord);
+
+   // A_j1 Z_j2 + epsilon epsZ_j1j2 - J_j1j2 = 0, where J_j1j2 = 0 off the diagonal
+   for( long long j1 = 0; j1 < d; j1++ )
+   {
+      for( long long j2 = j1; j2 < d; j2++ )
+      {
+         long long row = ebase + layout.azjrow(j1, j2);
+         for( long long i = 0; i < n; i++ )
+         {
+            if( A[j1][i] != 0.0 )
+               putCoord(writer, row, layout.zvar(i, j2), A[j1][i]);
+         }
+         putCoord(writer, row, layout.epszvar(j1, j2), epsilon);
+         if( j1 == j2 )
+            putCoord(writer, row, layout.jvar(j1), -1.0);
+      }
+   }
+
+   // sum_i b_i = card
+   if( hascard )
+   {
+      for( long long i = 0; i < n; i++ )
+         putCoord(writer, ebase + layout.nazj(), layout.bvar(i), 1.0);
+   }
+
+   // J_jj - sum_i t_ij - t_nj >= 0
+   for( long long j = 0; j < d; j++ )
+   {
+      putCoord(writer, sumtrow + j, layout.jvar(j), 1.0);
+      for( long long i = 0; i <= n; i++ )
+         putCoord(writer, sumtrow + j, layout.tvar(i, j), -1.0);
+   }
+
+   // t_nj2 - sum_j1 epsZ2_j1j2 >= 0
+   for( long long j2 = 0; j2 < d; j2++ )
+   {
+      putCoord(writer, epssocrow + j2, layout.tvar(n, j2), 1.0);
+      for( long long j1 = 0; j1 < d; j1++ )
+         putCoord(writer, epssocrow + j2, layout.epsz2var(j1, j2), -1.0);
+   }
+
+   // 1 - b_i >= 0
+   for( long long i = 0; i < n; i++ )
+      putCoord(writer, bubrow + i, layout.bvar(i), -1.0);
+
+   // root - obj >= 0, or sum_j s_j / dim - obj - 2 log(epsilon) >= 0
+   if( logdetform )
+   {
+      for( long long j = 0; j < d; j++ )
+         putCoord(writer, objrow, layout.auxbase() + j, 1.0 / d);
+   }
+   else
+      putCoord(writer, objrow, root, 1.0);
+   putCoord(writer, objrow, layout.objvar(), -1.0);
+
+   // (t_ij / 2, b_i, Z_ij) in QR
+   for( long long i = 0; i < n; i++ )
+   {
+      for( long long j = 0; j < d; j++ )
+      {
+         long long row = qbase + 3 * (i * d + j);
+         putCoord(writer, row, layout.tvar(i, j), 0.5);
+         putCoord(writer, row + 1, layout.bvar(i), 1.0);
+         putCoord(writer, row + 2, layout.zvar(i, j), 1.0);
+      }
+   }
+
+   // (epsZ2_j1j2 / 2, 1, epsZ_j1j2) in QR
+   for( long long j1 = 0; j1 < d; j1++ )
+   {
+      for( long long j2 = 0; j2 < d; j2++ )
+      {
+         long long row = epsconebase + 3 * (j1 * d + j2);
+         putCoord(writer, row, layout.epsz2var(j1, j2), 0.5);
+         putCoord(writer, row + 2, layout.epszvar(j1, j2), 1.0);
+      }
+   }
+
+   // (v / 2, w, u) in QR for the tree, or (J_jj, 1, s_j) in EXP
+   if( logdetform )
+   {
+      for( long long j = 0; j < d; j++ )
+      {
+         long long row = auxconebase + 3 * j;
+         putCoord(writer, row, layout.jvar(j), 1.0);
+         putCoord(writer, row + 2, layout.auxbase() + j, 1.0);
+      }
+   }
+   else
+   {
+      for( size_t k = 0; k < tree.size(); k++ )
+      {
+         long long row = auxconebase + 3 * (long long) k;
+         putCoord(writer, row, tree[k][0], 0.5);
+         putCoord(writer, row + 1, tree[k][1], 1.0);
+         putCoord(writer, row + 2, tree[k][2], 1.0);
+      }
+   }
+   writer.put("\n");
+
+   // constants
+   bool objconst = logdetform && emptyvalue != 0.0;
+   long long nbcoord = (hascard && card != 0 ? 1 : 0) + n + (objconst ? 1 : 0) + d * d + (logdetform ? d : 0);
+   writer.putf("BCOORD\n%lld\n", nbcoord);
+   if( hascard && card != 0 )
+      writer.putf("%lld %d\n", ebase + layout.nazj(), -card);
+   for( long long i = 0; i < n; i++ )
+   {
+      writer.putInt(bubrow + i, ' ');
+      writer.put("1\n", 2);
+   }
+   if( objconst )
+      writer.putf("%lld %.15g\n", objrow, -emptyvalue);
+   for( long long k = 0; k < d * d; k++ )
+      writer.putf("%lld 1\n", epsconebase + 3 * k + 1);
+   if( logdetform )
+   {
+      for( long long j = 0; j < d; j++ )
+         writer.putf("%lld 1\n", auxconebase + 3 * j + 1);
+   }
+
+   if( !writer.close() )
+   {
+      error = "cannot write " + filename;
+      return false;
+   }
+   return true;
+}
+
+/** writes a name or field followed by an index and a separator */
+static
+void putName(
+   TextWriter&           writer,             /**< writer */
+   const char*           prefix,             /**< text in front of the index */
+   long long             index,              /**< index */
+   char                  sep                 /**< separator */
+   )
+{
+   writer.put(prefix);
+   writer.putInt(index, sep);
+}
+
+/** writes the linear entry of a column in a row */
+static
+void putEntry(
+   TextWriter&           writer,             /**< writer */
+   long long             col,                /**< column */
+   long long             row,                /**< row */
+   double                val                 /**< coefficient */
+   )
+{
+   putName(writer, "    x", col, ' ');
+   putName(writer, "r", row, ' ');
+   writer.putDouble(val, '\n');
+}
+
+/** writes the quadratic term of a row, u^2 if v < 0, else -u v */
+static
+void putQuadTerm(
+   TextWriter&           writer,             /**< writer */
+   long long             u,                  /**< first column */
+   long long             v                   /**< second column, -1: square of u */
+   )
+{
+   if( v < 0 )
+   {
+      putName(writer, "    x", u, ' ');
+      putName(writer, "x", u, ' ');
+      writer.put("1\n", 2);
+   }
+   else if( u == v )
+   {
+      putName(writer, "    x", u, ' ');
+      putName(writer, "x", u, ' ');
+      writer.put("-1\n", 3);
+   }
+   else
+   {
+      putName(writer, "    x", u, ' ');
+      putName(writer, "x", v, ' ');
+      writer.put("-0.5\n", 5);
+      putName(writer, "    x", v, ' ');
+      putName(writer, "x", u, ' ');
+      writer.put("-0.5\n", 5);
+   }
+}
+
+bool writeDesignMps(
+   const string&         filename,           /**< name of the file to write */
+   int                   numvars,            /**< the number of items */
+   int                   dim,                /**< the problem dimension */
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   int                   card,               /**< the cardinality, -1: no cardinality constraint */
+   double                epsilon,            /**< square root of the regularization epsilon */
+   string&               error               /**< string to store the message of an error */
+   )
+{
+   TextWriter writer(filename);
+   if( !writer.ok() )
+   {
+      error = "cannot open " + filename;
+      return false;
+   }
+
+   ModelLayout layout(numvars, dim);
+   const long long n = layout.n;
+   const long long d = layout.dim;
+   vector<array<long long, 3>> tree;
+   long long root = buildMeanTree(layout, tree);
+   bool hascard = card >= 0;
+
+   // rows: A Z = J, card, sum t <= J, epsZ soc, objective, then the cones
+   long long cardrow = layout.nazj();
+   long long sumtrow = cardrow + (hascard ? 1 : 0);
+   long long epssocrow = sumtrow + d;
+   long long objrow = epssocrow + d;
+   long long conerow = objrow + 1;
+   long long epsconerow = conerow + n * d;
+   long long treerow = epsconerow + d * d;
+   long long nrows = treerow + (long long) tree.size();
+
+   writer.putf("* D-optimal design MIQCP: %d points, dimension %d, card %d; minimizes -obj, the geometric mean\n",
+      numvars, dim, card);
+   writer.put("NAME design\nROWS\n N obj\n");
+   for( long long r = 0; r < nrows; r++ )
+   {
+      const char* sense = r < sumtrow ? " E" : (r == objrow ? " G" : " L");
+      writer.put(sense);
+      putName(writer, " r", r, '\n');
+   }
+
+   writer.put("COLUMNS\n    MARKER 'MARKER' 'INTORG'\n");
+   for( long long i = 0; i < n; i++ )
+   {
+      if( hascard )
+         putEntry(writer, layout.bvar(i), cardrow, 1.0);
+      else
+         writer.putf("    x%lld obj 0\n", layout.bvar(i));
+   }
+   writer.put("    MARKER 'MARKER' 'INTEND'\n");
+
+   for( long long i = 0; i < n; i++ )
+   {
+      for( long long j = 0; j < d; j++ )
+      {
+         bool empty = true;
+         for( long long j1 = 0; j1 <= j; j1++ )
+         {
+            if( A[j1][i] != 0.0 )
+            {
+               putEntry(writer, layout.zvar(i, j), layout.azjrow(j1, j), A[j1][i]);
+               empty = false;
+            }
+         }
+         // a column that only appears in quadratic terms is declared with a zero objective coefficient
+         if( empty )
+         {
+            putName(writer, "    x", layout.zvar(i, j), ' ');
+            writer.put("obj 0\n", 6);
+         }
+      }
+   }
+   for( long long i = 0; i <= n; i++ )
+   {
+      for( long long j = 0; j < d; j++ )
+      {
+         putEntry(writer, layout.tvar(i, j), sumtrow + j, 1.0);
+         if( i == n )
+            putEntry(writer, layout.tvar(i, j), epssocrow + j, -1.0);
+      }
+   }
+   for( long long j1 = 0; j1 < d; j1++ )
+   {
+      for( long long j2 = 0; j2 < d; j2++ )
+      {
+         if( j1 <= j2 )
+            putEntry(writer, layout.epszvar(j1, j2), layout.azjrow(j1, j2), epsilon);
+         else
+            writer.putf("    x%lld obj 0\n", layout.epszvar(j1, j2));
+      }
+   }
+   for( long long j1 = 0; j1 < d; j1++ )
+   {
+      for( long long j2 = 0; j2 < d; j2++ )
+      {
+         putEntry(writer, layout.epsz2var(j1, j2), epssocrow + j2, 1.0);
+         putEntry(writer, layout.epsz2var(j1, j2), epsconerow + j1 * d + j2, -1.0);
+      }
+   }
+   for( long long j = 0; j < d; j++ )
+   {
+      putEntry(writer, layout.jvar(j), layout.azjrow(j, j), -1.0);
+      putEntry(writer, layout.jvar(j), sumtrow + j, -1.0);
+      if( layout.jvar(j) == root )
+         putEntry(writer, layout.jvar(j), objrow, 1.0);
+   }
+   writer.putf("    x%lld obj -1\n", layout.objvar());
+   putEntry(writer, layout.objvar(), objrow, -1.0);
+   for( size_t k = 0; k < tree.size(); k++ )
+   {
+      if( tree[k][2] == root )
+         putEntry(writer, tree[k][2], objrow, 1.0);
+      else
+         writer.putf("    x%lld obj 0\n", tree[k][2]);
+   }
+
+   writer.put("RHS\n");
+   if( hascard && card != 0 )
+      writer.putf("    rhs r%lld %d\n", cardrow, card);
+
+   writer.put("BOUNDS\n");
+   for( long long i = 0; i < n; i++ )
+      putName(writer, " BV bnd x", layout.bvar(i), '\n');
+   for( long long k = 0; k < n * d; k++ )
+      putName(writer, " FR bnd x", layout.zvar(0, 0) + k, '\n');
+   for( long long k = 0; k < d * d; k++ )
+      writer.putf(" FR bnd x%lld\n", layout.epszvar(0, 0) + k);
+   writer.putf(" FR bnd x%lld\n", layout.objvar());
+
+   // Z_ij^2 - t_ij b_i <= 0, epsZ^2 - epsZ2 <= 0 and u^2 - v w <= 0
+   for( long long i = 0; i < n; i++ )
+   {
+      for( long long j = 0; j < d; j++ )
+      {
+         putName(writer, "QCMATRIX r", conerow + i * d + j, '\n');
+         putQuadTerm(writer, layout.zvar(i, j), -1);
+         putQuadTerm(writer, layout.tvar(i, j), layout.bvar(i));
+      }
+   }
+   for( long long k = 0; k < d * d; k++ )
+   {
+      writer.putf("QCMATRIX r%lld\n", epsconerow + k);
+      putQuadTerm(writer, layout.epszvar(0, 0) + k, -1);
+   }
+   for( size_t k = 0; k < tree.size(); k++ )
+   {
+      writer.putf("QCMATRIX r%lld\n", treerow + (long long) k);
+      putQuadTerm(writer, tree[k][2], -1);
+      putQuadTerm(writer, tree[k][0], tree[k][1]);
+   }
+   writer.put("ENDATA\n");
+
+   if( !writer.close() )
+   {
+      error = "cannot write " + filename;
+      return false;
+   }
+   return true;
+}
+
+bool writeDesignModel(
+   const string&         filename,           /**< name of the file to write */
+   int                   numvars,            /**< the number of items */
+   int                   dim,                /**< the problem dimension */
+   const vector<vector<double>>& A,          /**< data matrix: dim * numvars */
+   int                   card,               /**< the cardinality, -1: no cardinality constraint */
+   double                epsilon,            /**< square root of the regularization epsilon */
+   bool                  logdetform,         /**< objective in log-determinant form instead of the geometric mean? */
+   string&               error               /**< string to store the message of an error */
+   )
+{
+   size_t dot = filename.rfind('.');
+   string ext = dot == string::npos ? "" : filename.substr(dot);
+   if( ext == ".cbf" )
+      return writeDesignCbf(filename, numvars, dim, A, card, epsilon, logdetform, error);
+   if( ext == ".mps" )
+      return writeDesignMps(filename, numvars, dim, A, card, epsilon, error);
+
+   error = "unknown model format of " + filename + " (.cbf or .mps)";
+   return false;
+}
@@ -0,0 +1,81 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   modelwriter.h
+ * @brief  native writers of the MISOCP of a D-optimal design instance in CBF and MPS
+ * @author Liding Xu
+ *
+ * The writers emit the model that the reader builds (the cones Z_ij^2 <= t_ij b_i, the rows A Z = J for the lower
+ * triangle, sum_i t_ij <= J_jj, the regularization columns epsZ, epsZ2 and t_nj and the cardinality constraint)
+ * directly from A, card and epsilon, column block by column block, without building SCIP variables or expressions.
+ *
+ * - CBF (Conic Benchmark Format, version 3): every cone is a rotated quadratic cone (2 x0 x1 >= x2^2, x0, x1 >= 0),
+ *   obj is maximized; the geometric mean objective obj <= (prod_j J_jj)^(1/dim) is written as a binary tree of rotated
+ *   cones over the J_jj, padded with obj to a power of two, and the log-determinant form
+ *   obj <= sum_j log(J_jj) / dim - 2 log(epsilon) with exponential cones (J_jj, 1, s_j).
+ * - MPS (free format, CPLEX/Gurobi QCMATRIX sections): the cones are quadratic rows; the objective is always the
+ *   geometric mean tree, which has the same optimal designs as the log-determinant form, and -obj is minimized.
+ *   The names are compact: column k is "x<k>", row k is "r<k>".
+ *
+ * Variables are numbered as b_i, Z_ij, t_ij (t_nj last), epsZ, epsZ2, J_jj, obj and the auxiliary variables of the
+ * objective; numbers are written with 15 significant digits.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __DOPT_MODELWRITER_H__
+#define __DOPT_MODELWRITER_H__
+
+#include <string>
+#include <vector>
+
+/** writes the model in CBF; returns false and sets error if the file cannot be written */
+bool writeDesignCbf(
+   const std::string&    filename,           /**< name of the file to write */
+   int                   numvars,            /**< the number of items */
+   int                   dim,                /**< the problem dimension */
+   const std::vector<std::vector<double>>& A, /**< data matrix: dim * numvars */
+   int                   card,               /**< the cardinality, -1: no cardinality constraint */
+   double                epsilon,            /**< square root of the regularization epsilon */
+   bool                  logdetform,         /**< objective in log-determinant form instead of the geometric mean? */
+   std::string&          error               /**< string to store the message of an error */
+   );
+
+/** writes the model in free MPS with quadratic rows; returns false and sets error if the file cannot be written */
+bool writeDesignMps(
+   const std::string&    filename,           /**< name of the file to write */
+   int                   numvars,            /**< the number of items */
+   int                   dim,                /**< the problem dimension */
+   const std::vector<std::vector<double>>& A, /**< data matrix: dim * numvars */
+   int                   card,               /**< the cardinality, -1: no cardinality constraint */
+   double                epsilon,            /**< square root of the regularization epsilon */
+   std::string&          error               /**< string to store the message of an error */
+   );
+
+/** writes the model in the format of the extension of the file name, ".cbf" or ".mps"; returns false and sets error
+ *  for other extensions or if the file cannot be written
+ */
+bool writeDesignModel(
+   const std::string&    filename,           /**< name of the file to write */
+   int                   numvars,            /**< the number of items */
+   int                   dim,                /**< the problem dimension */
+   const std::vector<std::vector<double>>& A, /**< data matrix: dim * numvars */
+   int                   card,               /**< the cardinality, -1: no cardinality constraint */
+   double                epsilon,            /**< square root of the regularization epsilon */
+   bool                  logdetform,         /**< objective in log-determinant form instead of the geometric mean? */
+   std::string&          error               /**< string to store the message of an error */
+   );
+
+#endif
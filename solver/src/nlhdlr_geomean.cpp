@@ -0,0 +1,569 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   nlhdlr_geomean.cpp
+ * @brief  nonlinear handler for geometric means and sums of logarithms
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+#include "nlhdlr_geomean.h"
+#include "table_profile.h"
+#include "scip/cons_nonlinear.h"
+#include "scip/expr_var.h"
+#include "scip/expr_pow.h"
+#include "scip/expr_product.h"
+#include "scip/expr_sum.h"
+
+using namespace std;
+
+#define NLHDLR_NAME            "geomean"
+#define NLHDLR_DESC            "handler for geometric means and sums of logarithms"
+#define NLHDLR_DETECTPRIORITY  200
+#define NLHDLR_ENFOPRIORITY    200
+
+#define MINARG                 1e-6          /**< arguments below this value are moved up before linearizing */
+
+
+/*
+ * Data structures
+ */
+
+/** nonlinear handler expression data */
+struct SCIP_NlhdlrExprData
+{
+   SCIP_Bool             logsum;             /**< is the expression a sum of logarithms (otherwise a product)? */
+   SCIP_Real             coef;               /**< coefficient of the product, or constant of the sum */
+   vector<SCIP_EXPR*>    args;               /**< arguments x_k of the powers or logarithms */
+   vector<SCIP_Real>     exps;               /**< exponents p_k of the powers, or coefficients c_k of the logarithms */
+   vector<SCIP_EXPR*>    linexprs;           /**< linear terms y_l of a sum of logarithms */
+   vector<SCIP_Real>     lincoefs;           /**< coefficients d_l of the linear terms */
+};
+
+
+/*
+ * Local methods
+ */
+
+/** returns whether an expression is a logarithm */
+static
+SCIP_Bool isExprLog(
+   SCIP_EXPR*            expr                /**< expression */
+   )
+{
+   return strcmp(SCIPexprhdlrGetName(SCIPexprGetHdlr(expr)), "log") == 0;
+}
+
+/** returns whether the bounds of an expression are nonnegative */
+static
+SCIP_Bool isNonnegative(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_EXPR*            expr                /**< expression */
+   )
+{
+   return SCIPgetExprBoundsNonlinear(scip, expr).inf >= 0.0;
+}
+
+/** tries to recognize coef * prod_k x_k^p_k with coef > 0, p_k > 0, sum_k p_k <= 1 and x_k >= 0 */
+static
+SCIP_Bool detectProduct(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_EXPR*            expr,               /**< expression */
+   SCIP_NLHDLREXPRDATA*  data                /**< data to fill */
+   )
+{
+   if( !SCIPisExprProduct(scip, expr) || SCIPexprGetNChildren(expr) < 2 || SCIPgetCoefExprProduct(expr) <= 0.0 )
+      return FALSE;
+
+   SCIP_EXPR** children = SCIPexprGetChildren(expr);
+   SCIP_Real degree = 0.0;
+   for( int k = 0; k < SCIPexprGetNChildren(expr); k++ )
+   {
+      SCIP_EXPR* arg = children[k];
+      SCIP_Real p = 1.0;
+      if( SCIPisExprPower(scip, children[k]) )
+      {
+         arg = SCIPexprGetChildren(children[k])[0];
+         p = SCIPgetExponentExprPow(children[k]);
+      }
+      if( p <= 0.0 || !isNonnegative(scip, arg) )
+         return FALSE;
+
+      data->args.push_back(arg);
+      data->exps.push_back(p);
+      degree += p;
+   }
+
+   if( SCIPisGT(scip, degree, 1.0) )
+      return FALSE;
+
+   data->logsum = FALSE;
+   data->coef = SCIPgetCoefExprProduct(expr);
+   return TRUE;
+}
+
+/** tries to recognize sum_k c_k log(x_k) + sum_l d_l y_l + constant with c_k > 0, at least two logarithms, and
+ *  variables y_l
+ */
+static
+SCIP_Bool detectLogsum(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_EXPR*            expr,               /**< expression */
+   SCIP_NLHDLREXPRDATA*  data                /**< data to fill */
+   )
+{
+   if( !SCIPisExprSum(scip, expr) )
+      return FALSE;
+
+   SCIP_EXPR** children = SCIPexprGetChildren(expr);
+   SCIP_Real* coefs = SCIPgetCoefsExprSum(expr);
+   for( int k = 0; k < SCIPexprGetNChildren(expr); k++ )
+   {
+      if( isExprLog(children[k]) && coefs[k] > 0.0 )
+      {
+         data->args.push_back(SCIPexprGetChildren(children[k])[0]);
+         data->exps.push_back(coefs[k]);
+      }
+      else if( SCIPisExprVar(scip, children[k]) )
+      {
+         data->linexprs.push_back(children[k]);
+         data->lincoefs.push_back(coefs[k]);
+      }
+      else
+         return FALSE;
+   }
+
+   if( data->args.size() < 2 )
+      return FALSE;
+
+   data->logsum = TRUE;
+   data->coef = SCIPgetConstantExprSum(expr);
+   return TRUE;
+}
+
+/** evaluates the concave part of the expression at the given arguments: coef * prod_k x_k^p_k, or
+ *  sum_k c_k log(x_k) without linear terms and constant
+ */
+static
+SCIP_Real evalConcave(
+   SCIP_NLHDLREXPRDATA*  data,               /**< expression data */
+   const SCIP_Real*      x                   /**< values of the arguments, positive */
+   )
+{
+   SCIP_Real logval = 0.0;
+   for( size_t k = 0; k < data->args.size(); k++ )
+      logval += data->exps[k] * log(x[k]);
+
+   return data->logsum ? logval : data->coef * exp(logval);
+}
+
+/** computes the interval of the term k, which is c_k log(x_k) for a sum of logarithms and log(x_k^p_k) for a product,
+ *  so that the product is a sum of terms in log space as well
+ */
+static
+void termInterval(
+   SCIP_NLHDLREXPRDATA*  data,               /**< expression data */
+   int                   k,                  /**< index of the term */
+   SCIP_INTERVAL         argbounds,          /**< bounds of the argument */
+   SCIP_Real*            tmin,               /**< pointer to store the minimum of the term */
+   SCIP_Real*            tmax                /**< pointer to store the maximum of the term */
+   )
+{
+   SCIP_Real lb = MAX(argbounds.inf, 0.0);
+   SCIP_Real ub = argbounds.sup;
+   SCIP_Real p = data->exps[k];
+
+   *tmin = lb > 0.0 ? p * log(lb) : -SCIP_INTERVAL_INFINITY;
+   if( ub >= SCIP_INTERVAL_INFINITY )
+      *tmax = SCIP_INTERVAL_INFINITY;
+   else
+      *tmax = ub > 0.0 ? p * log(ub) : -SCIP_INTERVAL_INFINITY;
+}
+
+
+/*
+ * Callback methods of nonlinear handler
+ */
+
+/** nonlinear handler copy callback: the handler has no data, so the copy of a sub-SCIP is a new handler */
+static
+SCIP_DECL_NLHDLRCOPYHDLR(nlhdlrCopyhdlrGeomean)
+{  /*lint --e{715}*/
+   assert(targetscip != NULL);
+   assert(sourcenlhdlr != NULL);
+   assert(strcmp(SCIPnlhdlrGetName(sourcenlhdlr), NLHDLR_NAME) == 0);
+
+   SCIP_CALL( SCIPincludeNlhdlrGeomean(targetscip) );
+
+   return SCIP_OKAY;
+}
+
+/** callback to free expression specific data */
+static
+SCIP_DECL_NLHDLRFREEEXPRDATA(nlhdlrFreeExprDataGeomean)
+{  /*lint --e{715}*/
+   assert(nlhdlrexprdata != NULL);
+
+   delete *nlhdlrexprdata;
+   *nlhdlrexprdata = NULL;
+
+   return SCIP_OKAY;
+}
+
+
+/** callback to detect structure in expression tree */
+static
+SCIP_DECL_NLHDLRDETECT(nlhdlrDetectGeomean)
+{  /*lint --e{715}*/
+   DOPT_PROFILE(scip, "geomean/detect");
+   assert(expr != NULL);
+   assert(enforcing != NULL);
+   assert(participating != NULL);
+   assert(nlhdlrexprdata != NULL);
+
+   /* the expression is concave, so only overestimation by tangents is exact */
+   SCIP_Bool sepa = (*enforcing & SCIP_NLHDLR_METHOD_SEPAABOVE) == 0;
+   SCIP_Bool activity = (*enforcing & SCIP_NLHDLR_METHOD_ACTIVITY) == 0;
+   if( !sepa && !activity )
+      return SCIP_OKAY;
+
+   SCIP_NLHDLREXPRDATA* data = new SCIP_NlhdlrExprData;
+   if( !detectProduct(scip, expr, data) )
+   {
+      data->args.clear();
+      data->exps.clear();
+      if( !detectLogsum(scip, expr, data) )
+      {
+         delete data;
+         return SCIP_OKAY;
+      }
+   }
+
+   for( size_t k = 0; k < data->args.size(); k++ )
+   {
+      SCIP_CALL( SCIPregisterExprUsageNonlinear(scip, data->args[k], sepa, activity, FALSE, FALSE) );
+   }
+   for( size_t l = 0; l < data->linexprs.size(); l++ )
+   {
+      SCIP_CALL( SCIPregisterExprUsageNonlinear(scip, data->linexprs[l], sepa, activity, FALSE, FALSE) );
+   }
+
+   if( sepa )
+      *participating |= SCIP_NLHDLR_METHOD_SEPAABOVE;
+   if( activity )
+      *participating |= SCIP_NLHDLR_METHOD_ACTIVITY;
+   *enforcing |= *participating;
+   *nlhdlrexprdata = data;
+
+   SCIPdebugMsg(scip, "detected %s with %d terms\n", data->logsum ? "sum of logarithms" : "geometric mean",
+      (int) data->args.size());
+
+   return SCIP_OKAY;
+}
+
+
+/** auxiliary evaluation callback of nonlinear handler */
+static
+SCIP_DECL_NLHDLREVALAUX(nlhdlrEvalauxGeomean)
+{  /*lint --e{715}*/
+   DOPT_PROFILE(scip, "geomean/evalaux");
+   assert(nlhdlrexprdata != NULL);
+   assert(auxvalue != NULL);
+
+   int n = (int) nlhdlrexprdata->args.size();
+   vector<SCIP_Real> x(n);
+   for( int k = 0; k < n; k++ )
+   {
+      x[k] = SCIPgetSolVal(scip, sol, SCIPgetExprAuxVarNonlinear(nlhdlrexprdata->args[k]));
+      if( x[k] <= 0.0 )
+      {
+         /* the product vanishes, the logarithm is undefined */
+         *auxvalue = nlhdlrexprdata->logsum ? SCIP_INVALID : 0.0;
+         return SCIP_OKAY;
+      }
+   }
+
+   *auxvalue = evalConcave(nlhdlrexprdata, x.data());
+   if( nlhdlrexprdata->logsum )
+   {
+      *auxvalue += nlhdlrexprdata->coef;
+      for( size_t l = 0; l < nlhdlrexprdata->linexprs.size(); l++ )
+         *auxvalue += nlhdlrexprdata->lincoefs[l] * SCIPgetSolVal(scip, sol,
+               SCIPgetExprAuxVarNonlinear(nlhdlrexprdata->linexprs[l]));
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** nonlinear handler estimation callback: the tangent plane at the point */
+static
+SCIP_DECL_NLHDLRESTIMATE(nlhdlrEstimateGeomean)
+{  /*lint --e{715}*/
+   DOPT_PROFILE(scip, "geomean/estimate");
+   assert(nlhdlrexprdata != NULL);
+   assert(success != NULL);
+
+   *success = FALSE;
+   *addedbranchscores = FALSE;
+
+   if( !overestimate )
+      return SCIP_OKAY;
+
+   /* arguments at zero are moved into the interior, where the gradient exists; any tangent is valid by concavity */
+   int n = (int) nlhdlrexprdata->args.size();
+   vector<SCIP_VAR*> vars(n);
+   vector<SCIP_Real> x(n);
+   for( int k = 0; k < n; k++ )
+   {
+      vars[k] = SCIPgetExprAuxVarNonlinear(nlhdlrexprdata->args[k]);
+      x[k] = MAX(SCIPgetSolVal(scip, sol, vars[k]), MINARG);
+   }
+
+   SCIP_Real val = evalConcave(nlhdlrexprdata, x.data());
+   SCIP_Real constant = val;
+   vector<SCIP_Real> grad(n);
+   for( int k = 0; k < n; k++ )
+   {
+      /* d/dx_k of coef * prod x^p is p_k val / x_k, and of sum c log(x) it is c_k / x_k */
+      grad[k] = nlhdlrexprdata->exps[k] * (nlhdlrexprdata->logsum ? 1.0 : val) / x[k];
+      constant -= grad[k] * x[k];
+   }
+
+   SCIP_ROWPREP* rowprep;
+   SCIP_CALL( SCIPcreateRowprep(scip, &rowprep, SCIP_SIDETYPE_LEFT, FALSE) );
+   SCIP_CALL( SCIPaddRowprepTerms(scip, rowprep, n, vars.data(), grad.data()) );
+   if( nlhdlrexprdata->logsum )
+   {
+      constant += nlhdlrexprdata->coef;
+      for( size_t l = 0; l < nlhdlrexprdata->linexprs.size(); l++ )
+      {
+         SCIP_CALL( SCIPaddRowprepTerm(scip, rowprep, SCIPgetExprAuxVarNonlinear(nlhdlrexprdata->linexprs[l]),
+               nlhdlrexprdata->lincoefs[l]) );
+      }
+   }
+   SCIPaddRowprepConstant(rowprep, constant);
+   (void) SCIPsnprintf(SCIProwprepGetName(rowprep), SCIP_MAXSTRLEN, "%s_tangent", nlhdlrexprdata->logsum ? "logsum" : "geomean");
+
+   SCIP_CALL( SCIPsetPtrarrayVal(scip, rowpreps, 0, rowprep) );
+   *success = TRUE;
+
+   return SCIP_OKAY;
+}
+
+
+/** nonlinear handler interval evaluation callback */
+static
+SCIP_DECL_NLHDLRINTEVAL(nlhdlrIntevalGeomean)
+{  /*lint --e{715}*/
+   DOPT_PROFILE(scip, "geomean/inteval");
+   assert(nlhdlrexprdata != NULL);
+   assert(interval != NULL);
+
+   /* both forms are increasing in every x_k; the terms of a product are summed in log space */
+   SCIP_Real inf = 0.0;
+   SCIP_Real sup = 0.0;
+   for( size_t k = 0; k < nlhdlrexprdata->args.size(); k++ )
+   {
+      SCIP_Real tmin;
+      SCIP_Real tmax;
+      termInterval(nlhdlrexprdata, (int) k, SCIPexprGetActivity(nlhdlrexprdata->args[k]), &tmin, &tmax);
+      inf = (inf <= -SCIP_INTERVAL_INFINITY || tmin <= -SCIP_INTERVAL_INFINITY) ? -SCIP_INTERVAL_INFINITY : inf + tmin;
+      sup = (sup >= SCIP_INTERVAL_INFINITY || tmax >= SCIP_INTERVAL_INFINITY) ? SCIP_INTERVAL_INFINITY
+         : (sup <= -SCIP_INTERVAL_INFINITY || tmax <= -SCIP_INTERVAL_INFINITY ? -SCIP_INTERVAL_INFINITY : sup + tmax);
+   }
+
+   if( !nlhdlrexprdata->logsum )
+   {
+      SCIP_Real coef = nlhdlrexprdata->coef;
+      inf = inf <= -SCIP_INTERVAL_INFINITY ? 0.0 : coef * exp(inf);
+      sup = sup >= SCIP_INTERVAL_INFINITY ? SCIP_INTERVAL_INFINITY : (sup <= -SCIP_INTERVAL_INFINITY ? 0.0 : coef * exp(sup));
+   }
+   else
+   {
+      inf += nlhdlrexprdata->coef;
+      sup += nlhdlrexprdata->coef;
+      for( size_t l = 0; l < nlhdlrexprdata->linexprs.size(); l++ )
+      {
+         SCIP_INTERVAL b = SCIPexprGetActivity(nlhdlrexprdata->linexprs[l]);
+         SCIP_Real d = nlhdlrexprdata->lincoefs[l];
+         SCIP_Real lmin = d > 0.0 ? b.inf : b.sup;
+         SCIP_Real lmax = d > 0.0 ? b.sup : b.inf;
+         inf = (inf <= -SCIP_INTERVAL_INFINITY || REALABS(lmin) >= SCIP_INTERVAL_INFINITY) ? -SCIP_INTERVAL_INFINITY : inf + d * lmin;
+         sup = (sup >= SCIP_INTERVAL_INFINITY || REALABS(lmax) >= SCIP_INTERVAL_INFINITY) ? SCIP_INTERVAL_INFINITY : sup + d * lmax;
+      }
+   }
+
+   SCIPintervalSetBounds(interval, MAX(inf, interval->inf), MIN(sup, interval->sup));
+
+   return SCIP_OKAY;
+}
+
+
+/** nonlinear handler callback for reverse propagation
+ *
+ *  All terms are increasing, so with the bounds [L, U] of the expression and the minimal and maximal sum of the other
+ *  terms, a term k satisfies term_k <= U - min(others) and term_k >= L - max(others). For a product, the terms are
+ *  p_k log(x_k) and L, U are log(L / coef), log(U / coef).
+ */
+static
+SCIP_DECL_NLHDLRREVERSEPROP(nlhdlrReversepropGeomean)
+{  /*lint --e{715}*/
+   DOPT_PROFILE(scip, "geomean/reverseprop");
+   assert(nlhdlrexprdata != NULL);
+   assert(infeasible != NULL);
+   assert(nreductions != NULL);
+
+   *infeasible = FALSE;
+   *nreductions = 0;
+
+   SCIP_NLHDLREXPRDATA* data = nlhdlrexprdata;
+   int nargs = (int) data->args.size();
+   int nterms = nargs + (int) data->linexprs.size();
+
+   /* bounds of the sum of terms */
+   SCIP_Real lower = bounds.inf;
+   SCIP_Real upper = bounds.sup;
+   if( data->logsum )
+   {
+      if( lower > -SCIP_INTERVAL_INFINITY )
+         lower -= data->coef;
+      if( upper < SCIP_INTERVAL_INFINITY )
+         upper -= data->coef;
+   }
+   else
+   {
+      lower = lower > 0.0 ? log(lower / data->coef) : -SCIP_INTERVAL_INFINITY;
+      if( upper < SCIP_INTERVAL_INFINITY )
+      {
+         if( upper < 0.0 )
+         {
+            *infeasible = TRUE;
+            return SCIP_OKAY;
+         }
+         upper = upper > 0.0 ? log(upper / data->coef) : -SCIP_INTERVAL_INFINITY;
+      }
+   }
+
+   /* term intervals, with the number of infinite bounds, so that the sum of the others is available for each term */
+   vector<SCIP_Real> tmin(nterms);
+   vector<SCIP_Real> tmax(nterms);
+   SCIP_Real summin = 0.0;
+   SCIP_Real summax = 0.0;
+   int ninfmin = 0;
+   int ninfmax = 0;
+   for( int k = 0; k < nterms; k++ )
+   {
+      if( k < nargs )
+         termInterval(data, k, SCIPexprGetActivity(data->args[k]), &tmin[k], &tmax[k]);
+      else
+      {
+         SCIP_INTERVAL b = SCIPexprGetActivity(data->linexprs[k - nargs]);
+         SCIP_Real d = data->lincoefs[k - nargs];
+         tmin[k] = d > 0.0 ? (b.inf <= -SCIP_INTERVAL_INFINITY ? -SCIP_INTERVAL_INFINITY : d * b.inf)
+            : (b.sup >= SCIP_INTERVAL_INFINITY ? -SCIP_INTERVAL_INFINITY : d * b.sup);
+         tmax[k] = d > 0.0 ? (b.sup >= SCIP_INTERVAL_INFINITY ? SCIP_INTERVAL_INFINITY : d * b.sup)
+            : (b.inf <= -SCIP_INTERVAL_INFINITY ? SCIP_INTERVAL_INFINITY : d * b.inf);
+      }
+
+      if( tmin[k] <= -SCIP_INTERVAL_INFINITY )
+         ninfmin++;
+      else
+         summin += tmin[k];
+      if( tmax[k] >= SCIP_INTERVAL_INFINITY )
+         ninfmax++;
+      else
+         summax += tmax[k];
+   }
+
+   for( int k = 0; k < nterms; k++ )
+   {
+      /* bounds on the term from the bounds of the others */
+      SCIP_Real termub = SCIP_INTERVAL_INFINITY;
+      SCIP_Real termlb = -SCIP_INTERVAL_INFINITY;
+      SCIP_Bool minfinite = ninfmin == 0 || (ninfmin == 1 && tmin[k] <= -SCIP_INTERVAL_INFINITY);
+      SCIP_Bool maxfinite = ninfmax == 0 || (ninfmax == 1 && tmax[k] >= SCIP_INTERVAL_INFINITY);
+      if( upper < SCIP_INTERVAL_INFINITY && minfinite )
+         termub = upper - (summin - (tmin[k] <= -SCIP_INTERVAL_INFINITY ? 0.0 : tmin[k]));
+      if( lower > -SCIP_INTERVAL_INFINITY && maxfinite )
+         termlb = lower - (summax - (tmax[k] >= SCIP_INTERVAL_INFINITY ? 0.0 : tmax[k]));
+      if( termub >= SCIP_INTERVAL_INFINITY && termlb <= -SCIP_INTERVAL_INFINITY )
+         continue;
+
+      /* bounds on the argument */
+      SCIP_INTERVAL newbounds;
+      SCIP_EXPR* arg;
+      if( k < nargs )
+      {
+         SCIP_Real p = data->exps[k];
+         arg = data->args[k];
+         newbounds.inf = termlb <= -SCIP_INTERVAL_INFINITY ? 0.0 : exp(MIN(termlb / p, 700.0));
+         newbounds.sup = termub >= SCIP_INTERVAL_INFINITY ? SCIP_INTERVAL_INFINITY : exp(MIN(termub / p, 700.0));
+      }
+      else
+      {
+         SCIP_Real d = data->lincoefs[k - nargs];
+         arg = data->linexprs[k - nargs];
+         if( d > 0.0 )
+         {
+            newbounds.inf = termlb <= -SCIP_INTERVAL_INFINITY ? -SCIP_INTERVAL_INFINITY : termlb / d;
+            newbounds.sup = termub >= SCIP_INTERVAL_INFINITY ? SCIP_INTERVAL_INFINITY : termub / d;
+         }
+         else
+         {
+            newbounds.inf = termub >= SCIP_INTERVAL_INFINITY ? -SCIP_INTERVAL_INFINITY : termub / d;
+            newbounds.sup = termlb <= -SCIP_INTERVAL_INFINITY ? SCIP_INTERVAL_INFINITY : termlb / d;
+         }
+      }
+
+      int nred = 0;
+      SCIP_CALL( SCIPtightenExprIntervalNonlinear(scip, arg, newbounds, infeasible, &nred) );
+      *nreductions += nred;
+      if( *infeasible )
+         break;
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * nonlinear handler specific interface methods
+ */
+
+/** includes the geometric mean nonlinear handler in the nonlinear constraint handler */
+SCIP_RETCODE SCIPincludeNlhdlrGeomean(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_NLHDLR* nlhdlr;
+
+   SCIP_CALL( SCIPincludeNlhdlrNonlinear(scip, &nlhdlr, NLHDLR_NAME, NLHDLR_DESC, NLHDLR_DETECTPRIORITY,
+         NLHDLR_ENFOPRIORITY, nlhdlrDetectGeomean, nlhdlrEvalauxGeomean, NULL) );
+   assert(nlhdlr != NULL);
+
+   SCIPnlhdlrSetCopyHdlr(nlhdlr, nlhdlrCopyhdlrGeomean);
+   SCIPnlhdlrSetFreeExprData(nlhdlr, nlhdlrFreeExprDataGeomean);
+   SCIPnlhdlrSetSepa(nlhdlr, NULL, NULL, nlhdlrEstimateGeomean, NULL);
+   SCIPnlhdlrSetProp(nlhdlr, nlhdlrIntevalGeomean, nlhdlrReversepropGeomean);
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,43 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   nlhdlr_geomean.h
+ * @brief  nonlinear handler for geometric means and sums of logarithms
+ * @author Liding Xu
+ *
+ * The handler detects the two forms of the D-optimal objective:
+ *  - a product coef * prod_k x_k^p_k with coef > 0, p_k > 0 and sum_k p_k <= 1, e.g., the geometric mean
+ *    prod_j J_jj^(1/dim), which is concave on the nonnegative orthant;
+ *  - a sum sum_k c_k log(x_k) + sum_l d_l y_l + constant with c_k > 0 and variables y_l, e.g., the log-determinant
+ *    form sum_j log(J_jj) / dim - obj.
+ *
+ * Both are overestimated by their tangent plane at the LP point, which is an exact supporting hyperplane, without
+ * auxiliary variables for the factors or logarithms. The handler also evaluates the activity from the bounds of the
+ * x_k and propagates bounds of the expression back to the x_k, e.g., from obj_var to the diagonal of J.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_NLHDLR_GEOMEAN_H__
+#define __SCIP_NLHDLR_GEOMEAN_H__
+
+#include "scip/scip.h"
+
+/** includes the geometric mean nonlinear handler in the nonlinear constraint handler */
+SCIP_RETCODE SCIPincludeNlhdlrGeomean(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#endif
@@ -0,0 +1,227 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   online.cpp
+ * @brief  online design mode: appends candidate points to a live design problem
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <fstream>
+#include <string>
+
+#include "online.h"
+#include "probdata.h"
+#include "sepa_cone.h"
+
+using namespace scip;
+using namespace std;
+
+
+/** appends points to the design problem of a SCIP instance and keeps the incumbent design and the root cone cuts */
+SCIP_RETCODE SCIPappendDesignPoints(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const vector<vector<SCIP_Real> >& points, /**< the new points, each with dim entries */
+   SCIP_Bool*            keptsol,            /**< pointer to store whether the incumbent design was kept, or NULL */
+   int*                  nkeptcuts           /**< pointer to store the number of root cuts kept, or NULL */
+   )
+{
+   if( keptsol != NULL )
+      *keptsol = FALSE;
+   if( nkeptcuts != NULL )
+      *nkeptcuts = 0;
+
+   if( SCIPgetStage(scip) < SCIP_STAGE_PROBLEM || SCIPgetStage(scip) == SCIP_STAGE_SOLVING )
+   {
+      SCIPerrorMessage("points can only be appended to a design problem between solves\n");
+      return SCIP_INVALIDCALL;
+   }
+   ProbData* curdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( curdata == NULL )
+   {
+      SCIPerrorMessage("the problem is not a design problem\n");
+      return SCIP_INVALIDCALL;
+   }
+
+   /* the points are checked before the transformation is freed, so a rejected append keeps the solve */
+   if( curdata->has_knapcons )
+   {
+      SCIPerrorMessage("points cannot be appended to a problem with a knapsack constraint\n");
+      return SCIP_INVALIDCALL;
+   }
+   for( size_t k = 0; k < points.size(); k++ )
+   {
+      if( (int) points[k].size() != curdata->dim )
+      {
+         SCIPerrorMessage("appended point %d has %d entries, but the dimension is %d\n", (int) k,
+            (int) points[k].size(), curdata->dim);
+         return SCIP_INVALIDDATA;
+      }
+   }
+
+   /* the design of the incumbent and the root cuts of the last solve; the points of the design are taken from the
+    * transformed problem, since they may have been priced in
+    */
+   vector<int> design;
+   vector<SepaCone::ConeCut> cuts;
+   if( SCIPgetStage(scip) > SCIP_STAGE_PROBLEM )
+   {
+      ProbData* transdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+      SCIP_SOL* sol = SCIPgetBestSol(scip);
+      if( sol != NULL )
+      {
+         for( int i = 0; i < transdata->numvars; i++ )
+         {
+            if( transdata->hasPoint(i) && SCIPgetSolVal(scip, sol, transdata->bin_vars[i]) > 0.5 )
+               design.push_back(i);
+         }
+      }
+
+      SepaCone* sepa = dynamic_cast<SepaCone*>(SCIPfindObjSepa(scip, "conegrid"));
+      if( sepa != NULL )
+         sepa->takeRootCuts(cuts);
+
+      SCIP_CALL( SCIPfreeTransform(scip) );
+   }
+   assert(SCIPgetStage(scip) == SCIP_STAGE_PROBLEM);
+
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   assert(probdata != NULL && probdata->orig_data == NULL);
+
+   SCIP_CALL( probdata->appendPoints(scip, points) );
+
+   /* points of the design that were priced in become part of the original problem */
+   for( size_t k = 0; k < design.size(); k++ )
+   {
+      if( !probdata->hasPoint(design[k]) )
+      {
+         SCIP_CALL( probdata->addPoint(scip, design[k], 0.0) );
+      }
+   }
+
+   if( !design.empty() && probdata->designObjective(design) != SCIP_INVALID )
+   {
+      SCIP_SOL* sol;
+      SCIP_Bool stored;
+      SCIP_CALL( probdata->createDesignSol(scip, design, &sol) );
+      SCIP_CALL( SCIPaddSolFree(scip, &sol, &stored) );
+      if( keptsol != NULL )
+         *keptsol = TRUE;
+   }
+
+   /* the cuts of points that were priced in and are not in the design have no columns in the original problem */
+   for( size_t k = 0; k < cuts.size(); k++ )
+   {
+      if( !probdata->hasPoint(cuts[k].i) )
+         continue;
+      SCIP_CALL( probdata->addConeCut(scip, cuts[k].i, cuts[k].j, cuts[k].coefs) );
+      if( nkeptcuts != NULL )
+         (*nkeptcuts)++;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** reads points from a file with the header "npoints dim" and npoints rows of dim entries */
+SCIP_RETCODE readDesignPoints(
+   const char*           filename,           /**< name of the input file */
+   int                   dim,                /**< dimension of the problem */
+   vector<vector<SCIP_Real> >& points        /**< vector to store the points */
+   )
+{
+   ifstream filedata(filename);
+   if( !filedata )
+      return SCIP_NOFILE;
+
+   int npoints;
+   int filedim;
+   filedata >> npoints >> filedim;
+   if( !filedata || npoints < 0 )
+      return SCIP_READERROR;
+   if( filedim != dim )
+   {
+      SCIPerrorMessage("points of <%s> have dimension %d, but the problem has dimension %d\n", filename, filedim, dim);
+      return SCIP_READERROR;
+   }
+
+   points.assign(npoints, vector<SCIP_Real>(dim, 0.0));
+   for( int k = 0; k < npoints; k++ )
+   {
+      for( int j = 0; j < dim; j++ )
+         filedata >> points[k][j];
+   }
+
+   return filedata ? SCIP_OKAY : SCIP_READERROR;
+}
+
+
+/** execution method of dialog */
+SCIP_DECL_DIALOGEXEC(DialogAppend::scip_exec)
+{
+   char* filename;
+   SCIP_Bool endoffile;
+
+   SCIP_CALL( SCIPdialoghdlrGetWord(dialoghdlr, dialog, "enter filename: ", &filename, &endoffile) );
+   *nextdialog = SCIPdialoghdlrGetRoot(dialoghdlr);
+   if( endoffile )
+   {
+      *nextdialog = NULL;
+      return SCIP_OKAY;
+   }
+   if( filename[0] == '\0' )
+      return SCIP_OKAY;
+   SCIP_CALL( SCIPdialoghdlrAddHistory(dialoghdlr, dialog, filename, TRUE) );
+
+   ProbData* probdata = SCIPgetStage(scip) >= SCIP_STAGE_PROBLEM ? dynamic_cast<ProbData*>(SCIPgetObjProbData(scip))
+      : NULL;
+   if( probdata == NULL )
+   {
+      SCIPdialogMessage(scip, NULL, "no design problem exists\n");
+      return SCIP_OKAY;
+   }
+
+   SCIP_CLOCK* clock;
+   SCIP_CALL( SCIPcreateClock(scip, &clock) );
+   SCIP_CALL( SCIPstartClock(scip, clock) );
+
+   vector<vector<SCIP_Real> > points;
+   SCIP_RETCODE retcode = readDesignPoints(filename, probdata->dim, points);
+   if( retcode != SCIP_OKAY )
+   {
+      SCIPdialogMessage(scip, NULL, "error reading points from <%s>\n", filename);
+      SCIP_CALL( SCIPfreeClock(scip, &clock) );
+      return SCIP_OKAY;
+   }
+
+   SCIP_Bool keptsol;
+   int nkeptcuts;
+   retcode = SCIPappendDesignPoints(scip, points, &keptsol, &nkeptcuts);
+   SCIP_CALL( SCIPstopClock(scip, clock) );
+   if( retcode != SCIP_OKAY )
+   {
+      SCIPdialogMessage(scip, NULL, "points of <%s> not appended (SCIP error %d)\n", filename, (int) retcode);
+      SCIP_CALL( SCIPfreeClock(scip, &clock) );
+      return SCIP_OKAY;
+   }
+
+   probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   SCIPdialogMessage(scip, NULL, "appended %d points in %.3f s: %d points, incumbent %s, %d root cuts kept\n",
+      (int) points.size(), SCIPgetClockTime(scip, clock), probdata->numvars, keptsol ? "kept" : "none", nkeptcuts);
+   SCIP_CALL( SCIPfreeClock(scip, &clock) );
+
+   return SCIP_OKAY;
+}
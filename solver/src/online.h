@@ -0,0 +1,84 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   online.h
+ * @brief  online design mode: appends candidate points to a live design problem
+ * @author Liding Xu
+ *
+ * New points are appended to the original problem: the binary, the Z and t columns and the cones of each point are
+ * added, and its coefficients are added to the rows A Z = J, sum_i t_ij <= J_jj and the cardinality constraint; the
+ * rest of the model is kept. If the problem was solved, its transformation is freed first, but two things of the
+ * solve are carried over to the next one:
+ *
+ *  - the design of the incumbent, as a starting solution; it stays feasible, since the new points are not used,
+ *  - the gradient cuts of the cones found by the separator "conegrid" at the root node, as removable rows of the
+ *    initial LP; a cut only involves the cone of its point, so it stays valid for the larger problem.
+ *
+ * In pricing mode, the new points are only appended to the data and enter the model through the pricer; the points
+ * of the incumbent that were priced in are added to the original problem. Problems with a knapsack constraint and
+ * points of the wrong dimension are rejected before the transformation is freed, so the solve is kept.
+ *
+ * The dialog "append <file>" reads the points from a file with the header "npoints dim" and npoints rows of dim
+ * entries; "optimize" then solves the larger problem.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_ONLINE_H__
+#define __SCIP_ONLINE_H__
+
+#include <vector>
+#include "objscip/objscip.h"
+
+
+/** appends points to the design problem of a SCIP instance and keeps the incumbent design and the root cone cuts */
+SCIP_RETCODE SCIPappendDesignPoints(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const std::vector<std::vector<SCIP_Real> >& points, /**< the new points, each with dim entries */
+   SCIP_Bool*            keptsol,            /**< pointer to store whether the incumbent design was kept, or NULL */
+   int*                  nkeptcuts           /**< pointer to store the number of root cuts kept, or NULL */
+   );
+
+/** reads points from a file with the header "npoints dim" and npoints rows of dim entries */
+SCIP_RETCODE readDesignPoints(
+   const char*           filename,           /**< name of the input file */
+   int                   dim,                /**< dimension of the problem */
+   std::vector<std::vector<SCIP_Real> >& points /**< vector to store the points */
+   );
+
+
+/** dialog "append <file>" that appends the points of a file to the design problem */
+class DialogAppend : public scip::ObjDialog
+{
+public:
+   /** default constructor */
+   DialogAppend(
+      SCIP*              scip                /**< SCIP data structure */
+      )
+      : ObjDialog(scip, "append", "append the candidate points of a file to the design problem", FALSE)
+   {
+   }
+
+   /** destructor */
+   virtual ~DialogAppend()
+   {
+   }
+
+   /** execution method of dialog */
+   virtual SCIP_DECL_DIALOGEXEC(scip_exec);
+};/*lint !e1712*/
+
+
+#endif
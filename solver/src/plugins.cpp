@@ -0,0 +1,90 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   plugins.cpp
+ * @brief  inclusion of the plugins and the default parameters of the design solver
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include "scip/scipdefplugins.h"
+
+#include "plugins.h"
+#include "reader_sub.h"
+#include "event_trace.h"
+#include "event_exact.h"
+#include "event_cache.h"
+#include "pricer_design.h"
+#include "nlhdlr_geomean.h"
+#include "sepa_cone.h"
+#include "table_mem.h"
+#include "online.h"
+#include "dialog_export.h"
+#include "prop_dbounds.h"
+#include "prop_enum.h"
+#include "heur_designlns.h"
+#include "heur_designround.h"
+#include "cutsel_design.h"
+#include "table_profile.h"
+
+/** includes the default SCIP plugins and the plugins of the D-optimal design problem */
+SCIP_RETCODE SCIPincludeDesignPlugins(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   /* include default SCIP plugins */
+   SCIP_CALL( SCIPincludeDefaultPlugins(scip) );
+
+   /* include submodular problem plugins */
+   SCIP_CALL( SCIPincludeObjReader(scip, new ReaderSubmodular(scip), TRUE));
+   SCIP_CALL( SCIPincludeObjReader(scip, new ReaderSubmodularCompressed(scip, "readergz", "gz"), TRUE));
+   SCIP_CALL( SCIPincludeObjReader(scip, new ReaderSubmodularCompressed(scip, "readerzst", "zst"), TRUE));
+   SCIP_CALL( SCIPincludeObjEventhdlr(scip, new EventhdlrTrace(scip), TRUE));
+   SCIP_CALL( SCIPincludeObjEventhdlr(scip, new EventhdlrExact(scip), TRUE));
+   SCIP_CALL( SCIPincludeObjEventhdlr(scip, new EventhdlrCache(scip), TRUE));
+   SCIP_CALL( SCIPincludeObjPricer(scip, new PricerDesign(scip), TRUE));
+   SCIP_CALL( SCIPincludeNlhdlrGeomean(scip) );
+   SCIP_CALL( SCIPincludeObjSepa(scip, new SepaCone(scip), TRUE) );
+   SCIP_CALL( SCIPincludeObjProp(scip, new PropDesignBounds(scip), TRUE) );
+   SCIP_CALL( SCIPincludeObjProp(scip, new PropEnumerate(scip), TRUE) );
+   SCIP_CALL( SCIPincludeObjHeur(scip, new HeurDesignLns(scip), TRUE) );
+   SCIP_CALL( SCIPincludeObjHeur(scip, new HeurDesignRound(scip), TRUE) );
+   SCIP_CALL( SCIPincludeObjCutsel(scip, new CutselDesign(scip), TRUE) );
+
+   TableMemory* table = new TableMemory(scip);
+   SCIP_CALL( SCIPincludeObjTable(scip, table, TRUE) );
+   SCIP_CALL( SCIPincludeObjEventhdlr(scip, new EventhdlrMemory(scip, table), TRUE) );
+   SCIP_CALL( SCIPincludeObjTable(scip, new TableProfile(scip), TRUE) );
+   SCIP_CALL( SCIPincludeObjDialog(scip, new DialogAppend(scip), TRUE) );
+   SCIP_CALL( SCIPincludeObjDialog(scip, new DialogExport(scip), TRUE) );
+
+   SCIP_CALL( SCIPsetDesignParams(scip) );
+
+   return SCIP_OKAY;
+}
+
+/** sets the parameters that the design solver changes from the SCIP defaults */
+SCIP_RETCODE SCIPsetDesignParams(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_CALL(SCIPsetRealParam(scip, "limits/gap", 1e-4));
+   SCIP_CALL(SCIPsetRealParam(scip, "limits/absgap", 1e-6));
+   SCIP_CALL(SCIPsetRealParam(scip, "limits/time", 3600));
+   SCIP_CALL(SCIPsetIntParam(scip, "timing/clocktype", 1));
+
+   return SCIP_OKAY;
+}
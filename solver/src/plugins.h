@@ -0,0 +1,38 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   plugins.h
+ * @brief  inclusion of the plugins and the default parameters of the design solver
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_PLUGINS_DESIGN_H__
+#define __SCIP_PLUGINS_DESIGN_H__
+
+#include "scip/scip.h"
+
+/** includes the default SCIP plugins and the plugins of the D-optimal design problem */
+SCIP_RETCODE SCIPincludeDesignPlugins(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** sets the parameters that the design solver changes from the SCIP defaults */
+SCIP_RETCODE SCIPsetDesignParams(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#endif
@@ -0,0 +1,209 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   pricer_design.cpp
+ * @brief  pricer that adds design points to the model on demand
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <limits.h>
+#include <algorithm>
+#include <utility>
+
+#include "pricer_design.h"
+#include "probdata.h"
+#include "table_profile.h"
+#include "scip/cons_linear.h"
+
+using namespace scip;
+using namespace std;
+
+#define PRICER_NAME            "design"
+#define PRICER_DESC            "pricer for the points of a D-optimal design problem"
+#define PRICER_PRIORITY        0
+#define PRICER_DELAY           TRUE          /* only call pricer if all problem variables have non-negative reduced costs */
+
+#define DEFAULT_MAXPOINTS      10            /**< maximal number of points added in a pricing round */
+
+#define BLOCKSIZE              64            /**< number of points whose coefficients c are computed together */
+
+
+/** default constructor */
+PricerDesign::PricerDesign(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjPricer(scip, PRICER_NAME, PRICER_DESC, PRICER_PRIORITY, PRICER_DELAY),
+     maxpoints_(DEFAULT_MAXPOINTS),
+     npriced_(0),
+     nrounds_(0)
+{
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "pricers/" PRICER_NAME "/maxpoints",
+         "maximal number of points added in a pricing round",
+         &maxpoints_, FALSE, DEFAULT_MAXPOINTS, 1, INT_MAX, NULL, NULL) );
+}
+
+
+/** solving process initialization method of variable pricer (called when branch and bound process is about to begin) */
+SCIP_DECL_PRICERINITSOL(PricerDesign::scip_initsol)
+{
+   npriced_ = 0;
+   nrounds_ = 0;
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of variable pricer (called before branch and bound process data is freed) */
+SCIP_DECL_PRICEREXITSOL(PricerDesign::scip_exitsol)
+{
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "design pricer: %d points added in %d pricing rounds\n",
+      npriced_, nrounds_);
+
+   return SCIP_OKAY;
+}
+
+
+/** reduced cost pricing method of variable pricer for feasible LPs */
+SCIP_DECL_PRICERREDCOST(PricerDesign::scip_redcost)
+{
+   DOPT_PROFILE(scip, "design/redcost");
+   SCIP_CALL( price(scip, FALSE, lowerbound) );
+   *result = SCIP_SUCCESS;
+
+   return SCIP_OKAY;
+}
+
+
+/** farkas pricing method of variable pricer for infeasible LPs */
+SCIP_DECL_PRICERFARKAS(PricerDesign::scip_farkas)
+{
+   DOPT_PROFILE(scip, "design/farkas");
+   SCIP_CALL( price(scip, TRUE, NULL) );
+   *result = SCIP_SUCCESS;
+
+   return SCIP_OKAY;
+}
+
+
+/** computes the reduced costs of the points that are not in the model and adds the best ones */
+SCIP_RETCODE PricerDesign::price(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_Bool             farkas,             /**< use the Farkas proof of an infeasible LP instead of the duals? */
+   SCIP_Real*            lowerbound          /**< pointer to store a lower bound of the node, or NULL */
+   )
+{
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   assert(probdata != NULL);
+   assert(probdata->use_pricing);
+
+   int dim = probdata->dim;
+   int numvars = probdata->numvars;
+   SCIP_Real tol = SCIPdualfeastol(scip);
+
+   /* duals of the rows that contain the columns of a point */
+   vector<SCIP_Real> pi(dim * dim, 0.0);
+   vector<SCIP_Real> mu(dim);
+   for( int j1 = 0; j1 < dim; j1++ )
+   {
+      for( int j2 = j1; j2 < dim; j2++ )
+      {
+         SCIP_CONS* cons = probdata->azj_conss[j1][j2];
+         pi[j1 * dim + j2] = farkas ? SCIPgetDualfarkasLinear(scip, cons) : SCIPgetDualsolLinear(scip, cons);
+      }
+      SCIP_CONS* cons = probdata->sumt_conss[j1];
+      mu[j1] = farkas ? SCIPgetDualfarkasLinear(scip, cons) : SCIPgetDualsolLinear(scip, cons);
+   }
+   SCIP_Real sigma = farkas ? SCIPgetDualfarkasLinear(scip, probdata->card_cons)
+      : SCIPgetDualsolLinear(scip, probdata->card_cons);
+
+   /* reduced costs of the points that are not in the model; the coefficients c_j of a block of points are computed
+    * row by row of A, which reads A contiguously
+    */
+   vector<pair<SCIP_Real, int>> candidates;
+   vector<SCIP_Real> c(dim * BLOCKSIZE);
+   SCIP_Real sumrc = 0.0;
+   SCIP_Bool boundvalid = TRUE;
+   for( int i0 = 0; i0 < numvars; i0 += BLOCKSIZE )
+   {
+      int nb = MIN(BLOCKSIZE, numvars - i0);
+
+      c.assign(dim * BLOCKSIZE, 0.0);
+      for( int j1 = 0; j1 < dim; j1++ )
+      {
+         const SCIP_Real* arow = &probdata->A[j1][i0];
+         for( int j2 = j1; j2 < dim; j2++ )
+         {
+            SCIP_Real p = pi[j1 * dim + j2];
+            if( p == 0.0 )
+               continue;
+            SCIP_Real* cj = &c[j2 * BLOCKSIZE];
+            for( int b = 0; b < nb; b++ )
+               cj[b] += p * arow[b];
+         }
+      }
+
+      for( int b = 0; b < nb; b++ )
+      {
+         int i = i0 + b;
+         if( probdata->hasPoint(i) )
+            continue;
+
+         /* a sum row without dual leaves Z_ij unbounded in the Lagrangian if c_j != 0 */
+         SCIP_Real rc = -sigma;
+         SCIP_Bool unbounded = FALSE;
+         for( int j = 0; j < dim && !unbounded; j++ )
+         {
+            SCIP_Real cj = c[j * BLOCKSIZE + b];
+            if( mu[j] < -tol )
+               rc += cj * cj / (4.0 * mu[j]);
+            else if( REALABS(cj) > tol )
+               unbounded = TRUE;
+         }
+
+         if( unbounded )
+         {
+            rc = -SCIPinfinity(scip);
+            boundvalid = FALSE;
+         }
+         else
+            sumrc += MIN(rc, 0.0);
+
+         if( rc < -tol )
+            candidates.push_back(make_pair(rc, i));
+      }
+   }
+
+   /* add the points with the most negative reduced costs */
+   int nadd = MIN((int) candidates.size(), maxpoints_);
+   partial_sort(candidates.begin(), candidates.begin() + nadd, candidates.end());
+   for( int k = 0; k < nadd; k++ )
+   {
+      SCIP_CALL( probdata->addPoint(scip, candidates[k].second, -candidates[k].first) );
+   }
+
+   npriced_ += nadd;
+   nrounds_++;
+
+   if( !farkas && boundvalid && lowerbound != NULL )
+      *lowerbound = SCIPgetLPObjval(scip) + sumrc;
+
+   SCIPdebugMsg(scip, "%s pricing: %d points with negative reduced cost, %d added\n", farkas ? "Farkas" : "redcost",
+      (int) candidates.size(), nadd);
+
+   return SCIP_OKAY;
+}
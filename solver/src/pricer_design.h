@@ -0,0 +1,82 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   pricer_design.h
+ * @brief  pricer that adds design points to the model on demand
+ * @author Liding Xu
+ *
+ * In pricing mode, the reader builds the model with a small working set of points. A point i that is not in the model
+ * enters the rows A Z = J with its columns Z_i, the rows sum_i t_ij <= J_jj with its columns t_i, and the cardinality
+ * constraint with its binary w_i; its cones Z_ij^2 <= t_ij w_i are not part of any row. Given the duals pi of A Z = J,
+ * mu <= 0 of the sum rows and sigma of the cardinality constraint, the Lagrangian of the point over its cones at w_i = 1
+ * is minimized by Z_ij = -c_j / (2 mu_j) with c_j = sum_{j1 <= j} pi_{j1,j} a_{j1,i}, which gives the reduced cost
+ *
+ *    rc_i = sum_j c_j^2 / (4 mu_j) - sigma.
+ *
+ * Points with negative reduced cost are added with their cones. Since the cones of the points in the model are only
+ * relaxed in the LP, LP value + sum_i min(rc_i, 0) is a valid lower bound of the node, and if no point has negative
+ * reduced cost, the LP bound is valid for the model with all points.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_PRICER_DESIGN_H__
+#define __SCIP_PRICER_DESIGN_H__
+
+#include <vector>
+#include "objscip/objscip.h"
+
+
+/** pricer for the points of a D-optimal design problem */
+class PricerDesign : public scip::ObjPricer
+{
+public:
+   /** default constructor */
+   PricerDesign(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~PricerDesign()
+   {
+   }
+
+   /** solving process initialization method of variable pricer (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_PRICERINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of variable pricer (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_PRICEREXITSOL(scip_exitsol);
+
+   /** reduced cost pricing method of variable pricer for feasible LPs */
+   virtual SCIP_DECL_PRICERREDCOST(scip_redcost);
+
+   /** farkas pricing method of variable pricer for infeasible LPs */
+   virtual SCIP_DECL_PRICERFARKAS(scip_farkas);
+
+private:
+   /** computes the reduced costs of the points that are not in the model and adds the best ones */
+   SCIP_RETCODE price(
+      SCIP*              scip,               /**< SCIP data structure */
+      SCIP_Bool          farkas,             /**< use the Farkas proof of an infeasible LP instead of the duals? */
+      SCIP_Real*         lowerbound          /**< pointer to store a lower bound of the node, or NULL */
+      );
+
+   int                   maxpoints_;         /**< maximal number of points added in a pricing round */
+   int                   npriced_;           /**< number of points added in the current solve */
+   int                   nrounds_;           /**< number of pricing rounds in the current solve */
+};/*lint !e1712*/
+
+
+#endif
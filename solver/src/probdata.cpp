@@ -24,6 +24,10 @@
 #include <math.h> 
 
 #include "probdata.h"
+#include "linalg.h"
+#include "conekernel.h"
+#include "laplacian.h"
+#include "table_profile.h"
 #include "objscip/objscip.h"
 #include "scip/struct_cons.h"
 #include "scip/cons_linear.h"
@@ -42,6 +46,146 @@ using namespace std;
 
 
 
+/** adds a variable to the problem; during solving, it is added as priced variable with the given score */
+static
+SCIP_RETCODE addModelVar(
+	SCIP*                 scip,               /**< SCIP data structure */
+	SCIP_VAR*             var,                /**< variable to add */
+	SCIP_Real             score               /**< pricing score of the variable */
+) {
+	if(SCIPgetStage(scip) == SCIP_STAGE_SOLVING){
+		SCIP_CALL(SCIPaddPricedVar(scip, var, score));
+	}
+	else{
+		SCIP_CALL(SCIPaddVar(scip, var));
+	}
+	return SCIP_OKAY;
+}
+
+
+/** creates a linear row lhs <= sum vals * vars <= rhs of the polyhedral cone approximation, adds it to the problem
+ *  and stores it in conss
+ */
+static
+SCIP_RETCODE addPolyRow(
+	SCIP*                 scip,               /**< SCIP data structure */
+	vector<SCIP_CONS*>&   conss,              /**< model constraints */
+	const string&         name,               /**< name of the row */
+	int                   nvars,              /**< number of variables in the row */
+	SCIP_VAR**            vars,               /**< variables of the row */
+	SCIP_Real*            vals,               /**< coefficients of the variables */
+	SCIP_Real             lhs,                /**< left hand side */
+	SCIP_Real             rhs                 /**< right hand side */
+) {
+	SCIP_CONS* cons;
+	SCIP_CALL(SCIPcreateConsLinear(
+		scip,               /**< SCIP data structure */
+		&cons,              /**< pointer to hold the created constraint */
+		name.c_str(),       /**< name of constraint */
+		nvars,              /**< number of variables in the constraint */
+		vars,               /**< array with variables of constraint entries */
+		vals,               /**< array with coefficients of constraint entries */
+		lhs,                /**< left hand side of constraint */
+		rhs,                /**< right hand side of constraint */
+		TRUE,               /**< should the LP relaxation of constraint be in the initial LP? */
+		TRUE,               /**< should the constraint be separated during LP processing? */
+		TRUE,               /**< should the constraint be enforced during node processing? */
+		TRUE,               /**< should the constraint be checked for feasibility? */
+		TRUE,               /**< should the constraint be propagated during node processing? */
+		FALSE,              /**< is constraint only valid locally? */
+		FALSE,              /**< is constraint modifiable (subject to column generation)? */
+		FALSE,              /**< is constraint subject to aging? */
+		FALSE,              /**< should the relaxation be removed from the LP due to aging or cleanup? */
+		FALSE               /**< should the constraint always be kept at the node where it was added? */
+	));
+	SCIP_CALL(SCIPaddCons(scip, cons));
+	SCIP_CALL(SCIPcaptureCons(scip, cons));
+	conss.push_back(cons);
+	SCIP_CALL(SCIPreleaseCons(scip, &cons));
+	return SCIP_OKAY;
+}
+
+
+/** creates a cut sum vals * vars <= rhs that is implied by the model as removable row of the initial LP, adds it to the
+ *  problem and stores it in conss; the cut is separated when violated, but neither enforced nor checked
+ */
+static
+SCIP_RETCODE addCutRow(
+	SCIP*                 scip,               /**< SCIP data structure */
+	vector<SCIP_CONS*>&   conss,              /**< model constraints */
+	const string&         name,               /**< name of the row */
+	int                   nvars,              /**< number of variables in the row */
+	SCIP_VAR**            vars,               /**< variables of the row */
+	SCIP_Real*            vals,               /**< coefficients of the variables */
+	SCIP_Real             rhs                 /**< right hand side */
+) {
+	SCIP_CONS* cons;
+	SCIP_CALL(SCIPcreateConsLinear(
+		scip,               /**< SCIP data structure */
+		&cons,              /**< pointer to hold the created constraint */
+		name.c_str(),       /**< name of constraint */
+		nvars,              /**< number of variables in the constraint */
+		vars,               /**< array with variables of constraint entries */
+		vals,               /**< array with coefficients of constraint entries */
+		-SCIPinfinity(scip), /**< left hand side of constraint */
+		rhs,                /**< right hand side of constraint */
+		TRUE,               /**< should the LP relaxation of constraint be in the initial LP? */
+		TRUE,               /**< should the constraint be separated during LP processing? */
+		FALSE,              /**< should the constraint be enforced during node processing? */
+		FALSE,              /**< should the constraint be checked for feasibility? */
+		FALSE,              /**< should the constraint be propagated during node processing? */
+		FALSE,              /**< is constraint only valid locally? */
+		FALSE,              /**< is constraint modifiable (subject to column generation)? */
+		FALSE,              /**< is constraint subject to aging? */
+		TRUE,               /**< should the relaxation be removed from the LP due to aging or cleanup? */
+		FALSE               /**< should the constraint always be kept at the node where it was added? */
+	));
+	SCIP_CALL(SCIPaddCons(scip, cons));
+	SCIP_CALL(SCIPcaptureCons(scip, cons));
+	conss.push_back(cons);
+	SCIP_CALL(SCIPreleaseCons(scip, &cons));
+	return SCIP_OKAY;
+}
+
+
+/** returns the value of obj_var for the given log-determinant of the information matrix: the geometric mean of the
+ *  diagonal of J, or its mean logarithm shifted by the value of the empty design
+ */
+static
+SCIP_Real objFromLogdet(
+	SCIP_Bool             logdet_form,        /**< objective in log-determinant form? */
+	int                   dim,                /**< the problem dimension */
+	SCIP_Real             emptyvalue,         /**< value of the empty design */
+	SCIP_Real             logdet              /**< log-determinant of the information matrix */
+) {
+	return logdet_form ? logdet / dim - emptyvalue : exp(logdet / dim);
+}
+
+
+/** returns the bytes used by a vector */
+template <typename T>
+static
+size_t vectorBytes(
+	const vector<T>&      v                   /**< vector */
+) {
+	return sizeof(v) + v.capacity() * sizeof(T);
+}
+
+
+/** returns the bytes used by a vector of vectors */
+template <typename T>
+static
+size_t gridBytes(
+	const vector<vector<T>>& v                /**< vector of vectors */
+) {
+	size_t bytes = sizeof(v) + (v.capacity() - v.size()) * sizeof(vector<T>);
+	for(size_t i = 0; i < v.size(); i++){
+		bytes += vectorBytes(v[i]);
+	}
+	return bytes;
+}
+
+
 /** ProbData destructor */
 ProbData::~ProbData()
 {
@@ -49,36 +193,57 @@ ProbData::~ProbData()
 }
 
 
+/** releases a captured variable of the problem data; a failed copy leaves NULL entries */
+static
+SCIP_RETCODE releaseVar(
+	SCIP*                 scip,               /**< SCIP data structure */
+	SCIP_VAR**            var                 /**< pointer to the variable, or to NULL */
+) {
+	if(*var != NULL){
+		SCIP_CALL(SCIPreleaseVar(scip, var));
+	}
+	return SCIP_OKAY;
+}
+
+
 /** release scip reference in probelme data*/
 SCIP_RETCODE ProbData::releaseAll(
 	SCIP*              scip                /**< SCIP data structure */
 ) {
 	// release
 	for (int i = 0; i < bin_vars.size(); i++) {
-		SCIP_CALL(SCIPreleaseVar(scip, &bin_vars[i]));
+		SCIP_CALL(releaseVar(scip, &bin_vars[i]));
 	}
 
 
+	// points that are not in the model have no columns
 	for(int i = 0; i < numvars; i++){
-		for(int j = 0; j < dim; j++){
-			SCIP_CALL(SCIPreleaseVar(scip, &Z[i][j]));
-			SCIP_CALL(SCIPreleaseVar(scip, &t[i][j]));
+		for(int j = 0; j < Z[i].size(); j++){
+			SCIP_CALL(releaseVar(scip, &Z[i][j]));
+			SCIP_CALL(releaseVar(scip, &t[i][j]));
 		}
 	}
 
 	for(int j = 0; j < dim; j++){
-		SCIP_CALL(SCIPreleaseVar(scip, &t[numvars][j]));
+		SCIP_CALL(releaseVar(scip, &t[numvars][j]));
 	}
 
 	for(int i = 0; i < dim; i++){
 		for(int j = 0; j < dim; j++){
-			SCIP_CALL(SCIPreleaseVar(scip, &J[i][j]));
-			SCIP_CALL(SCIPreleaseVar(scip, &epsZ2[i][j]));
-			SCIP_CALL(SCIPreleaseVar(scip, &epsZ[i][j]));
+			SCIP_CALL(releaseVar(scip, &J[i][j]));
+			SCIP_CALL(releaseVar(scip, &epsZ2[i][j]));
+			SCIP_CALL(releaseVar(scip, &epsZ[i][j]));
 		}
 	}
 
-	SCIP_CALL(SCIPreleaseVar(scip, &obj_var));
+	SCIP_CALL(releaseVar(scip, &obj_var));
+
+	for(int c = 0; c < poly_cones.size(); c++){
+		for(int j = 0; j < poly_cones[c].xi.size(); j++){
+			SCIP_CALL(releaseVar(scip, &poly_cones[c].xi[j]));
+			SCIP_CALL(releaseVar(scip, &poly_cones[c].eta[j]));
+		}
+	}
 
 	for (int i = 0; i < conss.size(); i++){
 		SCIP_CALL(SCIPreleaseCons(scip, &conss[i]));
@@ -130,6 +295,7 @@ SCIP_RETCODE ProbData::scip_trans(
    SCIP_Bool*         deleteobject        /**< pointer to store whether SCIP should delete the object after solving */
    )
 {  /*lint --e{715}*/
+   	DOPT_PROFILE(scip, "probdata/trans");
    	assert( objprobdata != NULL );
    	assert( deleteobject != NULL );
 
@@ -144,10 +310,18 @@ SCIP_RETCODE ProbData::scip_trans(
 	transprobdata->knapweights = knapweights;
 	transprobdata->is_nature  = is_nature;
 	transprobdata->gradient_cut = gradient_cut;
+	transprobdata->logdet_form = logdet_form;
+	transprobdata->poly_depth = poly_depth;
+	transprobdata->orig_data = this;
+	transprobdata->use_pricing = use_pricing;
+	transprobdata->init_points = init_points;
+	transprobdata->edges = edges;
 
 	SCIP_VAR* var;
 	for (int i = 0; i < bin_vars.size(); i++) {
-		SCIP_CALL(SCIPtransformVar(scip, bin_vars[i], &var));
+		var = NULL;
+		if(bin_vars[i] != NULL)
+			SCIP_CALL(SCIPtransformVar(scip, bin_vars[i], &var));
 		transprobdata->bin_vars.push_back(var);
 	}
 
@@ -155,7 +329,7 @@ SCIP_RETCODE ProbData::scip_trans(
 	for(int i = 0; i < numvars; i++){
 		transprobdata->Z.push_back(vector<SCIP_VAR*>());
 		transprobdata->t.push_back(vector<SCIP_VAR*>());
-		for(int j = 0; j < dim; j++){		
+		for(int j = 0; j < Z[i].size(); j++){		
 			SCIP_CALL(SCIPtransformVar(scip, Z[i][j], &var));
 			transprobdata->Z[i].push_back(var);
 			SCIP_CALL(SCIPtransformVar(scip, t[i][j], &var));
@@ -189,6 +363,23 @@ SCIP_RETCODE ProbData::scip_trans(
 	SCIP_CALL(SCIPtransformVar(scip, obj_var, &var));
 	transprobdata->obj_var = var;
 
+	// the variables u, v, w of a polyhedral cone are captured in Z, t, bin_vars or epsZ, epsZ2
+	for(int c = 0; c < poly_cones.size(); c++){
+		PolyCone cone;
+		SCIP_CALL(SCIPgetTransformedVar(scip, poly_cones[c].u, &cone.u));
+		SCIP_CALL(SCIPgetTransformedVar(scip, poly_cones[c].v, &cone.v));
+		cone.w = NULL;
+		if(poly_cones[c].w != NULL)
+			SCIP_CALL(SCIPgetTransformedVar(scip, poly_cones[c].w, &cone.w));
+		for(int j = 0; j < poly_cones[c].xi.size(); j++){
+			SCIP_CALL(SCIPtransformVar(scip, poly_cones[c].xi[j], &var));
+			cone.xi.push_back(var);
+			SCIP_CALL(SCIPtransformVar(scip, poly_cones[c].eta[j], &var));
+			cone.eta.push_back(var);
+		}
+		transprobdata->poly_cones.push_back(cone);
+	}
+
 	//SCIPdebugMessage("transform  4\n");
 
 	for (int i = 0; i < conss.size(); i++){
@@ -199,6 +390,22 @@ SCIP_RETCODE ProbData::scip_trans(
 		transprobdata->conss.push_back(cons);
 	}
 
+	// the rows that receive coefficients of priced points, all of them were transformed above
+	if(use_pricing){
+		transprobdata->azj_conss.assign(dim, vector<SCIP_CONS*>(dim, NULL));
+		for(int j1 = 0; j1 < dim; j1++){
+			for(int j2 = j1; j2 < dim; j2++){
+				SCIP_CALL(SCIPgetTransformedCons(scip, azj_conss[j1][j2], &transprobdata->azj_conss[j1][j2]));
+			}
+		}
+		for(int j = 0; j < dim; j++){
+			SCIP_CONS * cons;
+			SCIP_CALL(SCIPgetTransformedCons(scip, sumt_conss[j], &cons));
+			transprobdata->sumt_conss.push_back(cons);
+		}
+		SCIP_CALL(SCIPgetTransformedCons(scip, card_cons, &transprobdata->card_cons));
+	}
+
 	
 
    SCIPdebugMessage("end transform \n");
@@ -228,14 +435,410 @@ SCIP_RETCODE ProbData::scip_deltrans(
 
 
 
+/** gets the copy of a source variable in a target SCIP, or NULL if it or an earlier variable cannot be copied */
+static
+SCIP_RETCODE getVarCopy(
+	SCIP*                 scip,               /**< SCIP data structure of the copy */
+	SCIP*                 sourcescip,         /**< source SCIP data structure */
+	SCIP_VAR*             sourcevar,          /**< source variable */
+	SCIP_HASHMAP*         varmap,             /**< mapping of source variables to target variables */
+	SCIP_HASHMAP*         consmap,            /**< mapping of source constraints to target constraints */
+	SCIP_Bool             global,             /**< create a global or a local copy? */
+	SCIP_Bool             capture,            /**< should the copy be captured? */
+	SCIP_VAR**            targetvar,          /**< pointer to store the copy */
+	SCIP_Bool*            success             /**< pointer to the success of all copies, set to FALSE on failure */
+) {
+	*targetvar = NULL;
+	if(!*success)
+		return SCIP_OKAY;
+
+	SCIP_CALL(SCIPgetVarCopy(sourcescip, scip, sourcevar, targetvar, varmap, consmap, global, success));
+	if(!*success){
+		*targetvar = NULL;
+	}
+	else if(capture){
+		SCIP_CALL(SCIPcaptureVar(scip, *targetvar));
+	}
+	return SCIP_OKAY;
+}
+
+
+/** copies the user problem data of a source SCIP to the original problem of a copy, e.g., the sub-SCIP of a
+ *  large neighborhood search heuristic or a solver of the concurrent mode
+ *
+ *  The columns and rows are mapped to their copies, which are captured by the copy as in scip_trans(). The copy owns
+ *  its instance data, so copies that solve in other threads share no mutable data with this one. The copy has no
+ *  pricer: the columns of points that are not in the model of the source stay empty, and the rows of the pricer are
+ *  not needed.
+ */
+SCIP_RETCODE ProbData::scip_copy(
+	SCIP*                 scip,               /**< SCIP data structure of the copy */
+	SCIP*                 sourcescip,         /**< source SCIP data structure */
+	SCIP_HASHMAP*         varmap,             /**< mapping of source variables to target variables */
+	SCIP_HASHMAP*         consmap,            /**< mapping of source constraints to target constraints */
+	ObjProbData**         objprobdata,        /**< pointer to store the copied problem data object */
+	SCIP_Bool             global,             /**< create a global or a local copy? */
+	SCIP_RESULT*          result              /**< pointer to store the result of the call */
+) {
+	DOPT_PROFILE(sourcescip, "probdata/copy");
+	assert(objprobdata != NULL);
+	assert(result != NULL);
+	*objprobdata = NULL;
+	*result = SCIP_DIDNOTRUN;
+
+	ProbData* copydata = new ProbData(numvars, dim, A, (int) card, epsilon);
+	copydata->fullvalue = fullvalue;
+	copydata->emptyvalue = emptyvalue;
+	copydata->card = card;
+	copydata->knapweights = knapweights;
+	copydata->is_nature = is_nature;
+	copydata->gradient_cut = gradient_cut;
+	copydata->logdet_form = logdet_form;
+	copydata->poly_depth = poly_depth;
+	copydata->use_pricing = FALSE;
+	copydata->edges = edges;
+
+	// the structures get all their entries, NULL after a failed copy, so that releaseAll() can undo a partial copy
+	SCIP_Bool success = TRUE;
+	SCIP_VAR* var;
+	for(int i = 0; i < bin_vars.size(); i++){
+		var = NULL;
+		if(bin_vars[i] != NULL)
+			SCIP_CALL(getVarCopy(scip, sourcescip, bin_vars[i], varmap, consmap, global, TRUE, &var, &success));
+		copydata->bin_vars.push_back(var);
+	}
+
+	for(int i = 0; i <= numvars; i++){
+		copydata->Z.push_back(vector<SCIP_VAR*>());
+		copydata->t.push_back(vector<SCIP_VAR*>());
+		for(int j = 0; j < t[i].size(); j++){
+			if(i < numvars){
+				SCIP_CALL(getVarCopy(scip, sourcescip, Z[i][j], varmap, consmap, global, TRUE, &var, &success));
+				copydata->Z[i].push_back(var);
+			}
+			SCIP_CALL(getVarCopy(scip, sourcescip, t[i][j], varmap, consmap, global, TRUE, &var, &success));
+			copydata->t[i].push_back(var);
+		}
+	}
+	copydata->Z.pop_back();
+
+	for(int i = 0; i < dim; i++){
+		copydata->J.push_back(vector<SCIP_VAR*>());
+		copydata->epsZ.push_back(vector<SCIP_VAR*>());
+		copydata->epsZ2.push_back(vector<SCIP_VAR*>());
+		for(int j = 0; j < dim; j++){
+			SCIP_CALL(getVarCopy(scip, sourcescip, J[i][j], varmap, consmap, global, TRUE, &var, &success));
+			copydata->J[i].push_back(var);
+			SCIP_CALL(getVarCopy(scip, sourcescip, epsZ[i][j], varmap, consmap, global, TRUE, &var, &success));
+			copydata->epsZ[i].push_back(var);
+			SCIP_CALL(getVarCopy(scip, sourcescip, epsZ2[i][j], varmap, consmap, global, TRUE, &var, &success));
+			copydata->epsZ2[i].push_back(var);
+		}
+	}
+
+	SCIP_CALL(getVarCopy(scip, sourcescip, obj_var, varmap, consmap, global, TRUE, &copydata->obj_var, &success));
+
+	// the variables u, v, w of a polyhedral cone are captured in Z, t, bin_vars or epsZ, epsZ2
+	for(int c = 0; c < poly_cones.size(); c++){
+		PolyCone cone;
+		SCIP_CALL(getVarCopy(scip, sourcescip, poly_cones[c].u, varmap, consmap, global, FALSE, &cone.u, &success));
+		SCIP_CALL(getVarCopy(scip, sourcescip, poly_cones[c].v, varmap, consmap, global, FALSE, &cone.v, &success));
+		cone.w = NULL;
+		if(poly_cones[c].w != NULL)
+			SCIP_CALL(getVarCopy(scip, sourcescip, poly_cones[c].w, varmap, consmap, global, FALSE, &cone.w, &success));
+		for(int j = 0; j < poly_cones[c].xi.size(); j++){
+			SCIP_CALL(getVarCopy(scip, sourcescip, poly_cones[c].xi[j], varmap, consmap, global, TRUE, &var, &success));
+			cone.xi.push_back(var);
+			SCIP_CALL(getVarCopy(scip, sourcescip, poly_cones[c].eta[j], varmap, consmap, global, TRUE, &var, &success));
+			cone.eta.push_back(var);
+		}
+		copydata->poly_cones.push_back(cone);
+	}
+
+	// the copies of the rows are the ones that the copy of the problem uses, since they are stored in consmap; rows
+	// deleted in the source, e.g., by presolving, have no copy
+	for(int i = 0; i < conss.size() && success; i++){
+		if(SCIPconsIsDeleted(conss[i]))
+			continue;
+		SCIP_CONS* cons;
+		SCIP_CALL(SCIPgetConsCopy(sourcescip, scip, conss[i], &cons, SCIPconsGetHdlr(conss[i]), varmap, consmap,
+			SCIPconsGetName(conss[i]), SCIPconsIsInitial(conss[i]), SCIPconsIsSeparated(conss[i]),
+			SCIPconsIsEnforced(conss[i]), SCIPconsIsChecked(conss[i]), SCIPconsIsPropagated(conss[i]),
+			SCIPconsIsLocal(conss[i]), FALSE, SCIPconsIsDynamic(conss[i]), SCIPconsIsRemovable(conss[i]),
+			SCIPconsIsStickingAtNode(conss[i]), global, &success));
+		if(success)
+			copydata->conss.push_back(cons);
+	}
+
+	if(!success){
+		SCIP_CALL(copydata->releaseAll(scip));
+		delete copydata;
+		return SCIP_OKAY;
+	}
+
+	*objprobdata = copydata;
+	*result = SCIP_SUCCESS;
+
+	return SCIP_OKAY;
+}
+
+
+/** creates the columns Z[i][*] and t[i][*] of a point */
+SCIP_RETCODE ProbData::createPointVars(
+	SCIP*                 scip,               /**< SCIP data structure */
+	int                   i,                  /**< index of the point */
+	SCIP_Real             score               /**< pricing score of the point, if it is priced in */
+) {
+	// Z
+	for(int j = 0; j < dim; j++){
+		SCIP_VAR * zij;
+		string str = "z"+ std::to_string(i) + "_" + std::to_string(j);
+		SCIP_CALL(SCIPcreateVar(
+			scip, /**<	SCIP data structure*/
+			&zij, /**< 	pointer to variable object*/
+			str.c_str(), /**< name of variable, or NULL for automatic name creation*/
+			-SCIPinfinity(scip), /**<	lower bound of variable*/
+			SCIPinfinity(scip), /**< 	upper bound of variable */
+			0, /**<	objective function value */
+			SCIP_VARTYPE_CONTINUOUS, /**< type of variable */
+			TRUE, /**<	should var's column be present in the initial root LP?*/
+			FALSE, /**<	is var's column removable from the LP (due to aging or cleanup)?*/
+			NULL, NULL, NULL, NULL, NULL
+		));		
+		SCIP_CALL(addModelVar(scip, zij, score));
+		SCIP_CALL(SCIPcaptureVar(scip, zij));
+		Z[i].push_back(zij);
+		SCIP_CALL(SCIPreleaseVar(scip, &zij));	
+	}
+
+	// t
+	for(int j = 0; j < dim; j++){
+		SCIP_VAR * tij;
+		string str = "t"+ std::to_string(i) + "_" + std::to_string(j);
+		SCIP_CALL(SCIPcreateVar(
+			scip, /**<	SCIP data structure*/
+			&tij, /**< 	pointer to variable object*/
+			str.c_str(), /**< name of variable, or NULL for automatic name creation*/
+			0, /**<	lower bound of variable*/
+			SCIPinfinity(scip), /**< 	upper bound of variable */
+			0, /**<	objective function value */
+			SCIP_VARTYPE_CONTINUOUS, /**< type of variable */
+			TRUE, /**<	should var's column be present in the initial root LP?*/
+			FALSE, /**<	is var's column removable from the LP (due to aging or cleanup)?*/
+			NULL, NULL, NULL, NULL, NULL
+		));			
+		SCIP_CALL(addModelVar(scip, tij, score));
+		SCIP_CALL(SCIPcaptureVar(scip, tij));
+		t[i].push_back(tij);
+		SCIP_CALL(SCIPreleaseVar(scip, &tij));
+	}	
+
+	return SCIP_OKAY;
+}
+
+
+/** creates the cones Z[i][j]^2 <= t[i][j] w[i] of a point and their linearizations */
+SCIP_RETCODE ProbData::createPointConss(
+	SCIP*                 scip,               /**< SCIP data structure */
+	int                   i                   /**< index of the point */
+) {
+	SCIP_CONS * cons;
+	for(int j = 0; j < dim; j++){
+		string str = "soc" + std::to_string(i) + std::to_string(j);
+		if(poly_depth > 0){
+			SCIP_CALL(createPolyCone(scip, str, Z[i][j], t[i][j], bin_vars[i]));
+			continue;
+		}
+		SCIP_VAR * vars1[2] = {Z[i][j], t[i][j]};
+		SCIP_VAR * vars2[2] = {Z[i][j], bin_vars[i]};
+		SCIP_Real coefs[2] = {1, -1}; 
+		SCIP_CALL(SCIPcreateConsQuadraticNonlinear(
+			scip,               	/**< SCIP data structure */
+			&cons,       			/**< pointer to hold the created constraint */
+			str.c_str(),            /**< name of constraint */
+			0,   					/**< 	number of linear terms  */
+			NULL,					/**<  array with variables in linear part */
+			NULL,					/**< array with coefficients of variables in linear part  */
+			2,						/**< number of quadratic terms */
+			vars1, 	/**< array with first variables in quadratic terms */
+			vars2, 	/**< array with second variables in quadratic terms */
+			coefs,	/** array with coefficients of quadratic terms  */
+			-SCIPinfinity(scip),
+			0, 
+			TRUE,               /**< should the LP relaxation of constraint be in the initial LP?
+														*   Usually set to TRUE. Set to FALSE for 'lazy constraints'. */
+			TRUE,                /**< should the constraint be separated during LP processing?
+														*   Usually set to TRUE. */
+			TRUE,               /**< should the constraint be enforced during node processing?
+														*   TRUE for model constraints, FALSE for additional, redundant constraints. */
+			TRUE,               /**< should the constraint be checked for feasibility?
+														*   TRUE for model constraints, FALSE for additional, redundant constraints. */
+			TRUE,               /**< should the constraint be propagated during node processing?
+														*   Usually set to TRUE. */
+			FALSE,              /**< is constraint only valid locally?
+														*   Usually set to FALSE. Has to be set to TRUE, e.g., for branching constraints. */
+			FALSE,              /**< is constraint subject to aging?
+														*   Usually set to FALSE. Set to TRUE for own cuts which
+														*   are separated as constraints. */
+			FALSE,              /**< should the relaxation be removed from the LP due to aging or cleanup?
+														*   Usually set to FALSE. Set to TRUE for 'lazy constraints' and 'user cuts'. */
+			FALSE               /**< should the constraint always be kept at the node where it was added, even
+														*   if it may be moved to a more global node?
+														*   Usually set to FALSE. Set to TRUE to for constraints that represent node data. */
+		));	
+		SCIP_CALL(SCIPaddCons(scip, cons));
+		SCIP_CALL(SCIPcaptureCons(scip, cons));
+		conss.push_back(cons);
+		SCIP_CALL(SCIPreleaseCons(scip, &cons));
+
+		// this is needed for SCIP 8.0.1
+		// linearize +/-  2Z[i][j] <= t[i][j] + bin_vars[i] 
+		SCIP_VAR * vars3[3] = {Z[i][j], t[i][j], bin_vars[i]};
+		SCIP_Real wts3[3]  = {2, -1, -1};
+		for(int k = 0; k < 2; k++){
+			wts3[0] = k ? 2 : -2;
+			SCIP_CALL(SCIPcreateConsLinear(
+				scip,               /**< SCIP data structure */
+				&cons,        /**< pointer to hold the created constraint */
+				"linear1",             /**< name of constraint */
+				3,            /**< number of variables in the constraint */
+				vars3,    /**< array with variables of constraint entries */
+				wts3,
+				-SCIPinfinity(scip),
+				0,             
+				TRUE,               /**< should the LP relaxation of constraint be in the initial LP?
+															*   Usually set to TRUE. Set to FALSE for 'lazy constraints'. */
+				TRUE,                /**< should the constraint be separated during LP processing?
+															*   Usually set to TRUE. */
+				FALSE,               /**< should the constraint be enforced during node processing?
+															*   TRUE for model constraints, FALSE for additional, redundant constraints. */
+				FALSE,               /**< should the constraint be checked for feasibility?
+															*   TRUE for model constraints, FALSE for additional, redundant constraints. */
+				FALSE,               /**< should the constraint be propagated during node processing?
+															*   Usually set to TRUE. */
+				FALSE,              /**< is constraint only valid locally?
+															*   Usually set to FALSE. Has to be set to TRUE, e.g., for branching constraints. */
+				FALSE,					/**< is constraint modifiable (subject to column generation)? Usually set to FALSE. In column generation applications, set to TRUE if pricing adds coefficients to this constraint. */
+				FALSE,              /**< is constraint subject to aging?
+															*   Usually set to FALSE. Set to TRUE for own cuts which
+															*   are separated as constraints. */
+				TRUE,              /**< should the relaxation be removed from the LP due to aging or cleanup?
+															*   Usually set to FALSE. Set to TRUE for 'lazy constraints' and 'user cuts'. */
+				FALSE               /**< should the constraint always be kept at the node where it was added, even
+															*   if it may be moved to a more global node?
+															*   Usually set to FALSE. Set to TRUE to for constraints that represent node data. */
+			));
+			SCIP_CALL(SCIPaddCons(scip, cons));
+			SCIP_CALL(SCIPcaptureCons(scip, cons));
+			conss.push_back(cons);
+			SCIP_CALL(SCIPreleaseCons(scip, &cons));
+		}
+	}
+
+	return SCIP_OKAY;
+}
+
+
+/** creates the variables and rows of the polyhedral approximation of u^2 <= v w
+ *
+ *  Each point (xi_0, eta_0) in the first quadrant is rotated k times, and the rotation by pi / 2^(j+1) followed by
+ *  the absolute value of the second coordinate halves its angle, so xi_k is at most the norm of (2 u, v - w), and at
+ *  least its norm times cos(pi / 2^(k+1)). The approximation thus contains the cone, and its points satisfy
+ *  |(2 u, v - w)| <= (v + w) / cos(pi / 2^(k+1)).
+ */
+SCIP_RETCODE ProbData::createPolyCone(
+	SCIP*                 scip,               /**< SCIP data structure */
+	const string&         name,               /**< name prefix of the variables and rows */
+	SCIP_VAR*             u,                  /**< variable of the square */
+	SCIP_VAR*             v,                  /**< first variable of the product */
+	SCIP_VAR*             w                   /**< second variable of the product, or NULL for 1 */
+) {
+	assert(poly_depth > 0);
+
+	PolyCone cone;
+	cone.u = u;
+	cone.v = v;
+	cone.w = w;
+	for(int j = 0; j <= poly_depth; j++){
+		for(int k = 0; k < 2; k++){
+			SCIP_VAR * var;
+			string str = name + (k ? "_eta" : "_xi") + std::to_string(j);
+			SCIP_CALL(SCIPcreateVar(scip, &var, str.c_str(), 0, SCIPinfinity(scip), 0, SCIP_VARTYPE_CONTINUOUS, TRUE, FALSE,
+				NULL, NULL, NULL, NULL, NULL));
+			SCIP_CALL(addModelVar(scip, var, 0));
+			SCIP_CALL(SCIPcaptureVar(scip, var));
+			(k ? cone.eta : cone.xi).push_back(var);
+			SCIP_CALL(SCIPreleaseVar(scip, &var));
+		}
+	}
+
+	for(int k = 0; k < 2; k++){
+		SCIP_Real sign = k ? 1 : -1;
+
+		// xi_0 >= +/- 2 u
+		SCIP_VAR * vars1[2] = {cone.xi[0], u};
+		SCIP_Real vals1[2] = {1, -2 * sign};
+		SCIP_CALL(addPolyRow(scip, conss, name + "_xi0", 2, vars1, vals1, 0, SCIPinfinity(scip)));
+
+		// eta_0 >= +/- (v - w)
+		SCIP_VAR * vars2[3] = {cone.eta[0], v, w};
+		SCIP_Real vals2[3] = {1, -sign, sign};
+		SCIP_CALL(addPolyRow(scip, conss, name + "_eta0", w != NULL ? 3 : 2, vars2, vals2, w != NULL ? 0 : -sign,
+			SCIPinfinity(scip)));
+	}
+
+	// rotations
+	for(int j = 1; j <= poly_depth; j++){
+		SCIP_Real angle = M_PI / pow(2.0, j + 1);
+		SCIP_Real c = cos(angle);
+		SCIP_Real s = sin(angle);
+		string str = name + "_rot" + std::to_string(j);
+
+		SCIP_VAR * vars1[3] = {cone.xi[j], cone.xi[j - 1], cone.eta[j - 1]};
+		SCIP_Real vals1[3] = {1, -c, -s};
+		SCIP_CALL(addPolyRow(scip, conss, str, 3, vars1, vals1, 0, 0));
+
+		SCIP_VAR * vars2[3] = {cone.eta[j], cone.xi[j - 1], cone.eta[j - 1]};
+		for(int k = 0; k < 2; k++){
+			SCIP_Real sign = k ? 1 : -1;
+			SCIP_Real vals2[3] = {1, sign * s, -sign * c};
+			SCIP_CALL(addPolyRow(scip, conss, str, 3, vars2, vals2, 0, SCIPinfinity(scip)));
+		}
+	}
+
+	// xi_k <= v + w and eta_k <= tan(pi / 2^(k+1)) xi_k
+	SCIP_VAR * vars1[3] = {cone.xi[poly_depth], v, w};
+	SCIP_Real vals1[3] = {1, -1, -1};
+	SCIP_CALL(addPolyRow(scip, conss, name + "_radius", w != NULL ? 3 : 2, vars1, vals1, -SCIPinfinity(scip),
+		w != NULL ? 0 : 1));
+
+	SCIP_VAR * vars2[2] = {cone.eta[poly_depth], cone.xi[poly_depth]};
+	SCIP_Real vals2[2] = {1, -tan(M_PI / pow(2.0, poly_depth + 1))};
+	SCIP_CALL(addPolyRow(scip, conss, name + "_angle", 2, vars2, vals2, -SCIPinfinity(scip), 0));
+
+	poly_cones.push_back(cone);
+
+	return SCIP_OKAY;
+}
+
+
 /** create variables and initial  constraints */
 SCIP_RETCODE ProbData::createInitial(
 	SCIP*                 scip               /**< SCIP data structure */
 ) {   
+	DOPT_PROFILE(scip, "probdata/createInitial");
+
+	// points of the initial model, all points unless they are priced in
+	vector<bool> in_model(numvars, init_points.empty());
+	for(int k = 0; k < init_points.size(); k++){
+		in_model[init_points[k]] = true;
+	}
 
 	// add binary variables
-	
+	bin_vars.assign(numvars, NULL);
 	for(int i = 0; i < numvars; i++){
+		if(!in_model[i])
+			continue;
 		SCIP_VAR* bin_var;
 		string tmp = "b"+ std::to_string(i);
 		SCIP_CALL(SCIPcreateVar(
@@ -252,7 +855,7 @@ SCIP_RETCODE ProbData::createInitial(
 		));
 		SCIP_CALL(SCIPaddVar(scip, bin_var));
 		SCIP_CALL(SCIPcaptureVar(scip, bin_var));
-		bin_vars.push_back(bin_var);
+		bin_vars[i] = bin_var;
 		SCIP_CALL(SCIPreleaseVar(scip, &bin_var));
 	}
 
@@ -282,53 +885,11 @@ SCIP_RETCODE ProbData::createInitial(
 	// build MISOCP formulation
 	SCIP_CONS * cons;
 	// create variables
+	Z.resize(numvars);
+	t.resize(numvars);
 	for(int i = 0; i < numvars; i++){
-		// Z
-		Z.push_back(vector<SCIP_VAR *> ());
-		for(int j = 0; j < dim; j++){
-			SCIP_VAR * zij;
-			string str = "z"+ std::to_string(i) + "_" + std::to_string(j);
-			SCIP_CALL(SCIPcreateVar(
-				scip, /**<	SCIP data structure*/
-				&zij, /**< 	pointer to variable object*/
-				str.c_str(), /**< name of variable, or NULL for automatic name creation*/
-				-SCIPinfinity(scip), /**<	lower bound of variable*/
-				SCIPinfinity(scip), /**< 	upper bound of variable */
-				0, /**<	objective function value */
-				SCIP_VARTYPE_CONTINUOUS, /**< type of variable */
-				TRUE, /**<	should var's column be present in the initial root LP?*/
-				FALSE, /**<	is var's column removable from the LP (due to aging or cleanup)?*/
-				NULL, NULL, NULL, NULL, NULL
-			));		
-			SCIP_CALL(SCIPaddVar(scip, zij));
-			SCIP_CALL(SCIPcaptureVar(scip, zij));
-			Z[i].push_back(zij);
-			SCIP_CALL(SCIPreleaseVar(scip, &zij));	
-		}
-
-		// t
-		t.push_back(vector<SCIP_VAR *> ());
-		for(int j = 0; j < dim; j++){
-			SCIP_VAR * tij;
-			string str = "t"+ std::to_string(i) + "_" + std::to_string(j);
-			SCIP_CALL(SCIPcreateVar(
-				scip, /**<	SCIP data structure*/
-				&tij, /**< 	pointer to variable object*/
-				str.c_str(), /**< name of variable, or NULL for automatic name creation*/
-				0, /**<	lower bound of variable*/
-				SCIPinfinity(scip), /**< 	upper bound of variable */
-				0, /**<	objective function value */
-				SCIP_VARTYPE_CONTINUOUS, /**< type of variable */
-				TRUE, /**<	should var's column be present in the initial root LP?*/
-				FALSE, /**<	is var's column removable from the LP (due to aging or cleanup)?*/
-				NULL, NULL, NULL, NULL, NULL
-			));			
-			SCIP_CALL(SCIPaddVar(scip, tij));
-			SCIP_CALL(SCIPcaptureVar(scip, tij));
-			t[i].push_back(tij);
-			SCIP_CALL(SCIPreleaseVar(scip, &tij));
-		}	
-
+		if(in_model[i])
+			SCIP_CALL(createPointVars(scip, i, 0));
 	}
 
 	// epsZ, t
@@ -406,26 +967,30 @@ SCIP_RETCODE ProbData::createInitial(
 	
 	// build constraint
 	// \sum Ai Zi = J, J lower-trigangular
+	// in pricing mode, the rows that get coefficients of new points are modifiable
+	azj_conss.assign(dim, vector<SCIP_CONS*>(dim, NULL));
 	for(int j1 = 0; j1 < dim; j1++){
 		for(int j2 = j1; j2 < dim; j2++){
-			vector<SCIP_VAR*> vars(numvars + 2);
-			vector<SCIP_Real> weights(numvars + 2);
+			vector<SCIP_VAR*> vars;
+			vector<SCIP_Real> weights;
 			for(int  i = 0; i < numvars; i++){
+				if(!in_model[i])
+					continue;
 				SCIP_Real Aij1 = A[j1][i];
 				SCIP_VAR* Zij2 =  Z[i][j2];
-			    weights[i] = Aij1;
-				vars[i] = Zij2;
+			    weights.push_back(Aij1);
+				vars.push_back(Zij2);
 			}	
-			vars[numvars] = epsZ[j1][j2];
-			weights[numvars] = epsilon;
-			vars[numvars + 1] = J[j1][j2];
-			weights[numvars + 1] = -1;
+			vars.push_back(epsZ[j1][j2]);
+			weights.push_back(epsilon);
+			vars.push_back(J[j1][j2]);
+			weights.push_back(-1);
 			string str = "A" + std::to_string(j1) + "Z" + std::to_string(j2) + "=J";
 			SCIP_CALL(SCIPcreateConsLinear(
 				scip,               /**< SCIP data structure */
 				&cons,        /**< pointer to hold the created constraint */
 				str.c_str(),             /**< name of constraint */
-				numvars + 2,            /**< number of variables in the constraint */
+				(int) vars.size(),            /**< number of variables in the constraint */
 				vars.data(),    /**< array with variables of constraint entries */
 				weights.data(),
 				0,
@@ -441,7 +1006,7 @@ SCIP_RETCODE ProbData::createInitial(
 				TRUE,               /**< should the constraint be propagated during node processing?
 															*   Usually set to TRUE. */
 				FALSE,
-				FALSE,              /**< is constraint only valid locally?
+				use_pricing,              /**< is constraint only valid locally?
 															*   Usually set to FALSE. Has to be set to TRUE, e.g., for branching constraints. */
 				FALSE,              /**< is constraint subject to aging?
 															*   Usually set to FALSE. Set to TRUE for own cuts which
@@ -455,26 +1020,28 @@ SCIP_RETCODE ProbData::createInitial(
 			SCIP_CALL(SCIPaddCons(scip, cons));
 			SCIP_CALL(SCIPcaptureCons(scip, cons));
 			conss.push_back(cons);
+			azj_conss[j1][j2] = cons;
 			SCIP_CALL(SCIPreleaseCons(scip, &cons));	
 		}
 	}
 
 	// \sum_{i} tij \le Jjj
 	for(int j = 0; j < dim; j++){
-		vector<SCIP_VAR *> vars(numvars + 2, NULL);
-		vector<SCIP_Real> weights(numvars + 2, 1);
+		vector<SCIP_VAR *> vars;
 		for(int i = 0; i < numvars + 1; i++){
-			vars[i] = t[i][j];
+			if(i == numvars || in_model[i])
+				vars.push_back(t[i][j]);
 		}
+		vector<SCIP_Real> weights(vars.size() + 1, 1);
 		// test: weights[numvars] = 0;
-		vars[numvars + 1] = J[j][j];
-		weights[numvars + 1] = -1;
+		vars.push_back(J[j][j]);
+		weights[vars.size() - 1] = -1;
 		string str = "sumt" + std::to_string(j) + "<=J" + std::to_string(j);
 		SCIP_CALL(SCIPcreateConsLinear(
 			scip,               /**< SCIP data structure */
 			&cons,        /**< pointer to hold the created constraint */
 			str.c_str(),             /**< name of constraint */
-			numvars + 2,            /**< number of variables in the constraint */
+			(int) vars.size(),            /**< number of variables in the constraint */
 			vars.data(),    /**< array with variables of constraint entries */
 			weights.data(),
 			-SCIPinfinity(scip),
@@ -490,7 +1057,7 @@ SCIP_RETCODE ProbData::createInitial(
 			TRUE,               /**< should the constraint be propagated during node processing?
 														*   Usually set to TRUE. */
 			FALSE,
-			FALSE,              /**< is constraint only valid locally?
+			use_pricing,              /**< is constraint only valid locally?
 														*   Usually set to FALSE. Has to be set to TRUE, e.g., for branching constraints. */
 			FALSE,              /**< is constraint subject to aging?
 														*   Usually set to FALSE. Set to TRUE for own cuts which
@@ -504,98 +1071,14 @@ SCIP_RETCODE ProbData::createInitial(
 		SCIP_CALL(SCIPaddCons(scip, cons));
 		SCIP_CALL(SCIPcaptureCons(scip, cons));
 		conss.push_back(cons);
+		sumt_conss.push_back(cons);
 		SCIP_CALL(SCIPreleaseCons(scip, &cons));
 	}
 
 	// zij^2 \le tij wij
 	for(int i = 0; i < numvars; i++){
-		for(int j = 0; j < dim; j++){
-			string str = "soc" + std::to_string(i) + std::to_string(j);
-			SCIP_VAR * vars1[2] = {Z[i][j], t[i][j]};
-			SCIP_VAR * vars2[2] = {Z[i][j], bin_vars[i]};
-			SCIP_Real coefs[2] = {1, -1}; 
-			SCIP_CALL(SCIPcreateConsQuadraticNonlinear(
-				scip,               	/**< SCIP data structure */
-				&cons,       			/**< pointer to hold the created constraint */
-				str.c_str(),            /**< name of constraint */
-				0,   					/**< 	number of linear terms  */
-				NULL,					/**<  array with variables in linear part */
-				NULL,					/**< array with coefficients of variables in linear part  */
-				2,						/**< number of quadratic terms */
-				vars1, 	/**< array with first variables in quadratic terms */
-				vars2, 	/**< array with second variables in quadratic terms */
-				coefs,	/** array with coefficients of quadratic terms  */
-				-SCIPinfinity(scip),
-				0, 
-				TRUE,               /**< should the LP relaxation of constraint be in the initial LP?
-															*   Usually set to TRUE. Set to FALSE for 'lazy constraints'. */
-				TRUE,                /**< should the constraint be separated during LP processing?
-															*   Usually set to TRUE. */
-				TRUE,               /**< should the constraint be enforced during node processing?
-															*   TRUE for model constraints, FALSE for additional, redundant constraints. */
-				TRUE,               /**< should the constraint be checked for feasibility?
-															*   TRUE for model constraints, FALSE for additional, redundant constraints. */
-				TRUE,               /**< should the constraint be propagated during node processing?
-															*   Usually set to TRUE. */
-				FALSE,              /**< is constraint only valid locally?
-															*   Usually set to FALSE. Has to be set to TRUE, e.g., for branching constraints. */
-				FALSE,              /**< is constraint subject to aging?
-															*   Usually set to FALSE. Set to TRUE for own cuts which
-															*   are separated as constraints. */
-				FALSE,              /**< should the relaxation be removed from the LP due to aging or cleanup?
-															*   Usually set to FALSE. Set to TRUE for 'lazy constraints' and 'user cuts'. */
-				FALSE               /**< should the constraint always be kept at the node where it was added, even
-															*   if it may be moved to a more global node?
-															*   Usually set to FALSE. Set to TRUE to for constraints that represent node data. */
-			));	
-			SCIP_CALL(SCIPaddCons(scip, cons));
-			SCIP_CALL(SCIPcaptureCons(scip, cons));
-			conss.push_back(cons);
-			SCIP_CALL(SCIPreleaseCons(scip, &cons));
-
-			// this is needed for SCIP 8.0.1
-			// linearize +/-  2Z[i][j] <= t[i][j] + bin_vars[i] 
-			SCIP_VAR * vars3[3] = {Z[i][j], t[i][j], bin_vars[i]};
-			SCIP_Real wts3[3]  = {2, -1, -1};
-			for(int k = 0; k < 2; k++){
-				wts3[0] = k ? 2 : -2;
-				SCIP_CALL(SCIPcreateConsLinear(
-					scip,               /**< SCIP data structure */
-					&cons,        /**< pointer to hold the created constraint */
-					"linear1",             /**< name of constraint */
-					3,            /**< number of variables in the constraint */
-					vars3,    /**< array with variables of constraint entries */
-					wts3,
-					-SCIPinfinity(scip),
-					0,             
-					TRUE,               /**< should the LP relaxation of constraint be in the initial LP?
-																*   Usually set to TRUE. Set to FALSE for 'lazy constraints'. */
-					TRUE,                /**< should the constraint be separated during LP processing?
-																*   Usually set to TRUE. */
-					FALSE,               /**< should the constraint be enforced during node processing?
-																*   TRUE for model constraints, FALSE for additional, redundant constraints. */
-					FALSE,               /**< should the constraint be checked for feasibility?
-																*   TRUE for model constraints, FALSE for additional, redundant constraints. */
-					FALSE,               /**< should the constraint be propagated during node processing?
-																*   Usually set to TRUE. */
-					FALSE,              /**< is constraint only valid locally?
-																*   Usually set to FALSE. Has to be set to TRUE, e.g., for branching constraints. */
-					FALSE,					/**< is constraint modifiable (subject to column generation)? Usually set to FALSE. In column generation applications, set to TRUE if pricing adds coefficients to this constraint. */
-					FALSE,              /**< is constraint subject to aging?
-																*   Usually set to FALSE. Set to TRUE for own cuts which
-																*   are separated as constraints. */
-					TRUE,              /**< should the relaxation be removed from the LP due to aging or cleanup?
-																*   Usually set to FALSE. Set to TRUE for 'lazy constraints' and 'user cuts'. */
-					FALSE               /**< should the constraint always be kept at the node where it was added, even
-																*   if it may be moved to a more global node?
-																*   Usually set to FALSE. Set to TRUE to for constraints that represent node data. */
-				));
-				SCIP_CALL(SCIPaddCons(scip, cons));
-				SCIP_CALL(SCIPcaptureCons(scip, cons));
-				conss.push_back(cons);
-				SCIP_CALL(SCIPreleaseCons(scip, &cons));
-			}
-		}
+		if(in_model[i])
+			SCIP_CALL(createPointConss(scip, i));
 	}
 
 	// soc for epsZ
@@ -635,6 +1118,11 @@ SCIP_RETCODE ProbData::createInitial(
 			SCIP_VAR* quadvars[1] = {epsZ[j1][j2]};
 			SCIP_Real quadcoefs[1] = {1};
 			string str = "epsZ^2<=epsZ2 "+ std::to_string(j1) + "_" +std::to_string(j2) ;
+			if(poly_depth > 0){
+				SCIP_CALL(createPolyCone(scip, "epscone" + std::to_string(j1) + "_" + std::to_string(j2), epsZ[j1][j2],
+					epsZ2[j1][j2], NULL));
+				continue;
+			}
 			SCIP_CALL(SCIPcreateConsQuadraticNonlinear(
 				scip,               	/**< SCIP data structure */
 				&cons,       			/**< pointer to hold the created constraint */
@@ -765,7 +1253,6 @@ SCIP_RETCODE ProbData::createInitial(
 	}
 
 	// objective function form
-	bool logdet_form = false;
 	if(logdet_form)
 	{
 		vector<SCIP_EXPR *> children(dim);
@@ -832,55 +1319,6 @@ SCIP_RETCODE ProbData::createInitial(
 		for(int j = 0; j < dim + 1; j++){
 			SCIP_CALL(SCIPreleaseExpr(scip, &children[j]));
 		}	
-
-
-    
-		vector<SCIP_VAR*> vars(dim + 1, NULL);
-		vector<SCIP_Real>  wts(dim + 1, 0);
-		for(int i = 0; i < dim; i++){
-			vars[i] = J[i][i];
-			wts[i] = 1.0 / dim;
-		}
-		vars[dim] = obj_var;
-		wts[dim] = -1;
-
-		// manually linearize
-		SCIP_CALL(SCIPcreateConsLinear(
-			scip,               /**< SCIP data structure */
-			&cons,        /**< pointer to hold the created constraint */
-			"linearize_obj",             /**< name of constraint */
-			dim+1,            /**< number of variables in the constraint */
-			vars.data(),    /**< array with variables of constraint entries */
-			wts.data(),
-			1 + emptyvalue,
-			SCIPinfinity(scip),           
-			TRUE,               /**< should the LP relaxation of constraint be in the initial LP?
-														*   Usually set to TRUE. Set to FALSE for 'lazy constraints'. */
-			TRUE,                /**< should the constraint be separated during LP processing?
-														*   Usually set to TRUE. */
-			TRUE,               /**< should the constraint be enforced during node processing?
-														*   TRUE for model constraints, FALSE for additional, redundant constraints. */
-			TRUE,               /**< should the constraint be checked for feasibility?
-														*   TRUE for model constraints, FALSE for additional, redundant constraints. */
-			TRUE,               /**< should the constraint be propagated during node processing?
-														*   Usually set to TRUE. */
-			FALSE,
-			FALSE,              /**< is constraint only valid locally?
-														*   Usually set to FALSE. Has to be set to TRUE, e.g., for branching constraints. */
-			FALSE,              /**< is constraint subject to aging?
-														*   Usually set to FALSE. Set to TRUE for own cuts which
-														*   are separated as constraints. */
-			FALSE,              /**< should the relaxation be removed from the LP due to aging or cleanup?
-														*   Usually set to FALSE. Set to TRUE for 'lazy constraints' and 'user cuts'. */
-			FALSE               /**< should the constraint always be kept at the node where it was added, even
-														*   if it may be moved to a more global node?
-														*   Usually set to FALSE. Set to TRUE to for constraints that represent node data. */
-		));
-		// this may not needed for SCIP 8.0.1
-		//SCIP_CALL(SCIPaddCons(scip, cons));
-		//SCIP_CALL(SCIPcaptureCons(scip, cons));
-		//conss.push_back(cons);
-		//SCIP_CALL(SCIPreleaseCons(scip, &cons));		
 	}
 	else
 	{
@@ -1040,12 +1478,17 @@ SCIP_RETCODE ProbData::createInitial(
 	else if(has_cardcons){
 		SCIPdebugMessage("%f\n", card);
 		knapweights = vector<SCIP_Real>(numvars, 1);
+		vector<SCIP_VAR*> vars;
+		for(int i = 0; i < numvars; i++){
+			if(in_model[i])
+				vars.push_back(bin_vars[i]);
+		}
 		SCIP_CALL(SCIPcreateConsLinear(
 			scip,               /**< SCIP data structure */
 			&cons,        /**< pointer to hold the created constraint */
 			"card",             /**< name of constraint */
-			numvars,            /**< number of variables in the constraint */
-			bin_vars.data(),    /**< array with variables of constraint entries */
+			(int) vars.size(),            /**< number of variables in the constraint */
+			vars.data(),    /**< array with variables of constraint entries */
 			knapweights.data(),
 			card,
 			card,             
@@ -1060,7 +1503,7 @@ SCIP_RETCODE ProbData::createInitial(
 			TRUE,               /**< should the constraint be propagated during node processing?
 														*   Usually set to TRUE. */
 			FALSE,
-			FALSE,              /**< is constraint only valid locally?
+			use_pricing,              /**< is constraint only valid locally?
 														*   Usually set to FALSE. Has to be set to TRUE, e.g., for branching constraints. */
 			FALSE,              /**< is constraint subject to aging?
 														*   Usually set to FALSE. Set to TRUE for own cuts which
@@ -1074,10 +1517,391 @@ SCIP_RETCODE ProbData::createInitial(
 		SCIP_CALL(SCIPaddCons(scip, cons));
 		SCIP_CALL(SCIPcaptureCons(scip, cons));
 		conss.push_back(cons);
+		card_cons = cons;
 		SCIP_CALL(SCIPreleaseCons(scip, &cons));		
 	}
 
 	return SCIP_OKAY;
 }
 
+/** adds a point to the model during pricing or to the original problem: its binary, Z and t columns, its cones,
+ *  and its coefficients in the rows A Z = J, sum_i t_ij <= J_jj and the cardinality constraint
+ *
+ *  During solving, the rows must be modifiable, i.e., the model was built in pricing mode; in the original problem,
+ *  coefficients can be added to any row.
+ */
+SCIP_RETCODE ProbData::addPoint(
+	SCIP*                 scip,               /**< SCIP data structure */
+	int                   i,                  /**< index of the point */
+	SCIP_Real             score               /**< pricing score of the point */
+) {
+	assert(use_pricing || SCIPgetStage(scip) == SCIP_STAGE_PROBLEM);
+	assert(!hasPoint(i));
+	assert(card_cons != NULL || !has_cardcons);
+
+	SCIP_VAR* bin_var;
+	string tmp = "b"+ std::to_string(i);
+	SCIP_CALL(SCIPcreateVar(scip, &bin_var, tmp.c_str(), 0, 1, 0, SCIP_VARTYPE_BINARY, TRUE, FALSE,
+		NULL, NULL, NULL, NULL, NULL));
+	SCIP_CALL(addModelVar(scip, bin_var, score));
+	SCIP_CALL(SCIPcaptureVar(scip, bin_var));
+	bin_vars[i] = bin_var;
+	SCIP_CALL(SCIPreleaseVar(scip, &bin_var));
+
+	SCIP_CALL(createPointVars(scip, i, score));
+	SCIP_CALL(createPointConss(scip, i));
+
+	// coefficients in the rows of the initial model
+	for(int j1 = 0; j1 < dim; j1++){
+		if(A[j1][i] == 0)
+			continue;
+		for(int j2 = j1; j2 < dim; j2++){
+			SCIP_CALL(SCIPaddCoefLinear(scip, azj_conss[j1][j2], Z[i][j2], A[j1][i]));
+		}
+	}
+	for(int j = 0; j < dim; j++){
+		SCIP_CALL(SCIPaddCoefLinear(scip, sumt_conss[j], t[i][j], 1));
+	}
+	if(card_cons != NULL){
+		SCIP_CALL(SCIPaddCoefLinear(scip, card_cons, bin_vars[i], 1));
+	}
+
+	return SCIP_OKAY;
+}
+
+
+/** appends points to the data matrix of the original problem; in pricing mode they are left to the pricer,
+ *  otherwise they are added to the model
+ *
+ *  The indices of the existing points do not change, and t[numvars], the column of the regularization, moves to the
+ *  new end of t.
+ */
+SCIP_RETCODE ProbData::appendPoints(
+	SCIP*                 scip,               /**< SCIP data structure */
+	const vector<vector<SCIP_Real>>& points   /**< the new points, each with dim entries */
+) {
+	assert(SCIPgetStage(scip) == SCIP_STAGE_PROBLEM);
+	assert(orig_data == NULL);
+
+	// the weights of a knapsack constraint are not known for new points
+	if(has_knapcons){
+		SCIPerrorMessage("points cannot be appended to a problem with a knapsack constraint\n");
+		return SCIP_INVALIDCALL;
+	}
+	for(int k = 0; k < points.size(); k++){
+		if(points[k].size() != dim){
+			SCIPerrorMessage("appended point %d has %d entries, but the dimension is %d\n", k, (int) points[k].size(), dim);
+			return SCIP_INVALIDDATA;
+		}
+	}
+
+	int first = numvars;
+	int npoints = (int) points.size();
+	for(int j = 0; j < dim; j++){
+		for(int k = 0; k < npoints; k++){
+			A[j].push_back(points[k][j]);
+		}
+	}
+	t.insert(t.begin() + numvars, npoints, vector<SCIP_VAR*>());
+	Z.resize(numvars + npoints);
+	bin_vars.resize(numvars + npoints, NULL);
+	if(has_cardcons){
+		knapweights.resize(numvars + npoints, 1);
+	}
+	numvars += npoints;
+
+	// the Laplacian mode is left as soon as a point is not an incidence vector
+	if(!edges.empty()){
+		edges.resize(numvars);
+		for(int i = first; i < numvars && !edges.empty(); i++){
+			if(!incidenceEdge(A, i, edges[i])){
+				edges.clear();
+			}
+		}
+	}
+
+	if(use_pricing)
+		return SCIP_OKAY;
+
+	for(int i = first; i < numvars; i++){
+		SCIP_CALL(addPoint(scip, i, 0));
+	}
+
+	return SCIP_OKAY;
+}
+
+
+/** creates a solution of the original problem for the design that contains the given points: the lifted
+ *  variables are set from the Cholesky factor of the information matrix
+ *
+ *  With M = L L^T, the columns Z = W B^T L^-T diag(L) of B = [A, epsilon I] satisfy B Z = L diag(L), hence
+ *  J = L diag(L), J_jj = L_jj^2, and t_ij = Z_ij^2 / w_i sums to J_jj.
+ */
+SCIP_RETCODE ProbData::createDesignSol(
+	SCIP*                 scip,               /**< SCIP data structure */
+	const vector<int>&    points,             /**< the points of the design */
+	SCIP_SOL**            sol                 /**< pointer to store the solution */
+) {
+	vector<SCIP_Real> L;
+	informationMatrix(A, points, epsilon * epsilon, L);
+	if(!kernel.factor(dim, L.data())){
+		SCIPerrorMessage("information matrix of the design is singular\n");
+		return SCIP_INVALIDDATA;
+	}
+
+	SCIP_CALL(SCIPcreateSol(scip, sol, NULL));
+
+	vector<SCIP_Real> y(dim);
+	for(int k = 0; k < points.size(); k++){
+		int i = points[k];
+		assert(hasPoint(i));
+		SCIP_CALL(SCIPsetSolVal(scip, *sol, bin_vars[i], 1));
+		for(int j = 0; j < dim; j++){
+			y[j] = A[j][i];
+		}
+		kernel.solveLower(dim, L.data(), y.data());
+		for(int j = 0; j < dim; j++){
+			SCIP_Real z = y[j] * L[j * dim + j];
+			SCIP_CALL(SCIPsetSolVal(scip, *sol, Z[i][j], z));
+			SCIP_CALL(SCIPsetSolVal(scip, *sol, t[i][j], z * z));
+		}
+	}
+
+	// the regularization epsilon * I is the point with weight 1 and columns epsZ
+	vector<SCIP_Real> sumt(dim, 0);
+	for(int j1 = 0; j1 < dim; j1++){
+		y.assign(dim, 0);
+		y[j1] = epsilon;
+		kernel.solveLower(dim, L.data(), y.data());
+		for(int j2 = 0; j2 < dim; j2++){
+			SCIP_Real z = y[j2] * L[j2 * dim + j2];
+			SCIP_CALL(SCIPsetSolVal(scip, *sol, epsZ[j1][j2], z));
+			SCIP_CALL(SCIPsetSolVal(scip, *sol, epsZ2[j1][j2], z * z));
+			sumt[j2] += z * z;
+		}
+	}
+	for(int j = 0; j < dim; j++){
+		SCIP_CALL(SCIPsetSolVal(scip, *sol, t[numvars][j], sumt[j]));
+	}
+
+	for(int j1 = 0; j1 < dim; j1++){
+		for(int j2 = 0; j2 <= j1; j2++){
+			SCIP_CALL(SCIPsetSolVal(scip, *sol, J[j1][j2], L[j1 * dim + j2] * L[j2 * dim + j2]));
+		}
+	}
+	SCIP_CALL(SCIPsetSolVal(scip, *sol, obj_var, objFromLogdet(logdet_form, dim, emptyvalue, kernel.logdet(dim, L.data()))));
+
+	// the rotations of the polyhedral cones, applied to the exact values of u, v and w
+	for(int c = 0; c < poly_cones.size(); c++){
+		const PolyCone& cone = poly_cones[c];
+		SCIP_Real wval = cone.w != NULL ? SCIPgetSolVal(scip, *sol, cone.w) : 1;
+		SCIP_Real xi = REALABS(2 * SCIPgetSolVal(scip, *sol, cone.u));
+		SCIP_Real eta = REALABS(SCIPgetSolVal(scip, *sol, cone.v) - wval);
+		SCIP_CALL(SCIPsetSolVal(scip, *sol, cone.xi[0], xi));
+		SCIP_CALL(SCIPsetSolVal(scip, *sol, cone.eta[0], eta));
+		for(int j = 1; j <= poly_depth; j++){
+			SCIP_Real angle = M_PI / pow(2.0, j + 1);
+			SCIP_Real newxi = cos(angle) * xi + sin(angle) * eta;
+			eta = REALABS(cos(angle) * eta - sin(angle) * xi);
+			xi = newxi;
+			SCIP_CALL(SCIPsetSolVal(scip, *sol, cone.xi[j], xi));
+			SCIP_CALL(SCIPsetSolVal(scip, *sol, cone.eta[j], eta));
+		}
+	}
+
+	return SCIP_OKAY;
+}
+
+
+/** adds a gradient cut coefs * (Z_ij, t_ij, w_i) <= 0 of the cone of a point as removable row of the initial LP of
+ *  the original problem; the cut is implied by the cone, so it is neither enforced nor checked
+ */
+SCIP_RETCODE ProbData::addConeCut(
+	SCIP*                 scip,               /**< SCIP data structure */
+	int                   i,                  /**< index of the point, must be in the model */
+	int                   j,                  /**< index of the coordinate */
+	const SCIP_Real*      coefs               /**< coefficients of Z_ij, t_ij and w_i */
+) {
+	assert(SCIPgetStage(scip) == SCIP_STAGE_PROBLEM);
+	assert(hasPoint(i));
+	SCIP_VAR* vars[3] = {Z[i][j], t[i][j], bin_vars[i]};
+	SCIP_Real vals[3] = {coefs[0], coefs[1], coefs[2]};
+	SCIP_CALL(addCutRow(scip, conss, "conecut" + std::to_string(i) + "_" + std::to_string(j), 3, vars, vals, 0));
+	return SCIP_OKAY;
+}
+
+
+/** adds the tangent cuts of the cones and of the objective at the lifted point of a continuous design as removable
+ *  rows of the initial LP
+ *
+ *  The lifted point is the one of createDesignSol() for M = eps^2 I + sum_i w_i a_i a_i^T = L L^T: Z_ij = w_i y_ij L_jj
+ *  and t_ij = w_i y_ij^2 L_jj^2 with y_i = L^-1 a_i, epsZ and epsZ2 from L^-1 epsilon e_j1, and J_jj = L_jj^2. It lies
+ *  on the boundary of each cone with w_i > 0, whose gradient cut is the tangent, and the cones of points with
+ *  w_i = 0 have no tangent at their apex. The cuts are valid for the whole cones, so an inexact continuous design only
+ *  weakens them. If the information matrix of the continuous design is singular, no cuts are added.
+ */
+SCIP_RETCODE ProbData::addSeedCuts(
+	SCIP*                 scip,               /**< SCIP data structure */
+	const vector<SCIP_Real>& weights,         /**< the weights of the continuous design */
+	int*                  ncuts               /**< pointer to store the number of cuts */
+) {
+	assert(SCIPgetStage(scip) == SCIP_STAGE_PROBLEM);
+	assert(poly_depth == 0);
+	assert(weights.size() == numvars);
+	*ncuts = 0;
+
+	vector<SCIP_Real> L;
+	weightedInformationMatrix(A, weights, epsilon * epsilon, L);
+	// the seeding is optional: a singular continuous design gives no cuts
+	if(!kernel.factor(dim, L.data())){
+		SCIPdebugMessage("information matrix of the continuous design is singular, no seed cuts\n");
+		return SCIP_OKAY;
+	}
+
+	// cones Z_ij^2 <= t_ij w_i of the points in the model
+	vector<SCIP_Real> y(dim);
+	SCIP_Real coefs[3];
+	for(int i = 0; i < numvars; i++){
+		if(weights[i] < 1e-9 || !hasPoint(i))
+			continue;
+		for(int j = 0; j < dim; j++){
+			y[j] = A[j][i];
+		}
+		kernel.solveLower(dim, L.data(), y.data());
+		for(int j = 0; j < dim; j++){
+			SCIP_Real z = weights[i] * y[j] * L[j * dim + j];
+			coneCutCoefs(z, z * z / weights[i], weights[i], coefs);
+			SCIP_VAR* vars[3] = {Z[i][j], t[i][j], bin_vars[i]};
+			SCIP_CALL(addCutRow(scip, conss, "seedcone" + std::to_string(i) + "_" + std::to_string(j), 3, vars, coefs, 0));
+			(*ncuts)++;
+		}
+	}
+
+	// cones epsZ^2 <= epsZ2: 2 u epsZ - epsZ2 <= u^2 at epsZ = u
+	for(int j1 = 0; j1 < dim; j1++){
+		y.assign(dim, 0);
+		y[j1] = epsilon;
+		kernel.solveLower(dim, L.data(), y.data());
+		for(int j2 = 0; j2 < dim; j2++){
+			SCIP_Real u = y[j2] * L[j2 * dim + j2];
+			if(REALABS(u) < 1e-9)
+				continue;
+			SCIP_VAR* vars[2] = {epsZ[j1][j2], epsZ2[j1][j2]};
+			SCIP_Real vals[2] = {2 * u, -1};
+			SCIP_CALL(addCutRow(scip, conss, "seedeps" + std::to_string(j1) + "_" + std::to_string(j2), 2, vars, vals, u * u));
+			(*ncuts)++;
+		}
+	}
+
+	// objective: the tangent of the concave function of the diagonal of J at J_jj = L_jj^2
+	SCIP_Real logdet = kernel.logdet(dim, L.data());
+	vector<SCIP_VAR*> vars(dim + 1);
+	vector<SCIP_Real> vals(dim + 1);
+	SCIP_Real rhs;
+	for(int j = 0; j < dim; j++){
+		SCIP_Real jval = L[j * dim + j] * L[j * dim + j];
+		vars[j] = J[j][j];
+		vals[j] = -(logdet_form ? 1.0 : exp(logdet / dim)) / (dim * jval);
+	}
+	vars[dim] = obj_var;
+	vals[dim] = 1;
+	// log form: obj <= sum_j (log J*_jj + (J_jj - J*_jj) / J*_jj) / dim - emptyvalue; the geometric mean is homogeneous
+	rhs = logdet_form ? logdet / dim - 1 - emptyvalue : 0;
+	SCIP_CALL(addCutRow(scip, conss, "seedobj", dim + 1, vars.data(), vals.data(), rhs));
+	(*ncuts)++;
+
+	return SCIP_OKAY;
+}
+
+
+/** returns the objective value of obj_var for an information matrix with the given log-determinant */
+SCIP_Real ProbData::objectiveOfLogdet(
+	SCIP_Real             logdet              /**< log-determinant of the information matrix */
+) const {
+	return objFromLogdet(logdet_form, dim, emptyvalue, logdet);
+}
+
+
+/** returns the objective value of obj_var for the design that contains the given points, or SCIP_INVALID if
+ *  its information matrix is singular
+ */
+SCIP_Real ProbData::designObjective(
+	const vector<int>&    points              /**< the points of the design */
+) const {
+	// the reduced Laplacian of a comparison design is sparse
+	if(!edges.empty()){
+		SCIP_Real logdet = laplacianLogdet(dim, edges, points, epsilon * epsilon);
+		return logdet == -HUGE_VAL ? SCIP_INVALID : objFromLogdet(logdet_form, dim, emptyvalue, logdet);
+	}
+
+	vector<SCIP_Real> L;
+	informationMatrix(A, points, epsilon * epsilon, L);
+	if(!kernel.factor(dim, L.data()))
+		return SCIP_INVALID;
+	return objFromLogdet(logdet_form, dim, emptyvalue, kernel.logdet(dim, L.data()));
+}
+
+
+/** solving process deinitialization method of transformed data (called before the branch and bound data is freed)
+ *
+ *  With polyhedral cones, obj of the incumbent can exceed the value of its design by the approximation error, while
+ *  the dual bound stays valid, since the approximation is a relaxation. This is only a report: the design of the
+ *  incumbent is evaluated exactly and printed as "Exact Primal Bound" with the gap to the dual bound. Incumbents below
+ *  the value of their design are repaired during the solve by the event handler designexact (event_exact.h); an
+ *  incumbent above it cannot be replaced, since SCIP keeps its best solution.
+ */
+SCIP_RETCODE ProbData::scip_exitsol(
+	SCIP*                 scip,               /**< SCIP data structure */
+	SCIP_Bool             restart             /**< was this exit solve call triggered by a restart? */
+) {
+	SCIP_SOL* sol = SCIPgetBestSol(scip);
+	if(poly_depth == 0 || restart || sol == NULL)
+		return SCIP_OKAY;
+
+	vector<int> points;
+	for(int i = 0; i < numvars; i++){
+		if(bin_vars[i] != NULL && SCIPgetSolVal(scip, sol, bin_vars[i]) > 0.5)
+			points.push_back(i);
+	}
+	SCIP_Real exact = designObjective(points);
+
+	SCIPinfoMessage(scip, NULL, "Polyhedral cones  : depth %d, %d cones, relative cone error <= %.2e\n", poly_depth,
+		(int) poly_cones.size(), 1 / cos(M_PI / pow(2.0, poly_depth + 1)) - 1);
+	SCIPinfoMessage(scip, NULL, "  incumbent obj   : %.9g (%d points)\n", SCIPgetSolVal(scip, sol, obj_var), (int) points.size());
+	if(exact == SCIP_INVALID)
+		SCIPinfoMessage(scip, NULL, "  exact obj       : - (singular information matrix)\n");
+	else{
+		SCIPinfoMessage(scip, NULL, "  exact obj       : %.9g\n", exact);
+		SCIPinfoMessage(scip, NULL, "Exact Primal Bound : %+.14e\n", -exact);
+		SCIPinfoMessage(scip, NULL, "Exact Gap          : %.2f %%\n", 100.0 * REALABS(SCIPgetDualbound(scip) + exact)
+			/ MAX(MIN(REALABS(SCIPgetDualbound(scip)), REALABS(exact)), 1e-9));
+	}
+
+	return SCIP_OKAY;
+}
+
+
+/** appends the bytes used by each structure of the problem data, including the headers of the vectors */
+void ProbData::memoryUsage(
+	vector<pair<string, size_t>>& items       /**< vector to append the names and sizes of the structures to */
+) const {
+	size_t polybytes = vectorBytes(poly_cones);
+	for(size_t c = 0; c < poly_cones.size(); c++){
+		polybytes += vectorBytes(poly_cones[c].xi) + vectorBytes(poly_cones[c].eta) - 2 * sizeof(vector<SCIP_VAR*>);
+	}
+
+	items.push_back(make_pair(string("A"), gridBytes(A)));
+	items.push_back(make_pair(string("E"), gridBytes(E)));
+	items.push_back(make_pair(string("Z"), gridBytes(Z)));
+	items.push_back(make_pair(string("t"), gridBytes(t)));
+	items.push_back(make_pair(string("J"), gridBytes(J)));
+	items.push_back(make_pair(string("epsZ"), gridBytes(epsZ)));
+	items.push_back(make_pair(string("epsZ2"), gridBytes(epsZ2)));
+	items.push_back(make_pair(string("bin_vars"), vectorBytes(bin_vars) + vectorBytes(w) + vectorBytes(knapweights)));
+	items.push_back(make_pair(string("conss"), vectorBytes(conss)));
+	items.push_back(make_pair(string("poly_cones"), polybytes));
+	items.push_back(make_pair(string("pricing"), vectorBytes(init_points) + gridBytes(azj_conss) + vectorBytes(sumt_conss)));
+}
+
+
 /**@} */
@@ -25,9 +25,11 @@
 
 #include "objscip/objscip.h"
 #include "scip/cons_linear.h"
+#include "linalgkernel.h"
 #include <map>
 #include <list>
 #include <vector>
+#include <string>
 #include <utility>
 
 using namespace scip;
@@ -42,10 +44,10 @@ public:
    ProbData(
 		const int numvars_,  /**< the number of items */
       const SCIP_Real dim_, /**< the problem dimension */
-      const vector<vector<SCIP_Real>> A_, /**<  A: dim_ * numvars_ */
+      const vector<vector<SCIP_Real>>& A_, /**<  A: dim_ * numvars_ */
       const int card_,
       const SCIP_Real epsilon_ /**<  epsilon: it is already sqrt, so the real epsilon in consideration is epsilon^2*/
-   ): numvars(numvars_), dim(dim_), A(A_), card(card_), epsilon(epsilon_){
+   ): numvars(numvars_), dim(dim_), A(A_), card(card_), epsilon(epsilon_), logdet_form(FALSE), poly_depth(0), use_pricing(FALSE), orig_data(NULL), card_cons(NULL), kernel(dimKernel((int) dim_)){
       E = vector<vector<SCIP_Real>> (dim, vector<SCIP_Real>(dim, 0));
       for(int i = 0; i < dim; i++){
          E[i][i] = epsilon;
@@ -65,6 +67,75 @@ public:
 	   SCIP*                 scip               /**< SCIP data structure */
    );
 
+   /** adds a point to the model during pricing or to the original problem: its binary, Z and t columns, its cones,
+    *  and its coefficients in the rows A Z = J, sum_i t_ij <= J_jj and the cardinality constraint
+    */
+   SCIP_RETCODE addPoint(
+	   SCIP*                 scip,              /**< SCIP data structure */
+	   int                   i,                 /**< index of the point */
+	   SCIP_Real             score              /**< pricing score of the point */
+   );
+
+   /** appends points to the data matrix of the original problem; in pricing mode they are left to the pricer,
+    *  otherwise they are added to the model
+    */
+   SCIP_RETCODE appendPoints(
+	   SCIP*                 scip,              /**< SCIP data structure */
+	   const vector<vector<SCIP_Real>>& points  /**< the new points, each with dim entries */
+   );
+
+   /** returns whether a point is in the model */
+   bool hasPoint(
+	   int                   i                  /**< index of the point */
+   ) const {
+      return bin_vars[i] != NULL;
+   }
+
+   /** creates a solution of the original problem for the design that contains the given points: the lifted
+    *  variables are set from the Cholesky factor of the information matrix
+    */
+   SCIP_RETCODE createDesignSol(
+	   SCIP*                 scip,              /**< SCIP data structure */
+	   const vector<int>&    points,            /**< the points of the design */
+	   SCIP_SOL**            sol                /**< pointer to store the solution */
+   );
+
+   /** adds a gradient cut coefs * (Z_ij, t_ij, w_i) <= 0 of the cone of a point as removable row of the initial LP
+    *  of the original problem
+    */
+   SCIP_RETCODE addConeCut(
+	   SCIP*                 scip,              /**< SCIP data structure */
+	   int                   i,                 /**< index of the point, must be in the model */
+	   int                   j,                 /**< index of the coordinate */
+	   const SCIP_Real*      coefs              /**< coefficients of Z_ij, t_ij and w_i */
+   );
+
+   /** adds the tangent cuts of the cones and of the objective at the lifted point of a continuous design as removable
+    *  rows of the initial LP of the original problem; adds no cuts if the continuous design is singular
+    */
+   SCIP_RETCODE addSeedCuts(
+	   SCIP*                 scip,              /**< SCIP data structure */
+	   const vector<SCIP_Real>& weights,        /**< the weights of the continuous design */
+	   int*                  ncuts              /**< pointer to store the number of cuts */
+   );
+
+   /** returns the objective value of obj_var for an information matrix with the given log-determinant */
+   SCIP_Real objectiveOfLogdet(
+	   SCIP_Real             logdet             /**< log-determinant of the information matrix */
+   ) const;
+
+   /** returns the objective value of obj_var for the design that contains the given points, or SCIP_INVALID if
+    *  its information matrix is singular
+    */
+   SCIP_Real designObjective(
+	   const vector<int>&    points             /**< the points of the design */
+   ) const;
+
+   /** appends the bytes used by each structure of the problem data, including the headers of the vectors */
+   void memoryUsage(
+	   vector<pair<string, size_t>>& items      /**< vector to append the names and sizes of the structures to */
+   ) const;
+
    /** release all */
    SCIP_RETCODE releaseAll(
 	   SCIP*                 scip               /**< SCIP data structure */
@@ -116,6 +187,45 @@ public:
       SCIP_Bool*         deleteobject        /**< pointer to store whether SCIP should delete the object after solving */
       );
 
+   /** copies the user problem data of a source SCIP to the original problem of a copy, e.g., the sub-SCIP of a
+    *  large neighborhood search heuristic or a solver of the concurrent mode
+    *
+    *  The columns and rows are mapped to their copies, which are captured by the copy. The copy has no pricer, so in
+    *  pricing mode it contains the points of the model of the source only.
+    */
+   virtual SCIP_RETCODE scip_copy(
+      SCIP*              scip,               /**< SCIP data structure of the copy */
+      SCIP*              sourcescip,         /**< source SCIP data structure */
+      SCIP_HASHMAP*      varmap,             /**< mapping of source variables to target variables */
+      SCIP_HASHMAP*      consmap,            /**< mapping of source constraints to target constraints */
+      ObjProbData**      objprobdata,        /**< pointer to store the copied problem data object */
+      SCIP_Bool          global,             /**< create a global or a local copy? */
+      SCIP_RESULT*       result              /**< pointer to store the result of the call */
+      );
+
+   /** solving process deinitialization method of transformed data (called before the branch and bound data is freed)
+    *
+    *  With polyhedral cones, the design of the incumbent is evaluated exactly.
+    */
+   virtual SCIP_RETCODE scip_exitsol(
+      SCIP*              scip,               /**< SCIP data structure */
+      SCIP_Bool          restart             /**< was this exit solve call triggered by a restart? */
+      );
+
+   /** lifted polyhedral approximation of depth k of the cone (2 u)^2 + (v - w)^2 <= (v + w)^2, i.e., u^2 <= v w
+    *  (Ben-Tal and Nemirovski): xi_0 >= |2 u|, eta_0 >= |v - w|, k rotations by pi / 2^(j+1) with
+    *  xi_j = c_j xi_(j-1) + s_j eta_(j-1), eta_j >= |c_j eta_(j-1) - s_j xi_(j-1)|, and xi_k <= v + w,
+    *  eta_k <= tan(pi / 2^(k+1)) xi_k
+    */
+   struct PolyCone
+   {
+      SCIP_VAR*          u;                  /**< variable of the square, not captured */
+      SCIP_VAR*          v;                  /**< first variable of the product, not captured */
+      SCIP_VAR*          w;                  /**< second variable of the product, not captured, or NULL for 1 */
+      vector<SCIP_VAR*>  xi;                 /**< rotated first coordinates xi_0, ..., xi_k */
+      vector<SCIP_VAR*>  eta;                /**< rotated second coordinates eta_0, ..., eta_k */
+   };
+
 
    // problem relevant data
    int dim; // the dimension
@@ -145,6 +255,47 @@ public:
    // settings
    SCIP_Bool is_nature;
    SCIP_Bool gradient_cut;
+   SCIP_Bool logdet_form; // objective as sum of logarithms of the diagonal of J instead of its geometric mean
+
+   // polyhedral mode: the cones are replaced by approximations of depth poly_depth, 0 keeps the exact cones
+   int poly_depth;
+   vector<PolyCone> poly_cones;
+
+   // column generation: only the points of init_points are in the initial model, the others are priced in
+   SCIP_Bool use_pricing;
+   vector<int> init_points;
+   vector<vector<SCIP_CONS*>> azj_conss; // rows A Z = J, upper triangle of dim * dim, not captured
+   vector<SCIP_CONS*> sumt_conss; // rows sum_i t_ij <= J_jj, not captured
+   SCIP_CONS* card_cons; // cardinality constraint, not captured
+
+   // Laplacian mode: the points are incidence vectors of the edges of a comparison design, see laplacian.h
+   vector<pair<int, int>> edges; // numvars, empty if the points are not all incidence vectors
+
+   const ProbData* orig_data; // original problem data, only set in the transformed problem data
+   DimKernel kernel; // dense kernels of the information matrix, specialized on dim if possible
+
+private:
+   /** creates the columns Z[i][*] and t[i][*] of a point */
+   SCIP_RETCODE createPointVars(
+	   SCIP*                 scip,              /**< SCIP data structure */
+	   int                   i,                 /**< index of the point */
+	   SCIP_Real             score              /**< pricing score of the point, if it is priced in */
+   );
+
+   /** creates the cones Z[i][j]^2 <= t[i][j] w[i] of a point and their linearizations */
+   SCIP_RETCODE createPointConss(
+	   SCIP*                 scip,              /**< SCIP data structure */
+	   int                   i                  /**< index of the point */
+   );
+
+   /** creates the variables and rows of the polyhedral approximation of u^2 <= v w */
+   SCIP_RETCODE createPolyCone(
+	   SCIP*                 scip,              /**< SCIP data structure */
+	   const string&         name,              /**< name prefix of the variables and rows */
+	   SCIP_VAR*             u,                 /**< variable of the square */
+	   SCIP_VAR*             v,                 /**< first variable of the product */
+	   SCIP_VAR*             w                  /**< second variable of the product, or NULL for 1 */
+   );
 
 };/*lint !e1712*/
 
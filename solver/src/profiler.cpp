@@ -0,0 +1,215 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   profiler.cpp
+ * @brief  scoped timers and hardware counters of the callbacks of the design plugins
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <chrono>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "profiler.h"
+
+using namespace std;
+
+std::atomic<int> Profiler::nenabled_(0);
+
+/** perf_event_open counter group of a thread, with the cycles as leader */
+class CounterGroup
+{
+public:
+   /** opens the counters; on failure, no counter is open */
+   CounterGroup() : ok_(false)
+   {
+      for( int c = 0; c < PROFILE_NCOUNTERS; c++ )
+         fds_[c] = -1;
+#ifdef __linux__
+      static const uint64_t configs[PROFILE_NCOUNTERS] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+         PERF_COUNT_HW_CACHE_MISSES };
+      for( int c = 0; c < PROFILE_NCOUNTERS; c++ )
+      {
+         struct perf_event_attr attr;
+         memset(&attr, 0, sizeof(attr));
+         attr.size = sizeof(attr);
+         attr.type = PERF_TYPE_HARDWARE;
+         attr.config = configs[c];
+         attr.read_format = PERF_FORMAT_GROUP;
+         // user space only, which perf_event_paranoid <= 2 allows without privileges
+         attr.exclude_kernel = 1;
+         attr.exclude_hv = 1;
+         fds_[c] = (int) syscall(SYS_perf_event_open, &attr, 0, -1, c == 0 ? -1 : fds_[0], 0);
+         if( fds_[c] < 0 )
+         {
+            close();
+            return;
+         }
+      }
+      ok_ = true;
+#endif
+   }
+
+   /** closes the counters */
+   ~CounterGroup()
+   {
+      close();
+   }
+
+   /** returns whether the counters are open */
+   bool ok() const
+   {
+      return ok_;
+   }
+
+   /** reads the counters; returns false if they are not available */
+   bool read(
+      long long*         values              /**< array to store the PROFILE_NCOUNTERS values */
+      ) const
+   {
+#ifdef __linux__
+      if( ok_ )
+      {
+         uint64_t buf[1 + PROFILE_NCOUNTERS];
+         if( ::read(fds_[0], buf, sizeof(buf)) == (ssize_t) sizeof(buf) && buf[0] == PROFILE_NCOUNTERS )
+         {
+            for( int c = 0; c < PROFILE_NCOUNTERS; c++ )
+               values[c] = (long long) buf[1 + c];
+            return true;
+         }
+      }
+#endif
+      for( int c = 0; c < PROFILE_NCOUNTERS; c++ )
+         values[c] = 0;
+      return false;
+   }
+
+private:
+   /** closes all open counters */
+   void close()
+   {
+#ifdef __linux__
+      for( int c = PROFILE_NCOUNTERS - 1; c >= 0; c-- )
+      {
+         if( fds_[c] >= 0 )
+            ::close(fds_[c]);
+         fds_[c] = -1;
+      }
+#endif
+      ok_ = false;
+   }
+
+   int                   fds_[PROFILE_NCOUNTERS]; /**< file descriptors of the counters */
+   bool                  ok_;                /**< are the counters open? */
+};
+
+/** returns the counter group of the calling thread, which is opened on the first call */
+static
+const CounterGroup& threadCounters()
+{
+   static thread_local CounterGroup group;
+   return group;
+}
+
+Profiler::Profiler() : enabled_(false)
+{
+}
+
+Profiler::~Profiler()
+{
+   setEnabled(false);
+}
+
+void Profiler::setEnabled(
+   bool                  enabled             /**< should the profiler record calls? */
+   )
+{
+   if( enabled == enabled_ )
+      return;
+   enabled_ = enabled;
+   nenabled_.fetch_add(enabled ? 1 : -1, std::memory_order_relaxed);
+}
+
+bool Profiler::hasCounters()
+{
+   return threadCounters().ok();
+}
+
+void Profiler::sample(
+   ProfileSample&        start               /**< sample to store the values */
+   )
+{
+   // the counters are read after the clock at the start and before it at the end, so they exclude the clock
+   start.seconds = chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+   threadCounters().read(start.counters);
+}
+
+void Profiler::record(
+   const char*           name,               /**< name of the callback */
+   const ProfileSample&  start               /**< sample at the start of the call */
+   )
+{
+   long long counters[PROFILE_NCOUNTERS];
+   threadCounters().read(counters);
+   double seconds = chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+
+   ProfileEntry& entry = entries_[name];
+   entry.calls++;
+   entry.seconds += seconds - start.seconds;
+   for( int c = 0; c < PROFILE_NCOUNTERS; c++ )
+      entry.counters[c] += counters[c] - start.counters[c];
+}
+
+bool Profiler::writeJson(
+   const string&         filename            /**< name of the file to write */
+   ) const
+{
+   FILE* file = fopen(filename.c_str(), "w");
+   if( file == NULL )
+      return false;
+
+   bool counters = hasCounters();
+   fprintf(file, "{\"counters\": %s, \"callbacks\": {", counters ? "true" : "false");
+   const char* sep = "";
+   for( map<string, ProfileEntry>::const_iterator it = entries_.begin(); it != entries_.end(); ++it )
+   {
+      const ProfileEntry& entry = it->second;
+      fprintf(file, "%s\n  \"%s\": {\"calls\": %lld, \"seconds\": %.6f", sep, it->first.c_str(), entry.calls,
+         entry.seconds);
+      if( counters )
+      {
+         fprintf(file, ", \"cycles\": %lld, \"instructions\": %lld, \"llc_misses\": %lld, \"ipc\": %.3f",
+            entry.counters[PROFILE_CYCLES], entry.counters[PROFILE_INSTRUCTIONS], entry.counters[PROFILE_LLCMISSES],
+            entry.counters[PROFILE_CYCLES] > 0
+            ? (double) entry.counters[PROFILE_INSTRUCTIONS] / entry.counters[PROFILE_CYCLES] : 0.0);
+      }
+      else
+         fprintf(file, ", \"cycles\": null, \"instructions\": null, \"llc_misses\": null, \"ipc\": null");
+      fprintf(file, "}");
+      sep = ",";
+   }
+   fprintf(file, "\n}}\n");
+
+   return fclose(file) == 0;
+}
@@ -0,0 +1,135 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   profiler.h
+ * @brief  scoped timers and hardware counters of the callbacks of the design plugins
+ * @author Liding Xu
+ *
+ * A Profiler aggregates, per callback name, the number of calls, the wall clock time and, on Linux, the cycles,
+ * instructions and last-level cache misses of the calling thread, read from a perf_event_open counter group at the
+ * start and the end of every call. Nested calls are counted in both callbacks. If the counters cannot be opened (no
+ * PMU, as in most virtual machines, or perf_event_paranoid forbids it), only calls and times are recorded.
+ *
+ * The counters are opened once per thread and shared by all profilers of the thread. While no profiler of the process
+ * is enabled, a scope costs one relaxed atomic load.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __DOPT_PROFILER_H__
+#define __DOPT_PROFILER_H__
+
+#include <atomic>
+#include <map>
+#include <string>
+
+/** hardware counters of the profiler */
+enum ProfileCounter
+{
+   PROFILE_CYCLES = 0,                       /**< CPU cycles */
+   PROFILE_INSTRUCTIONS = 1,                 /**< retired instructions */
+   PROFILE_LLCMISSES = 2                     /**< last-level cache misses */
+};
+#define PROFILE_NCOUNTERS      3
+
+/** aggregate of the calls of a callback */
+struct ProfileEntry
+{
+   long long             calls;              /**< number of calls */
+   double                seconds;            /**< wall clock time of the calls */
+   long long             counters[PROFILE_NCOUNTERS]; /**< counter values of the calls */
+
+   ProfileEntry() : calls(0), seconds(0.0)
+   {
+      for( int c = 0; c < PROFILE_NCOUNTERS; c++ )
+         counters[c] = 0;
+   }
+};
+
+/** time and counter values at the start of a call */
+struct ProfileSample
+{
+   double                seconds;            /**< time in seconds since an arbitrary point */
+   long long             counters[PROFILE_NCOUNTERS]; /**< counter values */
+};
+
+/** profiler of the callbacks of one SCIP instance */
+class Profiler
+{
+public:
+   /** creates a disabled profiler */
+   Profiler();
+
+   /** destructor */
+   ~Profiler();
+
+   /** returns whether any profiler of the process is enabled */
+   static bool anyEnabled()
+   {
+      return nenabled_.load(std::memory_order_relaxed) > 0;
+   }
+
+   /** returns whether the profiler is enabled */
+   bool enabled() const
+   {
+      return enabled_;
+   }
+
+   /** enables or disables the profiler */
+   void setEnabled(
+      bool               enabled             /**< should the profiler record calls? */
+      );
+
+   /** returns whether the hardware counters of the calling thread are available */
+   static bool hasCounters();
+
+   /** reads the time and the counters at the start of a call */
+   static void sample(
+      ProfileSample&     start               /**< sample to store the values */
+      );
+
+   /** adds a call that started at a sample to the aggregate of a callback */
+   void record(
+      const char*        name,               /**< name of the callback */
+      const ProfileSample& start             /**< sample at the start of the call */
+      );
+
+   /** returns the aggregates by callback name */
+   const std::map<std::string, ProfileEntry>& entries() const
+   {
+      return entries_;
+   }
+
+   /** removes all aggregates */
+   void clear()
+   {
+      entries_.clear();
+   }
+
+   /** writes the aggregates as JSON object; returns false if the file cannot be written */
+   bool writeJson(
+      const std::string& filename            /**< name of the file to write */
+      ) const;
+
+private:
+   Profiler(const Profiler&);
+   Profiler& operator=(const Profiler&);
+
+   static std::atomic<int> nenabled_;        /**< number of enabled profilers of the process */
+   bool                  enabled_;           /**< is the profiler enabled? */
+   std::map<std::string, ProfileEntry> entries_; /**< aggregates by callback name */
+};
+
+#endif
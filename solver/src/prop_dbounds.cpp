@@ -0,0 +1,305 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   prop_dbounds.cpp
+ * @brief  propagator that derives finite bounds for the continuous columns of the design model
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+
+#include "prop_dbounds.h"
+#include "probdata.h"
+#include "laplacian.h"
+#include "table_profile.h"
+
+using namespace scip;
+using namespace std;
+
+#define PROP_NAME              "designbounds"
+#define PROP_DESC              "finite bounds of Z, t, J, epsZ and obj_var from A, card and epsilon"
+#define PROP_PRIORITY          1000000       /**< propagator priority */
+#define PROP_FREQ              1             /**< propagator frequency */
+#define PROP_DELAY             FALSE         /**< should propagation method be delayed, if other propagators found reductions? */
+#define PROP_TIMING            SCIP_PROPTIMING_BEFORELP /**< propagation timing mask */
+#define PROP_PRESOL_PRIORITY   1000000       /**< priority of the presolving method */
+#define PROP_PRESOL_MAXROUNDS  -1            /**< maximal number of presolving rounds the presolver participates in */
+#define PROP_PRESOLTIMING      SCIP_PRESOLTIMING_FAST /**< timing mask of the presolving method */
+
+
+/** returns a derived bound relaxed by the feasibility tolerance */
+static
+SCIP_Real relaxBound(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_Real             bound               /**< derived bound */
+   )
+{
+   return bound + SCIPfeastol(scip) * MAX(1.0, REALABS(bound));
+}
+
+/** tightens the bounds of a variable to [lb, ub], skipping multi-aggregated variables */
+static
+SCIP_RETCODE tightenBounds(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR*             var,                /**< variable, or NULL */
+   SCIP_Real             lb,                 /**< new lower bound, or -infinity */
+   SCIP_Real             ub,                 /**< new upper bound */
+   int*                  nchgbds,            /**< pointer to increase by the number of tightened bounds */
+   SCIP_Bool*            cutoff              /**< pointer to store whether a bound is infeasible */
+   )
+{
+   if( var == NULL || *cutoff || SCIPvarGetStatus(var) == SCIP_VARSTATUS_MULTAGGR )
+      return SCIP_OKAY;
+
+   SCIP_Bool tightened;
+   if( !SCIPisInfinity(scip, -lb) )
+   {
+      SCIP_CALL( SCIPtightenVarLb(scip, var, lb, FALSE, cutoff, &tightened) );
+      if( tightened )
+         (*nchgbds)++;
+      if( *cutoff )
+         return SCIP_OKAY;
+   }
+   SCIP_CALL( SCIPtightenVarUb(scip, var, ub, FALSE, cutoff, &tightened) );
+   if( tightened )
+      (*nchgbds)++;
+
+   return SCIP_OKAY;
+}
+
+
+/** default constructor */
+PropDesignBounds::PropDesignBounds(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjProp(scip, PROP_NAME, PROP_DESC, PROP_PRIORITY, PROP_FREQ, PROP_DELAY, PROP_TIMING, PROP_PRESOL_PRIORITY,
+      PROP_PRESOL_MAXROUNDS, PROP_PRESOLTIMING),
+     ubtrace_(0.0),
+     maxpoints_(0),
+     npresolchgbds_(0),
+     nnodechgbds_(0)
+{
+}
+
+
+/** initialization method of propagator (called after problem was transformed) */
+SCIP_DECL_PROPINIT(PropDesignBounds::scip_init)
+{
+   npresolchgbds_ = 0;
+   nnodechgbds_ = 0;
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of propagator (called before branch and bound process data is freed) */
+SCIP_DECL_PROPEXITSOL(PropDesignBounds::scip_exitsol)
+{
+   if( !restart )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "designbounds propagator: %d bounds in presolving, %d at nodes\n",
+         npresolchgbds_, nnodechgbds_);
+   }
+
+   ubdiag_.clear();
+   wlb_.clear();
+   wub_.clear();
+   buffer_.clear();
+
+   return SCIP_OKAY;
+}
+
+
+/** computes the bounds U_j of the diagonal of J and the bound of the trace for the bounds of the binaries */
+void PropDesignBounds::computeBounds(
+   const ProbData*       probdata,           /**< transformed problem data */
+   SCIP_Bool             local               /**< use the local bounds of the binaries instead of the global ones? */
+   )
+{
+   int numvars = probdata->numvars;
+   int dim = probdata->dim;
+   SCIP_Real eps2 = probdata->epsilon * probdata->epsilon;
+
+   wlb_.assign(numvars, 0.0);
+   wub_.assign(numvars, 1.0);
+   int nones = 0;
+   int nfree = 0;
+   for( int i = 0; i < numvars; i++ )
+   {
+      if( probdata->hasPoint(i) )
+      {
+         SCIP_VAR* var = probdata->bin_vars[i];
+         wlb_[i] = local ? SCIPvarGetLbLocal(var) : SCIPvarGetLbGlobal(var);
+         wub_[i] = local ? SCIPvarGetUbLocal(var) : SCIPvarGetUbGlobal(var);
+      }
+      if( wlb_[i] > 0.5 )
+         nones++;
+      else if( wub_[i] > 0.5 )
+         nfree++;
+   }
+
+   /* number of free points that can be chosen in addition to the fixed ones */
+   int nchoose = nfree;
+   if( probdata->has_cardcons )
+      nchoose = MIN(nfree, MAX((int) probdata->card - nones, 0));
+   maxpoints_ = nones + nchoose;
+
+   /* sum of the nchoose largest values of the free points plus the values of the points fixed to 1 */
+   auto boundOfSum = [this, numvars, nchoose](const function<SCIP_Real(int)>& value)
+   {
+      SCIP_Real sum = 0.0;
+      buffer_.clear();
+      for( int i = 0; i < numvars; i++ )
+      {
+         if( wlb_[i] > 0.5 )
+            sum += value(i);
+         else if( wub_[i] > 0.5 )
+            buffer_.push_back(value(i));
+      }
+      if( nchoose < (int) buffer_.size() )
+         nth_element(buffer_.begin(), buffer_.begin() + nchoose, buffer_.end(), greater<SCIP_Real>());
+      for( int k = 0; k < nchoose; k++ )
+         sum += buffer_[k];
+      return sum;
+   };
+
+   const vector<vector<SCIP_Real>>& A = probdata->A;
+   ubdiag_.resize(dim);
+   for( int j = 0; j < dim; j++ )
+      ubdiag_[j] = eps2 + boundOfSum([&A, j](int i) { return A[j][i] * A[j][i]; });
+
+   ubtrace_ = dim * eps2 + boundOfSum([&A, dim](int i)
+      {
+         SCIP_Real norm2 = 0.0;
+         for( int j = 0; j < dim; j++ )
+            norm2 += A[j][i] * A[j][i];
+         return norm2;
+      });
+}
+
+
+/** tightens the bounds of the columns to the bounds derived from the last computeBounds() */
+SCIP_RETCODE PropDesignBounds::applyBounds(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const ProbData*       probdata,           /**< transformed problem data */
+   int*                  nchgbds,            /**< pointer to increase by the number of tightened bounds */
+   SCIP_Bool*            cutoff              /**< pointer to store whether a bound is infeasible */
+   )
+{
+   int numvars = probdata->numvars;
+   int dim = probdata->dim;
+   *cutoff = FALSE;
+
+   SCIP_Real logdet = 0.0;
+   for( int j = 0; j < dim && !*cutoff; j++ )
+   {
+      SCIP_Real ub = relaxBound(scip, ubdiag_[j]);
+      SCIP_Real zub = relaxBound(scip, sqrt(ubdiag_[j]));
+      logdet += log(MAX(ubdiag_[j], 0.0));
+
+      SCIP_CALL( tightenBounds(scip, probdata->J[j][j], -SCIPinfinity(scip), ub, nchgbds, cutoff) );
+      SCIP_CALL( tightenBounds(scip, probdata->t[numvars][j], -SCIPinfinity(scip), ub, nchgbds, cutoff) );
+      for( int k = 0; k < dim; k++ )
+      {
+         SCIP_CALL( tightenBounds(scip, probdata->epsZ2[k][j], -SCIPinfinity(scip), ub, nchgbds, cutoff) );
+         SCIP_CALL( tightenBounds(scip, probdata->epsZ[k][j], -zub, zub, nchgbds, cutoff) );
+      }
+
+      for( int i = 0; i < numvars && !*cutoff; i++ )
+      {
+         if( !probdata->hasPoint(i) )
+            continue;
+         SCIP_Real zubi = relaxBound(scip, sqrt(ubdiag_[j] * MAX(wub_[i], 0.0)));
+         SCIP_CALL( tightenBounds(scip, probdata->t[i][j], -SCIPinfinity(scip), ub, nchgbds, cutoff) );
+         SCIP_CALL( tightenBounds(scip, probdata->Z[i][j], -zubi, zubi, nchgbds, cutoff) );
+      }
+   }
+
+   /* Hadamard: det <= prod_j U_j, and the means: det <= (trace / dim)^dim; without regularization, a U_j can be 0 */
+   if( !*cutoff && *min_element(ubdiag_.begin(), ubdiag_.end()) > 0.0 )
+   {
+      logdet = MIN(logdet, dim * log(ubtrace_ / dim));
+      if( !probdata->edges.empty() && probdata->epsilon > 0.0 )
+         logdet = MIN(logdet, laplacianLogdetBound(dim, maxpoints_, probdata->epsilon * probdata->epsilon));
+      SCIP_Real objub = relaxBound(scip, probdata->objectiveOfLogdet(logdet));
+      SCIP_CALL( tightenBounds(scip, probdata->obj_var, -SCIPinfinity(scip), objub, nchgbds, cutoff) );
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** presolving method of propagator */
+SCIP_DECL_PROPPRESOL(PropDesignBounds::scip_presol)
+{
+   DOPT_PROFILE(scip, "designbounds/presol");
+   *result = SCIP_DIDNOTRUN;
+
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( probdata == NULL )
+      return SCIP_OKAY;
+
+   /* the bounds only change if binaries were fixed since the last round */
+   if( nrounds > 0 && nnewfixedvars == 0 && nnewaggrvars == 0 && nnewchgbds == 0 )
+      return SCIP_OKAY;
+
+   *result = SCIP_DIDNOTFIND;
+   computeBounds(probdata, FALSE);
+
+   int nchanged = 0;
+   SCIP_Bool cutoff;
+   SCIP_CALL( applyBounds(scip, probdata, &nchanged, &cutoff) );
+   *nchgbds += nchanged;
+   npresolchgbds_ += nchanged;
+
+   if( cutoff )
+      *result = SCIP_CUTOFF;
+   else if( nchanged > 0 )
+      *result = SCIP_SUCCESS;
+
+   return SCIP_OKAY;
+}
+
+
+/** execution method of propagator */
+SCIP_DECL_PROPEXEC(PropDesignBounds::scip_exec)
+{
+   DOPT_PROFILE(scip, "designbounds/exec");
+   *result = SCIP_DIDNOTRUN;
+
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( probdata == NULL )
+      return SCIP_OKAY;
+
+   *result = SCIP_DIDNOTFIND;
+   computeBounds(probdata, TRUE);
+
+   int nchanged = 0;
+   SCIP_Bool cutoff;
+   SCIP_CALL( applyBounds(scip, probdata, &nchanged, &cutoff) );
+   nnodechgbds_ += nchanged;
+
+   if( cutoff )
+      *result = SCIP_CUTOFF;
+   else if( nchanged > 0 )
+      *result = SCIP_REDUCEDDOM;
+
+   return SCIP_OKAY;
+}
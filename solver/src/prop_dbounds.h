@@ -0,0 +1,116 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   prop_dbounds.h
+ * @brief  propagator that derives finite bounds for the continuous columns of the design model
+ * @author Liding Xu
+ *
+ * Let B = [A, epsilon I] and z_j the column j of Z together with epsZ[*][j]. The row A_j Z_j + epsilon epsZ_jj = J_jj
+ * and the cones give J_jj = B_j z_j and sum_i Z_ij^2 / w_i + sum_k epsZ_kj^2 <= J_jj, so by the Cauchy-Schwarz
+ * inequality J_jj^2 <= (sum_i A_ji^2 w_i + epsilon^2) J_jj, i.e.,
+ *
+ *    J_jj <= U_j := epsilon^2 + max { sum_i A_ji^2 w_i : sum_i w_i <= card, w within its bounds },
+ *
+ * the sum of epsilon^2, of A_ji^2 over the points fixed to 1, and of the card - #fixed largest A_ji^2 over the free
+ * points. From U_j follow t_ij, epsZ2_kj <= U_j, |Z_ij| <= sqrt(U_j ub(w_i)) and |epsZ_kj| <= sqrt(U_j). By the
+ * Hadamard inequality and the inequality of the means, the log-determinant of the design is at most the minimum of
+ * sum_j log U_j and dim log(T / dim), where T bounds the trace sum_j U_j in the same way with the squared norms of
+ * the points, which bounds obj_var. For comparison designs, the spanning tree bound of laplacianLogdetBound() for
+ * designs of at most #fixed + card - #fixed edges bounds the log-determinant, too.
+ *
+ * The bounds are set in presolving from the global bounds of the binaries and tightened at every node from the
+ * local bounds. In pricing mode, points that are not in the model are free, since they may be priced in. The
+ * bounds are relaxed by the feasibility tolerance, and the off-diagonal entries of J, which are in no row, are not
+ * bounded.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_PROP_DBOUNDS_H__
+#define __SCIP_PROP_DBOUNDS_H__
+
+#include <vector>
+#include "objscip/objscip.h"
+
+class ProbData;
+
+
+/** propagator for the bounds of Z, t, J, epsZ, epsZ2 and obj_var */
+class PropDesignBounds : public scip::ObjProp
+{
+public:
+   /** default constructor */
+   PropDesignBounds(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~PropDesignBounds()
+   {
+   }
+
+   /** clone method which will be used to copy the propagator to sub-SCIPs, whose copied problem data it bounds */
+   virtual scip::ObjCloneable* clone(
+      SCIP*              scip                /**< SCIP data structure of the copy */
+      ) const
+   {
+      return new PropDesignBounds(scip);
+   }
+
+   /** returns whether the propagator can be copied to sub-SCIPs */
+   virtual SCIP_Bool iscloneable() const
+   {
+      return TRUE;
+   }
+
+   /** initialization method of propagator (called after problem was transformed) */
+   virtual SCIP_DECL_PROPINIT(scip_init);
+
+   /** solving process deinitialization method of propagator (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_PROPEXITSOL(scip_exitsol);
+
+   /** presolving method of propagator */
+   virtual SCIP_DECL_PROPPRESOL(scip_presol);
+
+   /** execution method of propagator */
+   virtual SCIP_DECL_PROPEXEC(scip_exec);
+
+private:
+   /** computes the bounds U_j of the diagonal of J and the bound of the trace for the bounds of the binaries */
+   void computeBounds(
+      const ProbData*    probdata,           /**< transformed problem data */
+      SCIP_Bool          local               /**< use the local bounds of the binaries instead of the global ones? */
+      );
+
+   /** tightens the bounds of the columns to the bounds derived from the last computeBounds() */
+   SCIP_RETCODE applyBounds(
+      SCIP*              scip,               /**< SCIP data structure */
+      const ProbData*    probdata,           /**< transformed problem data */
+      int*               nchgbds,            /**< pointer to increase by the number of tightened bounds */
+      SCIP_Bool*         cutoff              /**< pointer to store whether a bound is infeasible */
+      );
+
+   std::vector<SCIP_Real> ubdiag_;           /**< bounds U_j of the diagonal of J */
+   SCIP_Real             ubtrace_;           /**< bound of the trace of J */
+   int                   maxpoints_;         /**< maximal number of points of a design */
+   std::vector<SCIP_Real> wlb_;              /**< lower bounds of the binaries, 0 for points that are not in the model */
+   std::vector<SCIP_Real> wub_;              /**< upper bounds of the binaries, 1 for points that are not in the model */
+   std::vector<SCIP_Real> buffer_;           /**< squares of the entries of the free points */
+   int                   npresolchgbds_;     /**< number of bounds tightened in presolving */
+   int                   nnodechgbds_;       /**< number of bounds tightened at the nodes */
+};/*lint !e1712*/
+
+
+#endif
@@ -0,0 +1,230 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   prop_enum.cpp
+ * @brief  propagator that solves small instances and small subtrees by exhaustive enumeration of the designs
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+
+#include "prop_enum.h"
+#include "probdata.h"
+#include "enumerate.h"
+#include "linalg.h"
+#include "table_profile.h"
+
+using namespace scip;
+using namespace std;
+
+#define PROP_NAME              "designenum"
+#define PROP_DESC              "exhaustive enumeration of the designs of small subtrees"
+#define PROP_PRIORITY          500000        /**< propagator priority */
+#define PROP_FREQ              -1            /**< propagator frequency, off by default (settings/scip17.set) */
+#define PROP_DELAY             FALSE         /**< should propagation method be delayed, if other propagators found reductions? */
+#define PROP_TIMING            SCIP_PROPTIMING_BEFORELP /**< propagation timing mask */
+#define PROP_PRESOL_PRIORITY   0             /**< priority of the presolving method */
+#define PROP_PRESOL_MAXROUNDS  0             /**< maximal number of presolving rounds the presolver participates in */
+#define PROP_PRESOLTIMING      SCIP_PRESOLTIMING_NONE /**< timing mask of the presolving method */
+
+#define DEFAULT_MAXFREE        40            /**< maximal number of free points of a node below the root */
+#define DEFAULT_MAXSUBSETS     1e6           /**< maximal number of designs of a node below the root */
+#define DEFAULT_ROOTMAXSUBSETS 1e9           /**< maximal number of designs of the root node */
+#define DEFAULT_NTHREADS       1             /**< number of threads of the enumeration */
+
+
+/** default constructor */
+PropEnumerate::PropEnumerate(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjProp(scip, PROP_NAME, PROP_DESC, PROP_PRIORITY, PROP_FREQ, PROP_DELAY, PROP_TIMING, PROP_PRESOL_PRIORITY,
+      PROP_PRESOL_MAXROUNDS, PROP_PRESOLTIMING),
+     maxfree_(DEFAULT_MAXFREE),
+     maxsubsets_(DEFAULT_MAXSUBSETS),
+     rootmaxsubsets_(DEFAULT_ROOTMAXSUBSETS),
+     nthreads_(DEFAULT_NTHREADS),
+     pool_(NULL),
+     clock_(NULL),
+     ncalls_(0),
+     ncutoffs_(0),
+     nsols_(0),
+     nleaves_(0)
+{
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "propagating/" PROP_NAME "/maxfree",
+         "maximal number of free points of a node below the root whose designs are enumerated",
+         &maxfree_, FALSE, DEFAULT_MAXFREE, 0, INT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "propagating/" PROP_NAME "/maxsubsets",
+         "maximal number of designs of a node below the root that are enumerated",
+         &maxsubsets_, FALSE, DEFAULT_MAXSUBSETS, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "propagating/" PROP_NAME "/rootmaxsubsets",
+         "maximal number of designs of the root node that are enumerated, which solves the instance",
+         &rootmaxsubsets_, FALSE, DEFAULT_ROOTMAXSUBSETS, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "propagating/" PROP_NAME "/nthreads",
+         "number of threads of the enumeration",
+         &nthreads_, FALSE, DEFAULT_NTHREADS, 1, 64, NULL, NULL) );
+}
+
+
+/** solving process initialization method of propagator (called when branch and bound process is about to begin) */
+SCIP_DECL_PROPINITSOL(PropEnumerate::scip_initsol)
+{
+   /* the pool is kept between solves unless the number of threads changed */
+   if( pool_ != NULL && pool_->getNThreads() != nthreads_ )
+   {
+      delete pool_;
+      pool_ = NULL;
+   }
+
+   SCIP_CALL( SCIPcreateClock(scip, &clock_) );
+   ncalls_ = 0;
+   ncutoffs_ = 0;
+   nsols_ = 0;
+   nleaves_ = 0;
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of propagator (called before branch and bound process data is freed) */
+SCIP_DECL_PROPEXITSOL(PropEnumerate::scip_exitsol)
+{
+   if( !restart && ncalls_ > 0 )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+         "designenum propagator: %d enumerations, %lld designs evaluated, %d nodes cut off, %d solutions, %.2f s\n",
+         ncalls_, nleaves_, ncutoffs_, nsols_, SCIPgetClockTime(scip, clock_));
+   }
+
+   SCIP_CALL( SCIPfreeClock(scip, &clock_) );
+   fixed_.clear();
+   candidates_.clear();
+
+   return SCIP_OKAY;
+}
+
+
+/** execution method of propagator */
+SCIP_DECL_PROPEXEC(PropEnumerate::scip_exec)
+{
+   DOPT_PROFILE(scip, "designenum/exec");
+   *result = SCIP_DIDNOTRUN;
+
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( probdata == NULL || !probdata->has_cardcons || probdata->has_knapcons || probdata->use_pricing
+      || probdata->epsilon <= 0.0 )
+      return SCIP_OKAY;
+
+   /* the points fixed to 1 and the free points at the node */
+   fixed_.clear();
+   candidates_.clear();
+   for( int i = 0; i < probdata->numvars; i++ )
+   {
+      SCIP_VAR* var = probdata->bin_vars[i];
+      if( SCIPvarGetLbLocal(var) > 0.5 )
+         fixed_.push_back(i);
+      else if( SCIPvarGetUbLocal(var) > 0.5 )
+         candidates_.push_back(i);
+   }
+
+   /* infeasible cardinalities are left to the cardinality constraint */
+   int size = (int) floor(probdata->card + 0.5) - (int) fixed_.size();
+   if( size < 0 || size > (int) candidates_.size() )
+      return SCIP_OKAY;
+
+   SCIP_Real nsubsets = binomialCount((int) candidates_.size(), size);
+   if( SCIPgetDepth(scip) == 0 ? nsubsets > rootmaxsubsets_
+      : (int) candidates_.size() > maxfree_ || nsubsets > maxsubsets_ )
+      return SCIP_OKAY;
+
+   *result = SCIP_DIDNOTFIND;
+   SCIP_CALL( SCIPstartClock(scip, clock_) );
+   SCIP_Real eps2 = probdata->epsilon * probdata->epsilon;
+
+   /* only designs better than the design of the incumbent are of interest */
+   SCIP_Real lowerbound = -HUGE_VAL;
+   SCIP_SOL* incumbent = SCIPgetBestSol(scip);
+   vector<int> points;
+   if( incumbent != NULL )
+   {
+      for( int i = 0; i < probdata->numvars; i++ )
+      {
+         if( SCIPgetSolVal(scip, incumbent, probdata->bin_vars[i]) > 0.5 )
+            points.push_back(i);
+      }
+      vector<SCIP_Real> L;
+      informationMatrix(probdata->A, points, eps2, L);
+      if( probdata->kernel.factor(probdata->dim, L.data()) )
+         lowerbound = probdata->kernel.logdet(probdata->dim, L.data());
+   }
+
+   SCIP_Real timelimit;
+   SCIP_CALL( SCIPgetRealParam(scip, "limits/time", &timelimit) );
+   if( !SCIPisInfinity(scip, timelimit) )
+      timelimit = MAX(timelimit - SCIPgetSolvingTime(scip), 0.0);
+   else
+      timelimit = 1e20;
+
+   if( pool_ == NULL && nthreads_ > 1 )
+      pool_ = new ThreadPool(nthreads_);
+
+   vector<int> design;
+   SCIP_Real logdet;
+   EnumerationStats stats;
+   bool complete = enumerateDesigns(probdata->A, eps2, probdata->kernel, fixed_, candidates_, size, lowerbound,
+      timelimit, pool_, design, logdet, stats);
+   ncalls_++;
+   nleaves_ += stats.nleaves;
+
+   SCIP_Bool stored = FALSE;
+   if( !design.empty() )
+   {
+      SCIP_SOL* sol;
+      SCIP_CALL( probdata->createDesignSol(scip, design, &sol) );
+      SCIP_CALL( SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored) );
+      if( stored )
+         nsols_++;
+   }
+   else if( complete && lowerbound > -HUGE_VAL
+      && SCIPisLT(scip, -probdata->objectiveOfLogdet(lowerbound), SCIPgetPrimalbound(scip)) )
+   {
+      /* the bound was the exact value of the incumbent design, which the incumbent itself may not reach, e.g., if it
+       * is an LP or sub-SCIP solution whose lifted variables are not optimal; the subtree is only cut off once the
+       * lifted solution of this design is stored, since the subtree can contain it
+       */
+      SCIP_SOL* sol;
+      SCIP_CALL( probdata->createDesignSol(scip, points, &sol) );
+      SCIP_CALL( SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored) );
+      if( stored )
+         nsols_++;
+      else
+         complete = false;
+   }
+   SCIP_CALL( SCIPstopClock(scip, clock_) );
+
+   SCIPdebugMsg(scip, "enumerated %g designs of %d points at depth %d: %lld designs evaluated, log-determinant %g%s\n",
+      nsubsets, size, SCIPgetDepth(scip), stats.nleaves, logdet, complete ? "" : " (time limit)");
+
+   /* the subtree has no better design than the incumbent, unless its best design was rejected */
+   if( complete && (design.empty() || stored) )
+   {
+      ncutoffs_++;
+      *result = SCIP_CUTOFF;
+   }
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,85 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/**@file   prop_enum.h
+ * @brief  propagator that solves small instances and small subtrees by exhaustive enumeration of the designs
+ * @author Liding Xu
+ *
+ * At a node with the points F fixed to 1 and the free points C, the designs of the subtree are F together with
+ * card - |F| points of C. If there are at most "maxsubsets" of them and |C| <= "maxfree", the propagator enumerates
+ * them with enumerateDesigns() of enumerate.h, submits the best design as solution, and cuts the node off: no design
+ * of the subtree is better than the incumbent anymore. At the root node, the limit is "rootmaxsubsets" and there is
+ * no limit on |C|, so small instances are solved before the first LP.
+ *
+ * The enumeration starts from the log-determinant of the design of the incumbent, so subtrees without a better
+ * design are pruned early. It works on the exact information matrices, so with polyhedral cones the cutoff is valid
+ * for the design problem, while the LP relaxation of the subtree could have a larger value of obj_var. The
+ * propagator does not run in pricing mode, whose points outside of the model are free, or without a cardinality
+ * constraint or the regularization epsilon > 0.
+ *
+ * The propagator is off by default ("propagating/designenum/freq" -1), since the enumeration at the root changes the
+ * run time of every setting; settings/scip17.set runs it at every node.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_PROP_ENUM_H__
+#define __SCIP_PROP_ENUM_H__
+
+#include <vector>
+#include "objscip/objscip.h"
+#include "threadpool.h"
+
+
+/** propagator that enumerates the designs of small subtrees */
+class PropEnumerate : public scip::ObjProp
+{
+public:
+   /** default constructor */
+   PropEnumerate(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~PropEnumerate()
+   {
+      delete pool_;
+   }
+
+   /** solving process initialization method of propagator (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_PROPINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of propagator (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_PROPEXITSOL(scip_exitsol);
+
+   /** execution method of propagator */
+   virtual SCIP_DECL_PROPEXEC(scip_exec);
+
+private:
+   int                   maxfree_;           /**< maximal number of free points of a node below the root */
+   SCIP_Real             maxsubsets_;        /**< maximal number of designs of a node below the root */
+   SCIP_Real             rootmaxsubsets_;    /**< maximal number of designs of the root node */
+   int                   nthreads_;          /**< number of threads of the enumeration */
+   ThreadPool*           pool_;              /**< thread pool, or NULL before the first enumeration with threads */
+   std::vector<int>      fixed_;             /**< points fixed to 1 at the node */
+   std::vector<int>      candidates_;        /**< free points at the node */
+   SCIP_CLOCK*           clock_;             /**< time spent in the enumerations */
+   int                   ncalls_;            /**< number of enumerations in the current solve */
+   int                   ncutoffs_;          /**< number of nodes cut off in the current solve */
+   int                   nsols_;             /**< number of designs stored as solutions in the current solve */
+   long long             nleaves_;           /**< number of designs evaluated in the current solve */
+};/*lint !e1712*/
+
+
+#endif
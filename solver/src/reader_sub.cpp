@@ -33,6 +33,12 @@
 
 #include "probdata.h"
 #include "reader_sub.h"
+#include "linalg.h"
+#include "laplacian.h"
+#include "table_mem.h"
+#include "event_cache.h"
+#include "datastream.h"
+#include "table_profile.h"
 
 using namespace scip;
 using namespace std;
@@ -72,53 +78,260 @@ SCIP_DECL_READERWRITE(ReaderSubmodular::scip_write)
  *  If the reader detected an error in the input file, it should return with RETCODE SCIP_READERR or SCIP_NOFILE.
  */
 SCIP_DECL_READERREAD(ReaderSubmodular::scip_read) {
+	DOPT_PROFILE(scip, "reader/read");
 	*result = SCIP_DIDNOTRUN;
 
    	SCIPdebugMessage("Start read!\n");
-	ifstream filedata(filename);
-	if (!filedata) {
-		return SCIP_READERROR;
-	}
-	filedata.clear();
 
-	// read parameters
-    // SCIP_Real epsilon;
-    SCIP_Real epsilon;
+	SCIP_CLOCK* clock;
+	SCIP_CALL(SCIPcreateClock(scip, &clock));
+
+	// read parameters and matrix A
+	SCIP_Real epsilon;
 	int numvars, dim, card;
-	filedata >> numvars >> dim >> card >> epsilon;
+	vector<vector<SCIP_Real>> A;
+	SCIP_RETCODE retcode;
+	SCIP_CALL(SCIPstartClock(scip, clock));
+	{
+		DOPT_PROFILE(scip, "reader/parse");
+		retcode = readDesignData(filename, numvars, dim, card, epsilon, A);
+	}
+	SCIP_CALL(SCIPstopClock(scip, clock));
+	SCIP_Real parsetime = SCIPgetClockTime(scip, clock);
+	SCIP_CALL(SCIPfreeClock(scip, &clock));
 
+	// the clock is freed before an error of the parser is returned
+	SCIP_CALL(retcode);
 
-	vector<vector<SCIP_Real>> A(dim, vector<SCIP_Real>(numvars, 0));
+	SCIP_CALL(createProb(scip, filename, numvars, dim, card, epsilon, A, parsetime));
 
-	// open the file
+   	*result = SCIP_SUCCESS;
 
+	SCIPdebugMessage("--reader read completed!\n");
+	return SCIP_OKAY;
+}
 
-	// read matrix A
-	for(int i = 0; i < numvars; i++){
-		for(int j = 0; j < dim; j++){
-			filedata >> A[j][i];
-			//printf("%f ", A[i,j]);
-		}
-		//printf("\n");
+
+/** problem reading method of the reader of compressed files */
+SCIP_DECL_READERREAD(ReaderSubmodularCompressed::scip_read) {
+	*result = SCIP_DIDNOTRUN;
+
+	// only design files are ours: the extension in front of the compression extension must be "design"
+	const char* ext = strrchr(filename, '.');
+	if(ext == NULL || ext - filename < 7 || strncmp(ext - 7, ".design", 7) != 0){
+		return SCIP_OKAY;
+	}
+
+	ObjReader* designreader = SCIPfindObjReader(scip, "reader");
+	if(designreader == NULL){
+		SCIPerrorMessage("the reader of compressed design files needs the design reader\n");
+		return SCIP_PLUGINNOTFOUND;
 	}
+	SCIP_CALL(designreader->scip_read(scip, SCIPfindReader(scip, "reader"), filename, result));
+
+	return SCIP_OKAY;
+}
 
 
+/** creates the model of parsed design data as the reading method does, with the settings of the reader parameters */
+SCIP_RETCODE ReaderSubmodular::createProb(
+	SCIP*                 scip,               /**< SCIP data structure */
+	const char*           name,               /**< problem name */
+	int                   numvars,            /**< the number of items */
+	int                   dim,                /**< the problem dimension */
+	int                   card,               /**< the cardinality */
+	SCIP_Real             epsilon,            /**< epsilon as given in the file */
+	const vector<vector<SCIP_Real>>& A,       /**< data matrix: dim * numvars */
+	SCIP_Real             parsetime           /**< time spent on parsing, for the log */
+) {
+	// a card given by parameter overrides the card of the data
+	if(card_ >= 0){
+		card = card_;
+	}
 	epsilon = sqrt(epsilon);
 	SCIPdebugMessage("numvars:%d dim:%d card:%d\n", numvars, dim, card, epsilon);
-	// create the problem's data structure
-	
+
+	// comparison designs are detected by their points, which are all incidence vectors of edges
+	vector<pair<int, int>> edges;
+	if(laplacian_ && incidenceEdges(A, edges)){
+		SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "Laplacian mode: %d comparisons of %d treatments\n", numvars, dim + 1);
+	}
+
+	// in pricing mode, the model starts with the points of a greedy design
+	SCIP_PRICER* pricer = NULL;
+	if(pricing_){
+		pricer = SCIPfindPricer(scip, "design");
+		if(pricer == NULL){
+			SCIPerrorMessage("pricing mode needs the design pricer\n");
+			return SCIP_PLUGINNOTFOUND;
+		}
+		// the reduced costs of the pricer are derived for the exact cones
+		if(polydepth_ > 0){
+			SCIPerrorMessage("pricing mode needs the exact cones, but reading/design/polydepth = %d\n", polydepth_);
+			return SCIP_PARAMETERWRONGVAL;
+		}
+		if(card <= 0 || card > numvars){
+			SCIPerrorMessage("pricing mode needs a cardinality constraint, but card = %d\n", card);
+			return SCIP_READERROR;
+		}
+	}
+
+	// create the problem's data structure and the model
+	SCIP_CLOCK* clock;
+	SCIP_CALL(SCIPcreateClock(scip, &clock));
+	SCIP_CALL(SCIPstartClock(scip, clock));
+	vector<int> initpoints;
+	if(pricing_){
+		int ninitpoints = initpoints_ < 0 ? 2 * card : MAX(initpoints_, card);
+		// the greedy designs start at M = epsilon^2 I, so without regularization the model starts with the first points
+		if(epsilon <= 0.0){
+			for(int i = 0; i < MIN(ninitpoints, numvars); i++){
+				initpoints.push_back(i);
+			}
+		}
+		else if(!edges.empty()){
+			laplacianGreedyDesign(dim, edges, epsilon * epsilon, ninitpoints, initpoints);
+		}
+		else{
+			greedyDesign(A, epsilon * epsilon, ninitpoints, initpoints);
+		}
+	}
+	SCIP_CALL(createDesignProb(scip, name, numvars, dim, A, card, epsilon, logdetform_, polydepth_, initpoints, edges));
+	SCIP_CALL(SCIPstopClock(scip, clock));
+	SCIP_Real buildtime = SCIPgetClockTime(scip, clock);
+	SCIP_CALL(SCIPfreeClock(scip, &clock));
+
+	TableMemory* table = dynamic_cast<TableMemory*>(SCIPfindObjTable(scip, "designmemory"));
+	if(table != NULL){
+		table->record("read");
+	}
+
+	SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "design file parsed in %.2f s, model built in %.2f s (%d variables, %d constraints)\n",
+		parsetime, buildtime, SCIPgetNOrigVars(scip), SCIPgetNOrigConss(scip));
+
+	// root initialization: the first LP starts at the tangents in the optimal continuous design, which needs a positive
+	// regularization of the empty design
+	if(seed_ && polydepth_ == 0 && card > 0 && epsilon > 0.0){
+		DOPT_PROFILE(scip, "reader/seed");
+		SCIP_CALL(SCIPcreateClock(scip, &clock));
+		SCIP_CALL(SCIPstartClock(scip, clock));
+		vector<SCIP_Real> weights;
+		int niters;
+		SCIP_Real gap = continuousDesign(A, epsilon * epsilon, card, seediters_, 1e-6, weights, niters);
+		ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+		int ncuts;
+		SCIP_CALL(probdata->addSeedCuts(scip, weights, &ncuts));
+		SCIP_CALL(SCIPstopClock(scip, clock));
+
+		SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "root seeding: continuous design in %d iterations (gap %.1e), %d tangent cuts in %.2f s\n",
+			niters, gap, ncuts, SCIPgetClockTime(scip, clock));
+		SCIP_CALL(SCIPfreeClock(scip, &clock));
+	}
+
+	if(pricing_){
+		SCIP_CALL(SCIPactivatePricer(scip, pricer));
+
+		// the first card points of the greedy design are a feasible design, unless their information matrix is singular
+		ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+		vector<int> design(initpoints.begin(), initpoints.begin() + card);
+		if(probdata->designObjective(design) != SCIP_INVALID){
+			SCIP_SOL* sol;
+			SCIP_Bool stored;
+			SCIP_CALL(probdata->createDesignSol(scip, design, &sol));
+			SCIP_CALL(SCIPaddSolFree(scip, &sol, &stored));
+		}
+
+		SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "pricing mode: %d of %d points in the initial model\n",
+			(int) initpoints.size(), numvars);
+	}
+
+	// in Laplacian mode, the greedy design improved by exchanges is the starting solution; the greedy design starts at
+	// M = epsilon^2 I and needs a positive regularization
+	if(!edges.empty() && card > 0 && card <= numvars && epsilon > 0.0){
+		SCIP_CALL(SCIPcreateClock(scip, &clock));
+		SCIP_CALL(SCIPstartClock(scip, clock));
+		ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+		vector<int> design;
+		laplacianGreedyDesign(dim, edges, epsilon * epsilon, card, design);
+		int nexchanges = laplacianExchange(dim, edges, epsilon * epsilon, exchanges_, probdata->kernel, design);
+
+		for(int k = 0; k < design.size(); k++){
+			if(!probdata->hasPoint(design[k])){
+				SCIP_CALL(probdata->addPoint(scip, design[k], 0));
+			}
+		}
+		// a singular design is no starting solution
+		if(probdata->designObjective(design) != SCIP_INVALID){
+			SCIP_SOL* sol;
+			SCIP_Bool stored;
+			SCIP_CALL(probdata->createDesignSol(scip, design, &sol));
+			SCIP_CALL(SCIPaddSolFree(scip, &sol, &stored));
+		}
+		SCIP_CALL(SCIPstopClock(scip, clock));
+
+		SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "Laplacian mode: greedy design with %d exchanges, log-determinant %.6g in %.2f s\n",
+			nexchanges, laplacianLogdet(dim, edges, design, epsilon * epsilon), SCIPgetClockTime(scip, clock));
+		SCIP_CALL(SCIPfreeClock(scip, &clock));
+	}
+
+	// a cached root state of the instance is added to the initial LP and as starting solution
+	EventhdlrCache* cache = dynamic_cast<EventhdlrCache*>(SCIPfindObjEventhdlr(scip, "designcache"));
+	if(cache != NULL){
+		SCIP_CALL(cache->loadInstance(scip, dynamic_cast<ProbData*>(SCIPgetObjProbData(scip))));
+	}
+
+	return SCIP_OKAY;
+}
+
+
+/** reads the header "numvars dim card epsilon" and the numvars rows of the data matrix of a design file; files ending
+ *  with ".gz" or ".zst" are decompressed chunk by chunk while they are parsed
+ */
+SCIP_RETCODE readDesignData(
+	const char*           filename,           /**< name of the input file */
+	int&                  numvars,            /**< pointer to store the number of items */
+	int&                  dim,                /**< pointer to store the problem dimension */
+	int&                  card,               /**< pointer to store the cardinality */
+	SCIP_Real&            epsilon,            /**< pointer to store epsilon as given in the file */
+	vector<vector<SCIP_Real>>& A              /**< matrix to store the data, dim * numvars */
+) {
+	string error;
+	if (!parseDesignFile(filename, numvars, dim, card, epsilon, A, error)) {
+		SCIPerrorMessage("%s\n", error.c_str());
+		return SCIP_READERROR;
+	}
+
+	return SCIP_OKAY;
+}
+
+
+/** creates the problem data and the MISOCP model of a D-optimal design instance */
+SCIP_RETCODE createDesignProb(
+	SCIP*                 scip,               /**< SCIP data structure */
+	const char*           name,               /**< problem name */
+	int                   numvars,            /**< the number of items */
+	int                   dim,                /**< the problem dimension */
+	const vector<vector<SCIP_Real>>& A,       /**< data matrix: dim * numvars */
+	int                   card,               /**< the cardinality */
+	SCIP_Real             epsilon,            /**< square root of the regularization epsilon */
+	SCIP_Bool             logdetform,         /**< objective in log-determinant form instead of the geometric mean? */
+	int                   polydepth,          /**< depth of the polyhedral approximation of the cones, 0: exact cones */
+	const vector<int>&    initpoints,         /**< points of the initial model in pricing mode, empty: all */
+	const vector<pair<int, int>>& edges       /**< edges of the points in Laplacian mode, empty: no Laplacian mode */
+) {
 	ProbData * problemdata = NULL;
 	problemdata = new ProbData(numvars, dim, A, card, epsilon);
 	assert(problemdata != NULL);
+	problemdata->logdet_form = logdetform;
+	problemdata->poly_depth = polydepth;
+	problemdata->use_pricing = !initpoints.empty();
+	problemdata->init_points = initpoints;
+	problemdata->edges = edges;
 	SCIPdebugMessage("--problem data completed!\n");
-	SCIP_CALL(SCIPcreateObjProb(scip, filename, problemdata, FALSE));
-
+	SCIP_CALL(SCIPcreateObjProb(scip, name, problemdata, FALSE));
 
 	SCIP_CALL(problemdata->createInitial(scip));
-   
-   	*result = SCIP_SUCCESS;
 
-	SCIPdebugMessage("--reader read completed!\n");
 	return SCIP_OKAY;
 }
 
@@ -27,9 +27,12 @@
 
 #define SCIP_DEBUG
 
+#include <limits.h>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <utility>
 #include "objscip/objscip.h"
 
 
@@ -39,8 +42,37 @@ class ReaderSubmodular : public scip::ObjReader
 public:
 	/** default constructor */
 	ReaderSubmodular(SCIP* scip)
-		: scip::ObjReader(scip, "reader", "file reader for D-optimal design files", "design")
-	{}
+		: scip::ObjReader(scip, "reader", "file reader for D-optimal design files", "design"),
+		  pricing_(FALSE), initpoints_(-1), logdetform_(FALSE), polydepth_(0), card_(-1), seed_(TRUE), seediters_(1000), laplacian_(TRUE), exchanges_(1000)
+	{
+		SCIP_CALL_ABORT(SCIPaddBoolParam(scip, "reading/design/pricing",
+			"should the model start with a working set of points and the design pricer add the others on demand?",
+			&pricing_, FALSE, FALSE, NULL, NULL));
+		SCIP_CALL_ABORT(SCIPaddIntParam(scip, "reading/design/initpoints",
+			"number of points of the greedy design in the initial model of the pricing mode (-1: 2 * card)",
+			&initpoints_, FALSE, -1, -1, INT_MAX, NULL, NULL));
+		SCIP_CALL_ABORT(SCIPaddBoolParam(scip, "reading/design/logdetform",
+			"should the objective be the sum of logarithms of the diagonal of J instead of its geometric mean?",
+			&logdetform_, FALSE, FALSE, NULL, NULL));
+		SCIP_CALL_ABORT(SCIPaddIntParam(scip, "reading/design/polydepth",
+			"depth of the lifted polyhedral approximation of the cones (0: exact second-order cones)",
+			&polydepth_, FALSE, 0, 0, 30, NULL, NULL));
+		SCIP_CALL_ABORT(SCIPaddIntParam(scip, "reading/design/card",
+			"cardinality of the design, overriding the cardinality of the file (-1: as in the file)",
+			&card_, FALSE, -1, -1, INT_MAX, NULL, NULL));
+		SCIP_CALL_ABORT(SCIPaddBoolParam(scip, "reading/design/seed",
+			"should the initial LP contain the tangent cuts of the cones and the objective at the optimal continuous design?",
+			&seed_, FALSE, TRUE, NULL, NULL));
+		SCIP_CALL_ABORT(SCIPaddIntParam(scip, "reading/design/seediters",
+			"maximal number of iterations of the continuous design solver of the seeding",
+			&seediters_, FALSE, 1000, 0, INT_MAX, NULL, NULL));
+		SCIP_CALL_ABORT(SCIPaddBoolParam(scip, "reading/design/laplacian",
+			"should instances whose points are incidence vectors of edges be solved with the graph Laplacian machinery?",
+			&laplacian_, FALSE, TRUE, NULL, NULL));
+		SCIP_CALL_ABORT(SCIPaddIntParam(scip, "reading/design/exchanges",
+			"maximal number of exchanges of the starting design of the Laplacian mode",
+			&exchanges_, FALSE, 1000, 0, INT_MAX, NULL, NULL));
+	}
 
 	/** destructor of file reader to free user data (called when SCIP is exiting) */
 	virtual SCIP_DECL_READERFREE(scip_free);
@@ -68,8 +100,76 @@ public:
 	 */
 	virtual SCIP_DECL_READERWRITE(scip_write);
 
+	/** creates the model of parsed design data as the reading method does, with the settings of the reader parameters */
+	SCIP_RETCODE createProb(
+		SCIP*                 scip,               /**< SCIP data structure */
+		const char*           name,               /**< problem name */
+		int                   numvars,            /**< the number of items */
+		int                   dim,                /**< the problem dimension */
+		int                   card,               /**< the cardinality */
+		SCIP_Real             epsilon,            /**< epsilon as given in the file */
+		const std::vector<std::vector<SCIP_Real>>& A, /**< data matrix: dim * numvars */
+		SCIP_Real             parsetime           /**< time spent on parsing, for the log */
+	);
+
+private:
+	SCIP_Bool pricing_; /**< build the model with a working set of points and price in the others? */
+	int initpoints_; /**< number of points in the initial model of the pricing mode, -1: 2 * card */
+	SCIP_Bool logdetform_; /**< objective in log-determinant form? */
+	int polydepth_; /**< depth of the polyhedral approximation of the cones, 0: exact cones */
+	int card_; /**< cardinality overriding the file, -1: as in the file */
+	SCIP_Bool seed_; /**< add the tangent cuts at the optimal continuous design to the initial LP? */
+	int seediters_; /**< maximal number of iterations of the continuous design solver */
+	SCIP_Bool laplacian_; /**< detect comparison designs and use the Laplacian machinery for them? */
+	int exchanges_; /**< maximal number of exchanges of the starting design of the Laplacian mode */
+
 };/*lint !e1712*/
 
 
+/** SCIP file reader for compressed DOpt data files, which passes them to the DOpt reader
+ *
+ *  SCIP strips the extension ".gz" itself and dispatches the file to the reader of the inner extension if it is built
+ *  with zlib; otherwise, and for ".zst", which SCIP does not know, the file arrives at this reader.
+ */
+class ReaderSubmodularCompressed : public scip::ObjReader
+{
+public:
+	/** default constructor */
+	ReaderSubmodularCompressed(SCIP* scip, const char* name, const char* extension)
+		: scip::ObjReader(scip, name, "file reader for compressed D-optimal design files", extension)
+	{
+	}
+
+	/** problem reading method of reader */
+	virtual SCIP_DECL_READERREAD(scip_read);
+
+};/*lint !e1712*/
+
+
+/** reads the header "numvars dim card epsilon" and the numvars rows of the data matrix of a design file */
+SCIP_RETCODE readDesignData(
+	const char*           filename,           /**< name of the input file */
+	int&                  numvars,            /**< pointer to store the number of items */
+	int&                  dim,                /**< pointer to store the problem dimension */
+	int&                  card,               /**< pointer to store the cardinality */
+	SCIP_Real&            epsilon,            /**< pointer to store epsilon as given in the file */
+	std::vector<std::vector<SCIP_Real>>& A    /**< matrix to store the data, dim * numvars */
+);
+
+/** creates the problem data and the MISOCP model of a D-optimal design instance */
+SCIP_RETCODE createDesignProb(
+	SCIP*                 scip,               /**< SCIP data structure */
+	const char*           name,               /**< problem name */
+	int                   numvars,            /**< the number of items */
+	int                   dim,                /**< the problem dimension */
+	const std::vector<std::vector<SCIP_Real>>& A, /**< data matrix: dim * numvars */
+	int                   card,               /**< the cardinality */
+	SCIP_Real             epsilon,            /**< square root of the regularization epsilon */
+	SCIP_Bool             logdetform = FALSE, /**< objective in log-determinant form instead of the geometric mean? */
+	int                   polydepth = 0,      /**< depth of the polyhedral approximation of the cones, 0: exact cones */
+	const std::vector<int>& initpoints = std::vector<int>(), /**< points of the initial model in pricing mode, empty: all */
+	const std::vector<std::pair<int, int>>& edges = std::vector<std::pair<int, int>>() /**< edges of the points in Laplacian mode, empty: no Laplacian mode */
+);
+
 
 #endif
@@ -0,0 +1,263 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   sepa_cone.cpp
+ * @brief  parallel separator for the cones of the design points
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+#include "sepa_cone.h"
+#include "probdata.h"
+#include "table_profile.h"
+
+using namespace scip;
+using namespace std;
+
+#define SEPA_NAME              "conegrid"
+#define SEPA_DESC              "parallel separator for the cones of the design points"
+#define SEPA_PRIORITY          1000
+#define SEPA_FREQ              1
+#define SEPA_MAXBOUNDDIST      1.0
+#define SEPA_USESSUBSCIP       FALSE         /**< does the separator use a secondary SCIP instance? */
+#define SEPA_DELAY             FALSE         /**< should separation method be delayed, if other separators found cuts? */
+
+#define DEFAULT_NTHREADS       1             /**< number of threads of the scan */
+#define DEFAULT_MAXCUTS        1000          /**< maximal number of cuts added in a round */
+#define DEFAULT_MINEFFICACY    1e-4          /**< minimal efficacy of a cut */
+#define DEFAULT_SIMD           TRUE          /**< use the vector instructions of the processor? */
+
+#define BLOCKSIZE              256           /**< number of points scanned by a task */
+
+
+/** default constructor */
+SepaCone::SepaCone(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjSepa(scip, SEPA_NAME, SEPA_DESC, SEPA_PRIORITY, SEPA_FREQ, SEPA_MAXBOUNDDIST, SEPA_USESSUBSCIP, SEPA_DELAY),
+     nthreads_(DEFAULT_NTHREADS),
+     maxcuts_(DEFAULT_MAXCUTS),
+     minefficacy_(DEFAULT_MINEFFICACY),
+     simd_(DEFAULT_SIMD),
+     isa_(CONEKERNEL_SCALAR),
+     pool_(NULL),
+     dim_(0),
+     clock_(NULL),
+     nrounds_(0),
+     ncuts_(0)
+{
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "separating/" SEPA_NAME "/nthreads",
+         "number of threads that scan the cones",
+         &nthreads_, FALSE, DEFAULT_NTHREADS, 1, 64, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddIntParam(scip, "separating/" SEPA_NAME "/maxcuts",
+         "maximal number of cone cuts added in a separation round",
+         &maxcuts_, FALSE, DEFAULT_MAXCUTS, 1, INT_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddRealParam(scip, "separating/" SEPA_NAME "/minefficacy",
+         "minimal efficacy of a cone cut",
+         &minefficacy_, FALSE, DEFAULT_MINEFFICACY, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL_ABORT( SCIPaddBoolParam(scip, "separating/" SEPA_NAME "/simd",
+         "should the cones be checked with AVX2 or AVX-512 if the processor supports them?",
+         &simd_, FALSE, DEFAULT_SIMD, NULL, NULL) );
+}
+
+
+/** solving process initialization method of separator (called when branch and bound process is about to begin) */
+SCIP_DECL_SEPAINITSOL(SepaCone::scip_initsol)
+{
+   /* the pool is kept between solves unless the number of threads changed */
+   if( pool_ != NULL && pool_->getNThreads() != nthreads_ )
+   {
+      delete pool_;
+      pool_ = NULL;
+   }
+   if( pool_ == NULL )
+      pool_ = new ThreadPool(nthreads_);
+   buffers_.resize(nthreads_);
+   isa_ = simd_ ? coneKernelBestIsa() : CONEKERNEL_SCALAR;
+
+   SCIP_CALL( SCIPcreateClock(scip, &clock_) );
+   nrounds_ = 0;
+   ncuts_ = 0;
+   rootcuts_.clear();
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of separator (called before branch and bound process data is freed) */
+SCIP_DECL_SEPAEXITSOL(SepaCone::scip_exitsol)
+{
+   SCIP_Real time = SCIPgetClockTime(scip, clock_);
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+      "conegrid separator: %d cuts in %d rounds, %.3f s, %.3f ms per round with %d threads (%s kernel)\n",
+      ncuts_, nrounds_, time, nrounds_ > 0 ? 1000.0 * time / nrounds_ : 0.0, nthreads_, coneKernelIsaName(isa_));
+
+   SCIP_CALL( SCIPfreeClock(scip, &clock_) );
+   zvals_.clear();
+   tvals_.clear();
+   wvals_.clear();
+   blockcands_.clear();
+   buffers_.clear();
+
+   return SCIP_OKAY;
+}
+
+
+/** checks the cones of the points first, ..., last - 1 in the snapshot and appends the violated ones */
+void SepaCone::scanBlock(
+   int                   first,              /**< first point of the block */
+   int                   last,               /**< end of the block */
+   vector<SCIP_Real>&    efficacy,           /**< buffer for the efficacies of the block */
+   vector<Candidate>&    candidates          /**< vector to append the candidates to */
+   ) const
+{
+   size_t begin = (size_t) first * dim_;
+   size_t n = (size_t) (last - first) * dim_;
+   efficacy.resize(n);
+   coneEfficacies(isa_, n, &zvals_[begin], &tvals_[begin], &wvals_[begin], efficacy.data());
+
+   for( size_t k = 0; k < n; k++ )
+   {
+      if( efficacy[k] <= 0.0 || efficacy[k] < minefficacy_ )
+         continue;
+
+      Candidate cand;
+      cand.i = (int) ((begin + k) / dim_);
+      cand.j = (int) ((begin + k) % dim_);
+      cand.efficacy = efficacy[k];
+      coneCutCoefs(zvals_[begin + k], tvals_[begin + k], wvals_[begin + k], cand.coefs);
+      candidates.push_back(cand);
+   }
+}
+
+
+/** LP solution separation method of separator */
+SCIP_DECL_SEPAEXECLP(SepaCone::scip_execlp)
+{
+   DOPT_PROFILE(scip, "conegrid/execlp");
+   *result = SCIP_DIDNOTRUN;
+
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( probdata == NULL || probdata->poly_depth > 0 )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPstartClock(scip, clock_) );
+
+   /* snapshot of the LP values; the cones of points that are not in the model are 0 <= 0 * 0 */
+   int numvars = probdata->numvars;
+   dim_ = probdata->dim;
+   zvals_.assign((size_t) numvars * dim_, 0.0);
+   tvals_.assign((size_t) numvars * dim_, 0.0);
+   wvals_.assign((size_t) numvars * dim_, 0.0);
+   for( int i = 0; i < numvars; i++ )
+   {
+      if( !probdata->hasPoint(i) )
+         continue;
+      SCIP_Real w = MAX(SCIPgetSolVal(scip, NULL, probdata->bin_vars[i]), 0.0);
+      for( int j = 0; j < dim_; j++ )
+      {
+         zvals_[(size_t) i * dim_ + j] = SCIPgetSolVal(scip, NULL, probdata->Z[i][j]);
+         tvals_[(size_t) i * dim_ + j] = SCIPgetSolVal(scip, NULL, probdata->t[i][j]);
+         wvals_[(size_t) i * dim_ + j] = w;
+      }
+   }
+
+   /* parallel scan; each block writes its own candidate list */
+   int nblocks = (numvars + BLOCKSIZE - 1) / BLOCKSIZE;
+   blockcands_.resize(nblocks);
+   pool_->parallelFor(nblocks, [this, numvars](int block, int thread)
+      {
+         blockcands_[block].clear();
+         scanBlock(block * BLOCKSIZE, MIN((block + 1) * BLOCKSIZE, numvars), buffers_[thread], blockcands_[block]);
+      });
+
+   /* merge in block order and keep the most efficacious cuts; ties are broken by the position in the grid */
+   vector<Candidate> candidates;
+   for( int block = 0; block < nblocks; block++ )
+      candidates.insert(candidates.end(), blockcands_[block].begin(), blockcands_[block].end());
+   if( (int) candidates.size() > maxcuts_ )
+   {
+      nth_element(candidates.begin(), candidates.begin() + maxcuts_, candidates.end(),
+         [](const Candidate& a, const Candidate& b)
+         {
+            return a.efficacy > b.efficacy || (a.efficacy == b.efficacy && (a.i < b.i || (a.i == b.i && a.j < b.j)));
+         });
+      candidates.resize(maxcuts_);
+      sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b)
+         {
+            return a.i < b.i || (a.i == b.i && a.j < b.j);
+         });
+   }
+
+   /* the clock is stopped before an error of the LP interface is returned */
+   SCIP_RETCODE retcode = addCuts(scip, sepa, probdata, candidates, result);
+   nrounds_++;
+
+   SCIP_CALL( SCIPstopClock(scip, clock_) );
+
+   return retcode;
+}
+
+
+/** adds the cuts of the candidates to the LP and stores the cuts of the root */
+SCIP_RETCODE SepaCone::addCuts(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_SEPA*            sepa,               /**< the separator */
+   ProbData*             probdata,           /**< the problem data */
+   const vector<Candidate>& candidates,      /**< the candidates of the round */
+   SCIP_RESULT*          result              /**< pointer to store the result of the separation */
+   )
+{
+   *result = SCIP_DIDNOTFIND;
+   for( size_t k = 0; k < candidates.size(); k++ )
+   {
+      const Candidate& cand = candidates[k];
+      SCIP_VAR* vars[3] = {probdata->Z[cand.i][cand.j], probdata->t[cand.i][cand.j], probdata->bin_vars[cand.i]};
+      string name = "conecut" + std::to_string(cand.i) + "_" + std::to_string(cand.j);
+
+      SCIP_ROW* row;
+      SCIP_Bool infeasible;
+      SCIP_CALL( SCIPcreateEmptyRowSepa(scip, &row, sepa, name.c_str(), -SCIPinfinity(scip), 0.0, FALSE, FALSE, TRUE) );
+      SCIP_CALL( SCIPaddVarsToRow(scip, row, 3, vars, const_cast<SCIP_Real*>(cand.coefs)) );
+      SCIP_CALL( SCIPaddRow(scip, row, FALSE, &infeasible) );
+      SCIP_CALL( SCIPreleaseRow(scip, &row) );
+      ncuts_++;
+
+      if( SCIPgetDepth(scip) == 0 )
+      {
+         ConeCut cut;
+         cut.i = cand.i;
+         cut.j = cand.j;
+         copy(cand.coefs, cand.coefs + 3, cut.coefs);
+         rootcuts_.push_back(cut);
+      }
+
+      if( infeasible )
+      {
+         *result = SCIP_CUTOFF;
+         break;
+      }
+      *result = SCIP_SEPARATED;
+   }
+
+   return SCIP_OKAY;
+}
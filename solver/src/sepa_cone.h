@@ -0,0 +1,143 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   sepa_cone.h
+ * @brief  parallel separator for the cones of the design points
+ * @author Liding Xu
+ *
+ * The cone Z_ij^2 <= t_ij w_i is the second-order cone |(2 Z_ij, t_ij - w_i)| <= t_ij + w_i. At an LP point (z, t, w)
+ * with n = |(2 z, t - w)| > t + w, the gradient cut
+ *
+ *    (4 z / n) Z_ij + ((t - w) / n - 1) t_ij - ((t - w) / n + 1) w_i <= 0
+ *
+ * is violated by n - (t + w) and valid for the cone by the Cauchy-Schwarz inequality.
+ *
+ * The separator copies the LP values of Z, t and bin_vars into flat arrays on the main thread, scans the numvars x dim
+ * cones in blocks of points on a thread pool with the vectorized kernel of conekernel.h, and adds the most efficacious
+ * cuts on the main thread. The candidates of a block are kept in the order of the block, so the cuts do not depend on
+ * the number of threads.
+ *
+ * The cuts of the root node are recorded, so that they can be added to the model again after the problem was changed,
+ * e.g., when points are appended in online mode: a cut only involves the cone of its point and stays valid.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_SEPA_CONE_H__
+#define __SCIP_SEPA_CONE_H__
+
+#include <vector>
+#include "objscip/objscip.h"
+#include "conekernel.h"
+#include "threadpool.h"
+
+class ProbData;
+
+
+/** separator for the cones Z_ij^2 <= t_ij w_i */
+class SepaCone : public scip::ObjSepa
+{
+public:
+   /** default constructor */
+   SepaCone(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~SepaCone()
+   {
+      delete pool_;
+   }
+
+   /** solving process initialization method of separator (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_SEPAINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of separator (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_SEPAEXITSOL(scip_exitsol);
+
+   /** LP solution separation method of separator */
+   virtual SCIP_DECL_SEPAEXECLP(scip_execlp);
+
+   /** gradient cut of the cone of a point */
+   struct ConeCut
+   {
+      int                i;                  /**< index of the point */
+      int                j;                  /**< index of the coordinate */
+      SCIP_Real          coefs[3];           /**< coefficients of Z_ij, t_ij and w_i in the cut with right hand side 0 */
+   };
+
+   /** returns the cuts found at the root node of the current or last solve */
+   const std::vector<ConeCut>& rootCuts() const
+   {
+      return rootcuts_;
+   }
+
+   /** moves the cuts found at the root node of the last solve to the given vector */
+   void takeRootCuts(
+      std::vector<ConeCut>& cuts             /**< vector to store the cuts */
+      )
+   {
+      cuts.clear();
+      cuts.swap(rootcuts_);
+   }
+
+private:
+   /** violated cone found by a task */
+   struct Candidate
+   {
+      int                i;                  /**< index of the point */
+      int                j;                  /**< index of the coordinate */
+      SCIP_Real          coefs[3];           /**< coefficients of Z_ij, t_ij and w_i in the cut with right hand side 0 */
+      SCIP_Real          efficacy;           /**< violation divided by the norm of the coefficients */
+   };
+
+   /** checks the cones of the points first, ..., last - 1 in the snapshot and appends the violated ones */
+   void scanBlock(
+      int                first,              /**< first point of the block */
+      int                last,               /**< end of the block */
+      std::vector<SCIP_Real>& efficacy,      /**< buffer for the efficacies of the block */
+      std::vector<Candidate>& candidates     /**< vector to append the candidates to */
+      ) const;
+
+   /** adds the cuts of the candidates to the LP and stores the cuts of the root */
+   SCIP_RETCODE addCuts(
+      SCIP*              scip,               /**< SCIP data structure */
+      SCIP_SEPA*         sepa,               /**< the separator */
+      ProbData*          probdata,           /**< the problem data */
+      const std::vector<Candidate>& candidates, /**< the candidates of the round */
+      SCIP_RESULT*       result              /**< pointer to store the result of the separation */
+      );
+
+   int                   nthreads_;          /**< number of threads of the scan */
+   int                   maxcuts_;           /**< maximal number of cuts added in a round */
+   SCIP_Real             minefficacy_;       /**< minimal efficacy of a cut */
+   SCIP_Bool             simd_;              /**< use the vector instructions of the processor? */
+   ConeKernelIsa         isa_;               /**< instruction set of the kernel in the current solve */
+   ThreadPool*           pool_;              /**< thread pool, or NULL before the first solve */
+   int                   dim_;               /**< dimension of the snapshot */
+   std::vector<SCIP_Real> zvals_;            /**< snapshot of Z, numvars * dim */
+   std::vector<SCIP_Real> tvals_;            /**< snapshot of t, numvars * dim */
+   std::vector<SCIP_Real> wvals_;            /**< snapshot of bin_vars for each cone, numvars * dim, 0 for points that
+                                              *   are not in the model */
+   std::vector<std::vector<Candidate> > blockcands_; /**< candidates of each block */
+   std::vector<std::vector<SCIP_Real> > buffers_; /**< efficacy buffer of each thread */
+   SCIP_CLOCK*           clock_;             /**< time spent in the separator */
+   int                   nrounds_;           /**< number of separation rounds in the current solve */
+   int                   ncuts_;             /**< number of cuts added in the current solve */
+   std::vector<ConeCut>  rootcuts_;          /**< cuts added at the root node of the current or last solve */
+};/*lint !e1712*/
+
+
+#endif
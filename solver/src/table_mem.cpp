@@ -0,0 +1,246 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   table_mem.cpp
+ * @brief  statistics table with the memory used by the problem data and the lifted model
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "table_mem.h"
+#include "probdata.h"
+
+using namespace scip;
+using namespace std;
+
+#define TABLE_NAME             "designmemory"
+#define TABLE_DESC             "memory of the problem data and the lifted model"
+#define TABLE_POSITION         25000         /**< the position of the statistics table */
+#define TABLE_EARLIEST_STAGE   SCIP_STAGE_TRANSFORMED /**< output of the statistics table is only printed from this stage onwards */
+
+#define EVENTHDLR_NAME         "designmemory"
+#define EVENTHDLR_DESC         "event handler that records the memory peaks of presolving and the root node"
+
+/** families of the variables and constraints of the lifted model */
+enum Family
+{
+   FAMILY_SOC = 0,                           /**< cones Z^2 <= t w and epsZ^2 <= epsZ2 */
+   FAMILY_LINEARIZE = 1,                     /**< initial linearizations of the cones */
+   FAMILY_AZJ = 2,                           /**< rows A Z = J */
+   FAMILY_SUMT = 3,                          /**< rows sum_i t_ij <= J_jj */
+   FAMILY_POLY = 4,                          /**< rows of the polyhedral approximation of the cones */
+   FAMILY_OTHER = 5                          /**< objective, cardinality and epsilon rows */
+};
+#define NFAMILIES              6
+
+static const char* familynames[NFAMILIES] = {"soc", "linearize", "A*Z=J", "sumt", "polyhedral", "other"};
+
+
+/** returns the family of a constraint of the lifted model from its name and handler */
+static
+Family consFamily(
+   SCIP_CONS*            cons                /**< constraint */
+   )
+{
+   const char* name = SCIPconsGetName(cons);
+   size_t len = strlen(name);
+
+   if( strstr(name, "linearize") != NULL || strcmp(name, "linear1") == 0 )
+      return FAMILY_LINEARIZE;
+   if( name[0] == 'A' && len >= 2 && strcmp(name + len - 2, "=J") == 0 )
+      return FAMILY_AZJ;
+   if( strncmp(name, "sumt", 4) == 0 )
+      return FAMILY_SUMT;
+   if( strstr(name, "_xi0") != NULL || strstr(name, "_eta0") != NULL || strstr(name, "_rot") != NULL
+      || strstr(name, "_radius") != NULL || strstr(name, "_angle") != NULL )
+      return FAMILY_POLY;
+   if( strcmp(SCIPconshdlrGetName(SCIPconsGetHdlr(cons)), "nonlinear") == 0
+      && (strncmp(name, "soc", 3) == 0 || strncmp(name, "epsZ^2", 6) == 0) )
+      return FAMILY_SOC;
+   return FAMILY_OTHER;
+}
+
+
+/** default constructor */
+TableMemory::TableMemory(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjTable(scip, TABLE_NAME, TABLE_DESC, TABLE_POSITION, TABLE_EARLIEST_STAGE)
+{
+}
+
+
+/** returns the peak resident set size of the process in KB */
+long TableMemory::peakRss()
+{
+   struct rusage usage;
+   if( getrusage(RUSAGE_SELF, &usage) != 0 )
+      return -1;
+   return usage.ru_maxrss;
+}
+
+
+/** records the peak resident set size at the end of a stage; a later record of the same stage replaces it */
+void TableMemory::record(
+   const char*           stage               /**< name of the stage */
+   )
+{
+   long rss = peakRss();
+   for( size_t k = 0; k < samples_.size(); k++ )
+   {
+      if( samples_[k].first == stage )
+      {
+         samples_[k].second = rss;
+         return;
+      }
+   }
+   samples_.push_back(make_pair(string(stage), rss));
+}
+
+
+/** output method of statistics table to output file stream 'file' */
+SCIP_DECL_TABLEOUTPUT(TableMemory::scip_output)
+{
+   ProbData* probdata = dynamic_cast<ProbData*>(SCIPgetObjProbData(scip));
+   if( probdata == NULL )
+      return SCIP_OKAY;
+
+   /* bytes of the problem data, original and transformed */
+   vector<pair<string, size_t> > trans;
+   vector<pair<string, size_t> > orig;
+   probdata->memoryUsage(trans);
+   if( probdata->orig_data != NULL )
+      probdata->orig_data->memoryUsage(orig);
+
+   size_t origtotal = 0;
+   size_t transtotal = 0;
+   SCIPinfoMessage(scip, file, "Design Memory      :     orig [KB]    trans [KB]\n");
+   for( size_t k = 0; k < trans.size(); k++ )
+   {
+      size_t origbytes = k < orig.size() ? orig[k].second : 0;
+      SCIPinfoMessage(scip, file, "  %-17s: %13.1f %13.1f\n", trans[k].first.c_str(), origbytes / 1024.0,
+         trans[k].second / 1024.0);
+      origtotal += origbytes;
+      transtotal += trans[k].second;
+   }
+   SCIPinfoMessage(scip, file, "  %-17s: %13.1f %13.1f\n", "total", origtotal / 1024.0, transtotal / 1024.0);
+
+   /* variables and constraints by family */
+   int nconss[NFAMILIES] = {0};
+   for( size_t c = 0; c < probdata->conss.size(); c++ )
+      nconss[consFamily(probdata->conss[c])]++;
+
+   int nbin = 0;
+   int nz = 0;
+   int nt = 0;
+   int npoly = 0;
+   for( size_t i = 0; i < probdata->bin_vars.size(); i++ )
+      nbin += probdata->bin_vars[i] != NULL ? 1 : 0;
+   for( size_t i = 0; i < probdata->Z.size(); i++ )
+      nz += (int) probdata->Z[i].size();
+   for( size_t i = 0; i < probdata->t.size(); i++ )
+      nt += (int) probdata->t[i].size();
+   for( size_t c = 0; c < probdata->poly_cones.size(); c++ )
+      npoly += (int) (probdata->poly_cones[c].xi.size() + probdata->poly_cones[c].eta.size());
+   int dim = probdata->dim;
+
+   SCIPinfoMessage(scip, file, "Design Variables   :      binaries             Z             t  J/epsZ/epsZ2    polyhedral\n");
+   SCIPinfoMessage(scip, file, "  %-17s: %13d %13d %13d %13d %13d\n", "count", nbin, nz, nt, 3 * dim * dim, npoly);
+   SCIPinfoMessage(scip, file, "Design Constraints :");
+   for( int f = 0; f < NFAMILIES; f++ )
+      SCIPinfoMessage(scip, file, " %13s", familynames[f]);
+   SCIPinfoMessage(scip, file, "\n  %-17s:", "count");
+   for( int f = 0; f < NFAMILIES; f++ )
+      SCIPinfoMessage(scip, file, " %13d", nconss[f]);
+   SCIPinfoMessage(scip, file, "\n");
+
+   /* SCIP's own memory and the size of the problem and the LP */
+   SCIP_Bool haslp = SCIPgetStage(scip) == SCIP_STAGE_SOLVING || SCIPgetStage(scip) == SCIP_STAGE_SOLVED;
+   SCIPinfoMessage(scip, file, "SCIP Memory        :     used [MB]    total [MB]   extern [MB]          vars         conss        LP rows        LP cols\n");
+   SCIPinfoMessage(scip, file, "  %-17s: %13.1f %13.1f %13.1f %13d %13d %14d %14d\n", "transformed",
+      SCIPgetMemUsed(scip) / 1048576.0, SCIPgetMemTotal(scip) / 1048576.0, SCIPgetMemExternEstim(scip) / 1048576.0,
+      SCIPgetNVars(scip), SCIPgetNConss(scip), haslp ? SCIPgetNLPRows(scip) : 0, haslp ? SCIPgetNLPCols(scip) : 0);
+
+   /* peaks of the resident set size; the table is printed at the end of the solve */
+   record("finish");
+   SCIPinfoMessage(scip, file, "Peak RSS [MB]      :");
+   for( size_t k = 0; k < samples_.size(); k++ )
+      SCIPinfoMessage(scip, file, " %13s", samples_[k].first.c_str());
+   SCIPinfoMessage(scip, file, "\n  %-17s:", "process");
+   for( size_t k = 0; k < samples_.size(); k++ )
+      SCIPinfoMessage(scip, file, " %13.1f", samples_[k].second / 1024.0);
+   SCIPinfoMessage(scip, file, "\n");
+
+   return SCIP_OKAY;
+}
+
+
+/** default constructor */
+EventhdlrMemory::EventhdlrMemory(
+   SCIP*                 scip,               /**< SCIP data structure */
+   TableMemory*          table               /**< memory table, owned by SCIP */
+   )
+   : ObjEventhdlr(scip, EVENTHDLR_NAME, EVENTHDLR_DESC),
+     table_(table),
+     caught_(FALSE)
+{
+}
+
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+SCIP_DECL_EVENTINITSOL(EventhdlrMemory::scip_initsol)
+{
+   /* presolving is done when the branch and bound process begins */
+   table_->record("presolve");
+
+   SCIP_CALL( SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, NULL) );
+   caught_ = TRUE;
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+SCIP_DECL_EVENTEXITSOL(EventhdlrMemory::scip_exitsol)
+{
+   if( caught_ )
+   {
+      SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, -1) );
+      caught_ = FALSE;
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** execution method of event handler */
+SCIP_DECL_EVENTEXEC(EventhdlrMemory::scip_exec)
+{
+   SCIP_NODE* node = SCIPeventGetNode(event);
+   if( node == NULL || SCIPnodeGetDepth(node) > 0 )
+      return SCIP_OKAY;
+
+   table_->record("root");
+
+   SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, -1) );
+   caught_ = FALSE;
+
+   return SCIP_OKAY;
+}
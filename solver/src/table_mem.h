@@ -0,0 +1,97 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   table_mem.h
+ * @brief  statistics table with the memory used by the problem data and the lifted model
+ * @author Liding Xu
+ *
+ * The table reports the bytes of each structure of the original and the transformed problem data, the number of
+ * variables and constraints of each family of the lifted model, the memory of SCIP and the size of the LP, and the
+ * peak resident set size of the process at the end of reading, presolving, the root node and the solve. The peaks of
+ * presolving and the root node are recorded by the event handler EventhdlrMemory, the peak of reading by the reader.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_TABLE_MEM_H__
+#define __SCIP_TABLE_MEM_H__
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "objscip/objscip.h"
+
+
+/** statistics table for the memory of a D-optimal design problem */
+class TableMemory : public scip::ObjTable
+{
+public:
+   /** default constructor */
+   TableMemory(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~TableMemory()
+   {
+   }
+
+   /** output method of statistics table to output file stream 'file' */
+   virtual SCIP_DECL_TABLEOUTPUT(scip_output);
+
+   /** records the peak resident set size at the end of a stage; a later record of the same stage replaces it */
+   void record(
+      const char*        stage               /**< name of the stage */
+      );
+
+   /** returns the peak resident set size of the process in KB */
+   static long peakRss();
+
+private:
+   std::vector<std::pair<std::string, long> > samples_; /**< stages and their peak resident set sizes in KB */
+};/*lint !e1712*/
+
+
+/** event handler that records the memory peaks of presolving and the root node in the memory table */
+class EventhdlrMemory : public scip::ObjEventhdlr
+{
+public:
+   /** default constructor */
+   EventhdlrMemory(
+      SCIP*              scip,               /**< SCIP data structure */
+      TableMemory*       table               /**< memory table, owned by SCIP */
+      );
+
+   /** destructor */
+   virtual ~EventhdlrMemory()
+   {
+   }
+
+   /** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+   virtual SCIP_DECL_EVENTINITSOL(scip_initsol);
+
+   /** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_EVENTEXITSOL(scip_exitsol);
+
+   /** execution method of event handler */
+   virtual SCIP_DECL_EVENTEXEC(scip_exec);
+
+private:
+   TableMemory*          table_;             /**< memory table */
+   SCIP_Bool             caught_;            /**< is the root node event caught? */
+};/*lint !e1712*/
+
+
+#endif
@@ -0,0 +1,120 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   table_profile.cpp
+ * @brief  statistics table with the profile of the callbacks of the design plugins
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <map>
+#include <string>
+
+#include "table_profile.h"
+
+using namespace scip;
+using namespace std;
+
+#define TABLE_NAME             "designprofile"
+#define TABLE_DESC             "profile of the callbacks of the design plugins"
+#define TABLE_POSITION         25100         /**< the position of the statistics table */
+#define TABLE_EARLIEST_STAGE   SCIP_STAGE_PROBLEM /**< output of the statistics table is only printed from this stage onwards */
+
+
+/** enables or disables the profiler of the table when "table/designprofile/enabled" changes */
+static
+SCIP_DECL_PARAMCHGD(paramChgdProfile)
+{
+   TableProfile* table = (TableProfile*) SCIPparamGetData(param);
+   assert(table != NULL);
+   table->profiler().setEnabled(SCIPparamGetBool(param));
+   return SCIP_OKAY;
+}
+
+
+/** default constructor */
+TableProfile::TableProfile(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+   : ObjTable(scip, TABLE_NAME, TABLE_DESC, TABLE_POSITION, TABLE_EARLIEST_STAGE), enabled_(FALSE), filename_(NULL)
+{
+   SCIP_CALL_ABORT( SCIPaddBoolParam(scip, "table/" TABLE_NAME "/enabled",
+         "should the callbacks of the design plugins record calls, time and hardware counters?",
+         &enabled_, FALSE, FALSE, paramChgdProfile, (SCIP_PARAMDATA*) this) );
+   SCIP_CALL_ABORT( SCIPaddStringParam(scip, "table/" TABLE_NAME "/filename",
+         "name of the JSON file the profile is written to at the end of every solve (empty: none)",
+         &filename_, FALSE, "", NULL, NULL) );
+}
+
+
+/** solving process deinitialization method of statistics table (called before branch and bound process data is freed) */
+SCIP_DECL_TABLEEXITSOL(TableProfile::scip_exitsol)
+{
+   if( !enabled_ || filename_ == NULL || filename_[0] == '\0' )
+      return SCIP_OKAY;
+
+   if( !profiler_.writeJson(filename_) )
+   {
+      SCIPerrorMessage("cannot write profile to <%s>\n", filename_);
+      return SCIP_WRITEERROR;
+   }
+   SCIPinfoMessage(scip, NULL, "Design profile    : %d callbacks written to <%s>\n", (int) profiler_.entries().size(),
+      filename_);
+
+   return SCIP_OKAY;
+}
+
+
+/** output method of statistics table to output file stream 'file' */
+SCIP_DECL_TABLEOUTPUT(TableProfile::scip_output)
+{
+   if( !enabled_ )
+      return SCIP_OKAY;
+
+   bool counters = Profiler::hasCounters();
+   const map<string, ProfileEntry>& entries = profiler_.entries();
+   SCIPinfoMessage(scip, file, "Design Profile            :         calls      time [s]    cycles [M]     instr [M]  LLC miss [K]           IPC\n");
+   for( map<string, ProfileEntry>::const_iterator it = entries.begin(); it != entries.end(); ++it )
+   {
+      const ProfileEntry& entry = it->second;
+      SCIPinfoMessage(scip, file, "  %-24s: %13lld %13.3f", it->first.c_str(), entry.calls, entry.seconds);
+      if( counters )
+      {
+         SCIPinfoMessage(scip, file, " %13.1f %13.1f %13.1f %13.2f\n", entry.counters[PROFILE_CYCLES] / 1e6,
+            entry.counters[PROFILE_INSTRUCTIONS] / 1e6, entry.counters[PROFILE_LLCMISSES] / 1e3,
+            entry.counters[PROFILE_CYCLES] > 0
+            ? (double) entry.counters[PROFILE_INSTRUCTIONS] / entry.counters[PROFILE_CYCLES] : 0.0);
+      }
+      else
+         SCIPinfoMessage(scip, file, " %13s %13s %13s %13s\n", "-", "-", "-", "-");
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** finds the profiler of the SCIP instance and samples the start of the call if it is enabled */
+void ProfileScope::begin(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   TableProfile* table = dynamic_cast<TableProfile*>(SCIPfindObjTable(scip, TABLE_NAME));
+   if( table == NULL || !table->profiler().enabled() )
+      return;
+   profiler_ = &table->profiler();
+   Profiler::sample(start_);
+}
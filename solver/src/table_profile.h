@@ -0,0 +1,111 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   table_profile.h
+ * @brief  statistics table with the profile of the callbacks of the design plugins
+ * @author Liding Xu
+ *
+ * With "table/designprofile/enabled" set, the callbacks of the design plugins (reading and model building,
+ * transformation and copy of the problem data, the separator "conegrid", the propagator "designbounds", the pricer
+ * "design" and the nonlinear handler "geomean") record their calls, wall clock time, cycles, instructions and
+ * last-level cache misses in the profiler of the table, see profiler.h. The statistics print one line per callback;
+ * with "table/designprofile/filename" set, the profile is also written as JSON at the end of every solve.
+ *
+ * A callback is profiled by a ProfileScope on its first line, e.g. DOPT_PROFILE(scip, "conegrid/execlp"). While
+ * profiling is disabled in all SCIP instances of the process, the scope costs one atomic load.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_TABLE_PROFILE_H__
+#define __SCIP_TABLE_PROFILE_H__
+
+#include "objscip/objscip.h"
+#include "profiler.h"
+
+
+/** statistics table for the profile of the callbacks of a D-optimal design problem */
+class TableProfile : public scip::ObjTable
+{
+public:
+   /** default constructor */
+   TableProfile(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   /** destructor */
+   virtual ~TableProfile()
+   {
+   }
+
+   /** solving process deinitialization method of statistics table (called before branch and bound process data is freed) */
+   virtual SCIP_DECL_TABLEEXITSOL(scip_exitsol);
+
+   /** output method of statistics table to output file stream 'file' */
+   virtual SCIP_DECL_TABLEOUTPUT(scip_output);
+
+   /** returns the profiler */
+   Profiler& profiler()
+   {
+      return profiler_;
+   }
+
+private:
+   Profiler              profiler_;          /**< profiler of the callbacks */
+   SCIP_Bool             enabled_;           /**< are the callbacks profiled? */
+   char*                 filename_;          /**< name of the JSON file, empty: none */
+};/*lint !e1712*/
+
+
+/** scope that records a call of a callback in the profiler of the SCIP instance, if profiling is enabled */
+class ProfileScope
+{
+public:
+   /** starts the call */
+   ProfileScope(
+      SCIP*              scip,               /**< SCIP data structure */
+      const char*        name                /**< name of the callback, a string literal */
+      ) : profiler_(NULL), name_(name)
+   {
+      if( Profiler::anyEnabled() )
+         begin(scip);
+   }
+
+   /** ends the call */
+   ~ProfileScope()
+   {
+      if( profiler_ != NULL )
+         profiler_->record(name_, start_);
+   }
+
+private:
+   ProfileScope(const ProfileScope&);
+   ProfileScope& operator=(const ProfileScope&);
+
+   /** finds the profiler of the SCIP instance and samples the start of the call if it is enabled */
+   void begin(
+      SCIP*              scip                /**< SCIP data structure */
+      );
+
+   Profiler*             profiler_;          /**< profiler of the call, NULL: not profiled */
+   const char*           name_;              /**< name of the callback */
+   ProfileSample         start_;             /**< sample at the start of the call */
+};
+
+/** profiles the rest of the enclosing block as a call of the callback name */
+#define DOPT_PROFILE(scip, name) ProfileScope profilescope_(scip, name)
+
+
+#endif
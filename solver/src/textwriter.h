@@ -0,0 +1,249 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   textwriter.h
+ * @brief  buffered writer of large text files
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __DOPT_TEXTWRITER_H__
+#define __DOPT_TEXTWRITER_H__
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/** buffered writer for large instance and model files */
+class TextWriter
+{
+public:
+   /** opens the file */
+   TextWriter(
+      const std::string& filename            /**< name of the file to write */
+      ) : file_(fopen(filename.c_str(), "w")), len_(0)
+   {
+      buf_.resize(1 << 20);
+   }
+
+   /** flushes and closes the file */
+   ~TextWriter()
+   {
+      close();
+   }
+
+   /** returns whether the file is open and no write failed */
+   bool ok() const
+   {
+      return file_ != NULL;
+   }
+
+   /** appends a string */
+   void put(
+      const char*        str,                /**< string to append */
+      size_t             len                 /**< length of the string */
+      )
+   {
+      if( len_ + len > buf_.size() )
+         flush();
+      if( len > buf_.size() )
+         buf_.resize(len);
+      std::copy(str, str + len, buf_.begin() + len_);
+      len_ += len;
+   }
+
+   /** appends a zero-terminated string */
+   void put(
+      const char*        str                 /**< string to append */
+      )
+   {
+      put(str, strlen(str));
+   }
+
+   /** appends a number followed by a space */
+   void putReal(
+      double             val                 /**< number to append */
+      )
+   {
+      char str[32];
+      int len = snprintf(str, sizeof(str), "%.10g ", val);
+      put(str, (size_t) len);
+   }
+
+   /** appends an integer followed by a separator */
+   void putInt(
+      long long          val,                /**< number to append */
+      char               sep                 /**< separator to append */
+      )
+   {
+      char str[24];
+      char* end = str + sizeof(str);
+      char* pos = end;
+      *--pos = sep;
+      unsigned long long absval = val < 0 ? 0ULL - (unsigned long long) val : (unsigned long long) val;
+      do
+      {
+         *--pos = (char) ('0' + absval % 10);
+         absval /= 10;
+      }
+      while( absval > 0 );
+      if( val < 0 )
+         *--pos = '-';
+      put(pos, (size_t) (end - pos));
+   }
+
+   /** appends a number with 15 significant digits followed by a separator, as "%.15g" does up to the rounding of the
+    *  last digit; integral numbers are written as integers
+    */
+   void putDouble(
+      double             val,                /**< number to append */
+      char               sep                 /**< separator to append */
+      )
+   {
+      if( val == (double) (long long) val && val < 1e15 && val > -1e15 )
+      {
+         putInt((long long) val, sep);
+         return;
+      }
+
+      // the digits are those of val * 10^(14 - exp) rounded to an integer; the power of ten is exact for
+      // |14 - exp| <= 22, so the product is rounded once, otherwise printf converts the number
+      double absval = fabs(val);
+      int exp = absval > 0.0 && absval < HUGE_VAL ? (int) floor(log10(absval)) : 1000;
+      if( 14 - exp < -22 || 14 - exp > 22 )
+      {
+         char str[32];
+         int len = snprintf(str, sizeof(str), "%.15g", val);
+         str[len] = sep;
+         put(str, (size_t) len + 1);
+         return;
+      }
+      static const double pow10[23] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+         1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+      double scaled = 14 - exp >= 0 ? absval * pow10[14 - exp] : absval / pow10[exp - 14];
+      long long mant = llround(scaled);
+      if( mant >= 1000000000000000LL )
+      {
+         mant = (mant + 5) / 10;
+         ++exp;
+      }
+      else if( mant < 100000000000000LL )
+      {
+         // log10 rounded up to the next power of ten
+         mant *= 10;
+         --exp;
+      }
+
+      char digits[15];
+      for( int k = 14; k >= 0; k-- )
+      {
+         digits[k] = (char) ('0' + mant % 10);
+         mant /= 10;
+      }
+      int ndigits = 15;
+      while( ndigits > 1 && digits[ndigits - 1] == '0' )
+         --ndigits;
+
+      char str[40];
+      int len = 0;
+      if( val < 0.0 )
+         str[len++] = '-';
+      if( exp >= 0 && exp < 15 )
+      {
+         for( int k = 0; k <= exp; k++ )
+            str[len++] = k < ndigits ? digits[k] : '0';
+         if( ndigits > exp + 1 )
+         {
+            str[len++] = '.';
+            for( int k = exp + 1; k < ndigits; k++ )
+               str[len++] = digits[k];
+         }
+      }
+      else if( exp < 0 && exp >= -4 )
+      {
+         str[len++] = '0';
+         str[len++] = '.';
+         for( int k = exp + 1; k < 0; k++ )
+            str[len++] = '0';
+         for( int k = 0; k < ndigits; k++ )
+            str[len++] = digits[k];
+      }
+      else
+      {
+         str[len++] = digits[0];
+         if( ndigits > 1 )
+         {
+            str[len++] = '.';
+            for( int k = 1; k < ndigits; k++ )
+               str[len++] = digits[k];
+         }
+         len += snprintf(str + len, sizeof(str) - (size_t) len, "e%c%02d", exp < 0 ? '-' : '+', exp < 0 ? -exp : exp);
+      }
+      str[len++] = sep;
+      put(str, (size_t) len);
+   }
+
+   /** appends a formatted line of at most 255 characters */
+   void putf(
+      const char*        format,             /**< format string as for printf */
+      ...
+      )
+   {
+      char str[256];
+      va_list args;
+      va_start(args, format);
+      int len = vsnprintf(str, sizeof(str), format, args);
+      va_end(args);
+      if( len > 0 )
+         put(str, std::min((size_t) len, sizeof(str) - 1));
+   }
+
+   /** writes the buffer to the file */
+   void flush()
+   {
+      if( file_ != NULL && len_ > 0 && fwrite(buf_.data(), 1, len_, file_) != len_ )
+      {
+         fclose(file_);
+         file_ = NULL;
+      }
+      len_ = 0;
+   }
+
+   /** flushes and closes the file; returns whether all writes succeeded */
+   bool close()
+   {
+      flush();
+      if( file_ == NULL )
+         return false;
+      bool success = fclose(file_) == 0;
+      file_ = NULL;
+      return success;
+   }
+
+private:
+   TextWriter(const TextWriter&);
+   TextWriter& operator=(const TextWriter&);
+
+   FILE*                 file_;              /**< output file */
+   std::vector<char>     buf_;               /**< output buffer */
+   size_t                len_;               /**< number of used bytes of the buffer */
+};
+
+#endif
@@ -0,0 +1,130 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   threadpool.cpp
+ * @brief  fixed pool of worker threads for parallel loops
+ * @author Liding Xu
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "threadpool.h"
+
+using namespace std;
+
+
+/** starts nthreads - 1 workers; the calling thread is the remaining one */
+ThreadPool::ThreadPool(
+   int                   nthreads            /**< number of threads including the calling thread */
+   )
+   : task_(NULL),
+     ntasks_(0),
+     next_(0),
+     nbusy_(0),
+     generation_(0),
+     stop_(false)
+{
+   for( int t = 1; t < nthreads; t++ )
+      workers_.push_back(thread(&ThreadPool::work, this, t));
+}
+
+
+/** stops and joins the workers */
+ThreadPool::~ThreadPool()
+{
+   {
+      lock_guard<mutex> lock(mutex_);
+      stop_ = true;
+   }
+   start_.notify_all();
+
+   for( size_t t = 0; t < workers_.size(); t++ )
+      workers_[t].join();
+}
+
+
+/** runs task(k, thread) for k = 0, ..., ntasks - 1 and waits for all tasks */
+void ThreadPool::parallelFor(
+   int                   ntasks,             /**< number of tasks */
+   const function<void(int, int)>& task      /**< task to run */
+   )
+{
+   if( ntasks <= 0 )
+      return;
+
+   /* without workers, or with a single task, the loop is run directly */
+   if( workers_.empty() || ntasks == 1 )
+   {
+      for( int k = 0; k < ntasks; k++ )
+         task(k, 0);
+      return;
+   }
+
+   {
+      lock_guard<mutex> lock(mutex_);
+      task_ = &task;
+      ntasks_ = ntasks;
+      next_ = 0;
+      nbusy_ = (int) workers_.size();
+      generation_++;
+   }
+   start_.notify_all();
+
+   runTasks(0);
+
+   unique_lock<mutex> lock(mutex_);
+   done_.wait(lock, [this] { return nbusy_ == 0; });
+   task_ = NULL;
+}
+
+
+/** claims and runs tasks of the current loop until none are left */
+void ThreadPool::runTasks(
+   int                   thread              /**< index of the executing thread */
+   )
+{
+   for( int k = next_++; k < ntasks_; k = next_++ )
+      (*task_)(k, thread);
+}
+
+
+/** main loop of a worker */
+void ThreadPool::work(
+   int                   thread              /**< index of the worker thread */
+   )
+{
+   long long generation = 0;
+
+   for( ;; )
+   {
+      {
+         unique_lock<mutex> lock(mutex_);
+         start_.wait(lock, [this, generation] { return stop_ || generation_ != generation; });
+         if( stop_ )
+            return;
+         generation = generation_;
+      }
+
+      runTasks(thread);
+
+      {
+         lock_guard<mutex> lock(mutex_);
+         nbusy_--;
+      }
+      done_.notify_one();
+   }
+}
@@ -0,0 +1,88 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   threadpool.h
+ * @brief  fixed pool of worker threads for parallel loops
+ * @author Liding Xu
+ *
+ * The pool runs the tasks 0, ..., ntasks - 1 of a loop on its workers and on the calling thread, and returns when all
+ * tasks are done. Tasks are claimed in increasing order, but may finish in any order, so callers that need a
+ * deterministic result write the result of a task to a slot of its own and merge the slots in task order.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_THREADPOOL_H__
+#define __SCIP_THREADPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/** pool of worker threads */
+class ThreadPool
+{
+public:
+   /** starts nthreads - 1 workers; the calling thread is the remaining one */
+   explicit ThreadPool(
+      int                nthreads            /**< number of threads including the calling thread */
+      );
+
+   /** stops and joins the workers */
+   ~ThreadPool();
+
+   /** runs task(k, thread) for k = 0, ..., ntasks - 1 and waits for all tasks; thread is the index of the executing
+    *  thread in 0, ..., nthreads - 1, with 0 for the calling thread
+    */
+   void parallelFor(
+      int                ntasks,             /**< number of tasks */
+      const std::function<void(int, int)>& task /**< task to run */
+      );
+
+   /** returns the number of threads including the calling thread */
+   int getNThreads() const
+   {
+      return (int) workers_.size() + 1;
+   }
+
+private:
+   /** claims and runs tasks of the current loop until none are left */
+   void runTasks(
+      int                thread              /**< index of the executing thread */
+      );
+
+   /** main loop of a worker */
+   void work(
+      int                thread              /**< index of the worker thread */
+      );
+
+   std::vector<std::thread> workers_;        /**< worker threads */
+   std::mutex            mutex_;             /**< protects the loop state below */
+   std::condition_variable start_;           /**< signals a new loop or the stop to the workers */
+   std::condition_variable done_;            /**< signals the end of the loop to the calling thread */
+   const std::function<void(int, int)>* task_; /**< task of the current loop */
+   int                   ntasks_;            /**< number of tasks of the current loop */
+   std::atomic<int>      next_;              /**< next unclaimed task */
+   int                   nbusy_;             /**< number of workers still running tasks of the current loop */
+   long long             generation_;        /**< number of the current loop, to wake each worker once per loop */
+   bool                  stop_;              /**< should the workers stop? */
+};
+
+
+#endif
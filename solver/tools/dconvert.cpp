@@ -0,0 +1,117 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   dconvert.cpp
+ * @brief  command line converter of D-optimal design instances to CBF and MPS
+ * @author Liding Xu
+ *
+ * usage:
+ *   dconvert <instance> <model> [-c card] [-l]
+ *
+ * The instance may be compressed (.design.gz, .design.zst); the model is written in CBF or MPS by its extension
+ * (.cbf, .mps). "-c" overrides the cardinality of the instance as "reading/design/card" does, "-l" writes the
+ * log-determinant form of the objective (CBF only). The MISOCP is the model of the reader, see modelwriter.h.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "datastream.h"
+#include "modelwriter.h"
+
+using namespace std;
+
+/** prints the usage */
+static
+void printUsage()
+{
+   printf("usage: dconvert <instance> <model.cbf|model.mps> [-c card] [-l]\n");
+}
+
+/** returns the seconds since a time point */
+static
+double secondsSince(
+   chrono::steady_clock::time_point start    /**< time point */
+   )
+{
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/** main function of the converter */
+int main(
+   int                   argc,               /**< number of arguments */
+   char**                argv                /**< arguments */
+   )
+{
+   if( argc < 3 )
+   {
+      printUsage();
+      return 1;
+   }
+
+   const char* instance = argv[1];
+   string model = argv[2];
+   int cardoverride = -1;
+   bool logdetform = false;
+
+   for( int i = 3; i < argc; i++ )
+   {
+      if( strcmp(argv[i], "-c") == 0 && i + 1 < argc )
+         cardoverride = atoi(argv[++i]);
+      else if( strcmp(argv[i], "-l") == 0 )
+         logdetform = true;
+      else
+      {
+         printUsage();
+         return 1;
+      }
+   }
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   int numvars;
+   int dim;
+   int card;
+   double epsilon;
+   vector<vector<double>> A;
+   string error;
+   if( !parseDesignFile(instance, numvars, dim, card, epsilon, A, error) )
+   {
+      printf("%s\n", error.c_str());
+      return 1;
+   }
+   double parsetime = secondsSince(start);
+
+   if( cardoverride >= 0 )
+      card = cardoverride;
+
+   // the model uses the square root of the epsilon of the file, as the reader
+   start = chrono::steady_clock::now();
+   if( !writeDesignModel(model, numvars, dim, A, card, sqrt(epsilon), logdetform, error) )
+   {
+      printf("%s\n", error.c_str());
+      return 1;
+   }
+   printf("%s: %d points, dimension %d, parsed in %.2f s, written in %.2f s\n", model.c_str(), numvars, dim, parsetime,
+      secondsSince(start));
+
+   return 0;
+}
@@ -0,0 +1,146 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   denum.cpp
+ * @brief  command line solver of small D-optimal design instances by exhaustive enumeration
+ * @author Liding Xu
+ *
+ * usage:
+ *   denum <instance> [-c card] [-t threads] [-l timelimit]
+ *
+ * Enumerates all designs of card points of the instance in revolving-door order, see enumerate.h, and prints the
+ * best one with its log-determinant and the geometric mean objective of the model. "-c" overrides the cardinality
+ * of the instance as "reading/design/card" does, "-t" sets the number of threads and "-l" the time limit in seconds.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "datastream.h"
+#include "enumerate.h"
+#include "threadpool.h"
+
+using namespace std;
+
+/** prints the usage */
+static
+void printUsage()
+{
+   printf("usage: denum <instance> [-c card] [-t threads] [-l timelimit]\n");
+}
+
+/** returns the seconds since a time point */
+static
+double secondsSince(
+   chrono::steady_clock::time_point start    /**< time point */
+   )
+{
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/** main function of the enumeration solver */
+int main(
+   int                   argc,               /**< number of arguments */
+   char**                argv                /**< arguments */
+   )
+{
+   if( argc < 2 )
+   {
+      printUsage();
+      return 1;
+   }
+
+   const char* instance = argv[1];
+   int cardoverride = -1;
+   int nthreads = 1;
+   double timelimit = 1e20;
+
+   for( int i = 2; i < argc; i++ )
+   {
+      if( strcmp(argv[i], "-c") == 0 && i + 1 < argc )
+         cardoverride = atoi(argv[++i]);
+      else if( strcmp(argv[i], "-t") == 0 && i + 1 < argc )
+         nthreads = atoi(argv[++i]);
+      else if( strcmp(argv[i], "-l") == 0 && i + 1 < argc )
+         timelimit = atof(argv[++i]);
+      else
+      {
+         printUsage();
+         return 1;
+      }
+   }
+   if( nthreads < 1 )
+   {
+      printUsage();
+      return 1;
+   }
+
+   int numvars;
+   int dim;
+   int card;
+   double epsilon;
+   vector<vector<double>> A;
+   string error;
+   if( !parseDesignFile(instance, numvars, dim, card, epsilon, A, error) )
+   {
+      printf("%s\n", error.c_str());
+      return 1;
+   }
+   if( cardoverride >= 0 )
+      card = cardoverride;
+   if( card < 0 || card > numvars )
+   {
+      printf("cardinality %d of a design of %d points\n", card, numvars);
+      return 1;
+   }
+   printf("%s: %d points, dimension %d, %.4g designs of %d points\n", instance, numvars, dim,
+      binomialCount(numvars, card), card);
+
+   // the regularization of the model is the epsilon of the file, see the reader
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   vector<int> candidates(numvars);
+   for( int i = 0; i < numvars; i++ )
+      candidates[i] = i;
+   ThreadPool* pool = nthreads > 1 ? new ThreadPool(nthreads) : NULL;
+   vector<int> design;
+   double logdet;
+   EnumerationStats stats;
+   bool complete = enumerateDesigns(A, epsilon, dimKernel(dim), vector<int>(), candidates, card, -HUGE_VAL, timelimit,
+      pool, design, logdet, stats);
+   delete pool;
+
+   printf("%s in %.2f s with %d threads: %lld nodes, %lld designs evaluated, %lld nodes pruned, %d subtrees\n",
+      complete ? "enumerated" : "time limit", secondsSince(start), nthreads, stats.nnodes, stats.nleaves,
+      stats.npruned, stats.ntasks);
+   if( design.empty() )
+   {
+      printf("no design with a positive definite information matrix\n");
+      return complete ? 0 : 1;
+   }
+   printf("log-determinant %.12g, geometric mean %.12g\n", logdet, exp(logdet / dim));
+   printf("design:");
+   for( size_t k = 0; k < design.size(); k++ )
+      printf(" %d", design[k]);
+   printf("\n");
+
+   return 0;
+}
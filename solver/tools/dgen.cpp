@@ -0,0 +1,109 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   dgen.cpp
+ * @brief  command line generator of synthetic D-optimal design instances
+ * @author Liding Xu
+ *
+ * usage:
+ *   dgen normal <numvars> <dim> <card> [-s seed] [-e epsilon] [-o file]
+ *   dgen block2 <t> <numedges> <card> [-s seed] [-e epsilon] [-o file]
+ *
+ * Without -o, the file is named as in benchmark/: normal_<numvars>_<dim>_<card>.design and
+ * block2_<numedges>_<t>_<dim>_<card>.design.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "generator.h"
+
+using namespace std;
+
+/** prints the usage */
+static
+void printUsage()
+{
+   printf("usage: dgen normal <numvars> <dim> <card> [-s seed] [-e epsilon] [-o file]\n");
+   printf("       dgen block2 <t> <numedges> <card> [-s seed] [-e epsilon] [-o file]\n");
+}
+
+/** main function of the generator */
+int main(
+   int                   argc,               /**< number of arguments */
+   char**                argv                /**< arguments */
+   )
+{
+   if( argc < 5 )
+   {
+      printUsage();
+      return 1;
+   }
+
+   string family = argv[1];
+   int n1 = atoi(argv[2]);
+   int n2 = atoi(argv[3]);
+   int card = atoi(argv[4]);
+   unsigned long long seed = 0;
+   double epsilon = 1e-6;
+   string filename;
+
+   for( int i = 5; i + 1 < argc; i += 2 )
+   {
+      if( strcmp(argv[i], "-s") == 0 )
+         seed = strtoull(argv[i + 1], NULL, 10);
+      else if( strcmp(argv[i], "-e") == 0 )
+         epsilon = atof(argv[i + 1]);
+      else if( strcmp(argv[i], "-o") == 0 )
+         filename = argv[i + 1];
+      else
+      {
+         printUsage();
+         return 1;
+      }
+   }
+
+   bool success;
+   if( family == "normal" )
+   {
+      if( filename.empty() )
+         filename = "normal_" + to_string(n1) + "_" + to_string(n2) + "_" + to_string(card) + ".design";
+      success = writeNormalInstance(filename, n1, n2, card, epsilon, seed);
+   }
+   else if( family == "block2" )
+   {
+      if( filename.empty() )
+         filename = "block2_" + to_string(n2) + "_" + to_string(n1) + "_" + to_string(n1 - 1) + "_" + to_string(card) + ".design";
+      success = writeBlockInstance(filename, n1, n2, card, epsilon, seed);
+   }
+   else
+   {
+      printUsage();
+      return 1;
+   }
+
+   if( !success )
+   {
+      printf("cannot write <%s>\n", filename.c_str());
+      return 1;
+   }
+   printf("%s\n", filename.c_str());
+
+   return 0;
+}
@@ -0,0 +1,199 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2020 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not visit scipopt.org.         */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   dsubmit.cpp
+ * @brief  command line client of the solver service of dopt --daemon
+ * @author Liding Xu
+ *
+ * usage:
+ *   dsubmit <socket> <instance> [-c card] [-t timelimit] [-s settings] [-i]
+ *   dsubmit <socket> shutdown
+ *
+ * The job refers to the instance by its absolute path, or with -i sends the data of the instance inline. The lines
+ * of the service are printed as they arrive, followed by the round trip time of the job as seen by the client.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+/** prints the usage */
+static
+void printUsage()
+{
+   printf("usage: dsubmit <socket> <instance> [-c card] [-t timelimit] [-s settings] [-i]\n");
+   printf("       dsubmit <socket> shutdown\n");
+}
+
+/** writes the data of an instance file as inline matrix; returns false if the file cannot be read */
+static
+bool appendMatrix(
+   const char*           filename,           /**< instance file */
+   string&               job                 /**< job to append the matrix to */
+   )
+{
+   ifstream in(filename);
+   int numvars, dim, card;
+   double epsilon;
+   if( !(in >> numvars >> dim >> card >> epsilon) || numvars <= 0 || dim <= 0 )
+      return false;
+
+   ostringstream out;
+   out.precision(17);
+   out << "matrix " << numvars << " " << dim << " " << epsilon << "\n";
+   double value;
+   for( int i = 0; i < numvars; i++ )
+   {
+      for( int j = 0; j < dim; j++ )
+      {
+         if( !(in >> value) )
+            return false;
+         out << (j > 0 ? " " : "") << value;
+      }
+      out << "\n";
+   }
+   job += out.str();
+
+   /* the card of the file, unless given on the command line */
+   if( job.find("card ") == string::npos )
+      job += "card " + to_string(card) + "\n";
+
+   return true;
+}
+
+/** main function of the client */
+int main(
+   int                   argc,               /**< number of arguments */
+   char**                argv                /**< arguments */
+   )
+{
+   if( argc < 3 )
+   {
+      printUsage();
+      return 1;
+   }
+
+   string job;
+   bool isinline = false;
+   if( strcmp(argv[2], "shutdown") == 0 )
+      job = "shutdown\n";
+   else
+   {
+      for( int i = 3; i < argc; i++ )
+      {
+         if( strcmp(argv[i], "-i") == 0 )
+            isinline = true;
+         else if( i + 1 < argc && strcmp(argv[i], "-c") == 0 )
+            job += string("card ") + argv[++i] + "\n";
+         else if( i + 1 < argc && strcmp(argv[i], "-t") == 0 )
+            job += string("time ") + argv[++i] + "\n";
+         else if( i + 1 < argc && strcmp(argv[i], "-s") == 0 )
+         {
+            char path[PATH_MAX];
+            if( realpath(argv[++i], path) == NULL )
+            {
+               printf("cannot find <%s>\n", argv[i]);
+               return 1;
+            }
+            job += string("settings ") + path + "\n";
+         }
+         else
+         {
+            printUsage();
+            return 1;
+         }
+      }
+
+      if( isinline )
+      {
+         if( !appendMatrix(argv[2], job) )
+         {
+            printf("cannot read <%s>\n", argv[2]);
+            return 1;
+         }
+      }
+      else
+      {
+         char path[PATH_MAX];
+         if( realpath(argv[2], path) == NULL )
+         {
+            printf("cannot find <%s>\n", argv[2]);
+            return 1;
+         }
+         job += string("file ") + path + "\n";
+      }
+      job += "end\n";
+   }
+
+   struct sockaddr_un addr;
+   memset(&addr, 0, sizeof(addr));
+   addr.sun_family = AF_UNIX;
+   strncpy(addr.sun_path, argv[1], sizeof(addr.sun_path) - 1);
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if( fd < 0 || connect(fd, (struct sockaddr*) &addr, sizeof(addr)) < 0 )
+   {
+      printf("cannot connect to <%s>\n", argv[1]);
+      return 1;
+   }
+
+   for( size_t pos = 0; pos < job.size(); )
+   {
+      ssize_t n = send(fd, job.data() + pos, job.size() - pos, MSG_NOSIGNAL);
+      if( n <= 0 )
+      {
+         printf("connection lost\n");
+         close(fd);
+         return 1;
+      }
+      pos += n;
+   }
+
+   /* the service closes the connection after the result */
+   bool failed = false;
+   string line;
+   char chunk[4096];
+   ssize_t n;
+   while( (n = recv(fd, chunk, sizeof(chunk), 0)) > 0 )
+   {
+      line.append(chunk, n);
+      size_t end;
+      while( (end = line.find('\n')) != string::npos )
+      {
+         printf("%s\n", line.substr(0, end).c_str());
+         failed = failed || line.compare(0, 6, "error ") == 0;
+         line.erase(0, end + 1);
+      }
+      fflush(stdout);
+   }
+   close(fd);
+
+   printf("roundtrip_ms=%.3f\n", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count());
+
+   return failed ? 1 : 0;
+}
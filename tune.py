@@ -0,0 +1,322 @@
+#!/usr/bin/env python3
+# parameter tuner: races configurations of the cut parameters of the settings files scip2 - scip6 on a training subset
+# of the benchmark with short time limits and writes the winner as a settings file
+#
+# A configuration chooses one value for each parameter group of SPACE; the race starts with the hand-written settings
+# and random configurations. The configurations are run on the training instances one after the other, and after
+# --minrace instances, those whose mean rank is worse than the best mean rank by more than the critical difference of
+# the Nemenyi test are eliminated (Friedman racing). A configuration is ranked on an instance by
+# (gap + 1) * (primal integral + 10), with the gap in percent and the primal integral in seconds, so the score of a
+# configuration, the geometric mean of these products, is the product of the shifted geometric means of gap and
+# primal integral. The primal integral is computed from the bound trace of the run ("eventhdlr/trace/filename")
+# against the best primal bound of all runs on the instance, so all configurations share the reference.
+#
+# With --classes, the instances are grouped by their density and size (numvars * dim), a race is run for each class
+# and a settings file is written for each of them; --select <instance> prints the settings file of an instance.
+#
+# usage:
+#   python3 tune.py [--timelimit 60] [--train 0.5] [--nconfigs 24] [--jobs 2] [--output settings/tuned.set]
+#   python3 tune.py --classes
+#   python3 tune.py --select benchmark/normal_50_20_10.design
+import argparse
+import csv
+import gzip
+import json
+import math
+import os
+import random
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+
+dopt = "solver/build/dopt"
+datapath = "benchmark"
+settingpath = "settings"
+tunepath = "tune"
+
+# parameter groups and their values; the first value of every group is the SCIP default
+SPACE = [
+    ("minefficacy", [{"separating/minefficacy": 1e-4}, {"separating/minefficacy": 1e-3},
+                     {"separating/minefficacy": 1e-2}]),
+    ("soccutefficacy", [{"nlhdlr/soc/mincutefficacy": 1e-5}, {"nlhdlr/soc/mincutefficacy": 1e-4},
+                        {"nlhdlr/soc/mincutefficacy": 1e-2}]),
+    # the cut selector designcutsel, or SCIP's hybrid selector with three weightings
+    ("cutsel", [{"cutselection/designcutsel/priority": 10000},
+                {"cutselection/designcutsel/priority": 0,
+                 "cutselection/hybrid/minortho": 0.9, "cutselection/hybrid/minorthoroot": 0.9,
+                 "cutselection/hybrid/intsupportweight": 0.1, "cutselection/hybrid/objparalweight": 0.1},
+                {"cutselection/designcutsel/priority": 0,
+                 "cutselection/hybrid/minortho": 0.5, "cutselection/hybrid/minorthoroot": 0.5,
+                 "cutselection/hybrid/intsupportweight": 0.05, "cutselection/hybrid/objparalweight": 0.05},
+                {"cutselection/designcutsel/priority": 0,
+                 "cutselection/hybrid/minortho": 0, "cutselection/hybrid/minorthoroot": 0,
+                 "cutselection/hybrid/intsupportweight": 0, "cutselection/hybrid/objparalweight": 0}]),
+    ("coefratio", [{"separating/maxcoefratiofacrowprep": 10}, {"separating/maxcoefratiofacrowprep": 10000},
+                   {"separating/maxcoefratiofacrowprep": 1000000}]),
+    ("strongcut", [{"constraints/nonlinear/strongcutmaxcoef": 1000}, {"constraints/nonlinear/strongcutmaxcoef": 1e6},
+                   {"constraints/nonlinear/strongcutmaxcoef": 1e20}]),
+]
+
+# the lines of every settings file of the benchmark that are not tuned
+HEADER = ["display/width = 150", "table/cons_nonlinear/active = TRUE", "display/completed/active = 0",
+          "display/separounds/active = 2", "", "limits/gap = 1e-4", "limits/time = 3600", ""]
+
+# critical values q_0.05 of the Nemenyi test for k configurations (Demsar 2006, larger k from the studentized range)
+NEMENYI_Q = [(2, 1.960), (3, 2.343), (4, 2.569), (5, 2.728), (6, 2.850), (7, 2.949), (8, 3.031), (9, 3.102),
+             (10, 3.164), (15, 3.391), (20, 3.544), (30, 3.738), (50, 3.971)]
+
+GAP_SHIFT = 1.0
+INTEGRAL_SHIFT = 10.0
+MAX_GAP = 1000.0 # gap in percent of runs without primal or dual bound
+
+
+def configName(config):
+    return "c" + "".join(str(v) for v in config)
+
+
+def configParams(config):
+    params = {}
+    for (group, values), v in zip(SPACE, config):
+        params.update(values[v])
+    return params
+
+
+def handwrittenConfigs():
+    # the configurations of scip1 - scip6: a group takes the value of the file if the file sets one of its parameters
+    configs = []
+    for k in range(1, 7):
+        path = "%s/scip%d.set" % (settingpath, k)
+        if not os.path.exists(path):
+            continue
+        setparams = {}
+        for line in open(path):
+            if "=" in line and not line.startswith("#"):
+                key, value = line.split("=", 1)
+                try:
+                    setparams[key.strip()] = float(value)
+                except ValueError:
+                    pass # only numerical parameters are tuned
+        config = []
+        for group, values in SPACE:
+            choice = 0
+            for v, params in enumerate(values):
+                if any(key in setparams and setparams[key] == params[key] for key in params):
+                    choice = v
+            config.append(choice)
+        if tuple(config) not in configs:
+            configs.append(tuple(config))
+    return configs
+
+
+def readFeatures(path):
+    # numvars, dim, card and the density of the data matrix of a design file (plain or gzip)
+    opener = gzip.open if path.endswith(".gz") else open
+    with opener(path, "rt") as f:
+        tokens = f.read().split()
+    numvars, dim, card = int(tokens[0]), int(tokens[1]), int(tokens[2])
+    entries = tokens[4:4 + numvars * dim]
+    nonzeros = sum(1 for t in entries if float(t) != 0.0)
+    return {"numvars": numvars, "dim": dim, "card": card, "density": nonzeros / max(len(entries), 1)}
+
+
+def instanceClass(features, args):
+    density = "sparse" if features["density"] < args.density else "dense"
+    size = "small" if features["numvars"] * features["dim"] <= args.size else "large"
+    return density + "_" + size
+
+
+def writeSettings(path, config, comment):
+    with open(path, "w") as f:
+        f.write("# %s\n" % comment)
+        f.write("\n".join(HEADER) + "\n")
+        for key, value in configParams(config).items():
+            f.write("%s = %s\n" % (key, repr(value) if isinstance(value, float) else value))
+
+
+def parseLog(log):
+    gap = MAX_GAP
+    for line in open(log):
+        if line.split(":")[0].strip() == "Gap":
+            field = line.split(":")[1].split()[0]
+            gap = MAX_GAP if field == "infinite" else min(float(field), MAX_GAP)
+    return gap
+
+
+def readTrace(trace):
+    # the samples (time, primal) of a bound trace and the end time of the solve
+    samples = []
+    endtime = 0.0
+    for line in open(trace):
+        record = json.loads(line)
+        if record["event"] == "summary":
+            endtime = record["time"]
+        else:
+            samples.append((record["time"], record["primal"]))
+    return samples, endtime
+
+
+def gapFunction(bound, ref):
+    # as in event_trace.cpp
+    if bound is None or ref is None or bound * ref < 0.0:
+        return 1.0
+    if abs(bound - ref) <= 1e-9 * max(1.0, abs(ref)):
+        return 0.0
+    return min(1.0, abs(bound - ref) / max(abs(bound), abs(ref)))
+
+
+def primalIntegral(samples, endtime, ref):
+    integral = 0.0
+    lasttime = 0.0
+    lastgap = 1.0
+    for time, primal in samples:
+        integral += lastgap * (time - lasttime)
+        lasttime = time
+        lastgap = gapFunction(primal, ref)
+    return integral + lastgap * max(endtime - lasttime, 0.0)
+
+
+def runConfig(config, instance, args):
+    # runs dopt with a configuration on an instance, unless the run is cached; returns gap, trace and end time
+    name = configName(config)
+    logdir = "%s/logs/t%g" % (tunepath, args.timelimit)
+    log = "%s/%s_%s.log" % (logdir, instance, name)
+    trace = "%s/%s_%s.jsonl" % (logdir, instance, name)
+    setfile = "%s/%s.set" % (logdir, name)
+    if not (os.path.exists(log) and os.path.exists(trace)):
+        writeSettings(setfile, config, "configuration %s of tune.py" % name)
+        with open(log, "w") as out:
+            subprocess.call([dopt, "-c", "set load %s" % setfile, "-c", "set limits time %g" % args.timelimit,
+                             "-c", "set eventhdlr trace filename %s" % trace, "-c", "read %s/%s" % (datapath, instance),
+                             "-c", "opt", "-c", "quit"], stdout=out, stderr=subprocess.STDOUT)
+    gap = parseLog(log)
+    samples, endtime = readTrace(trace) if os.path.exists(trace) else ([], args.timelimit)
+    return gap, samples, endtime
+
+
+def nemenyiCD(k, n):
+    q = NEMENYI_Q[-1][1]
+    for (k1, q1), (k2, q2) in zip(NEMENYI_Q, NEMENYI_Q[1:]):
+        if k1 <= k <= k2:
+            q = q1 + (q2 - q1) * (k - k1) / (k2 - k1)
+            break
+    return q * math.sqrt(k * (k + 1) / (6.0 * n))
+
+
+def race(configs, instances, args, label):
+    # Friedman race of the configurations on the instances; returns the survivors and their scores
+    alive = list(configs)
+    values = {c: [] for c in configs} # log of (gap + shift) * (integral + shift) per instance
+    ranks = {c: [] for c in configs}
+    pool = ThreadPoolExecutor(max_workers=args.jobs)
+    for n, instance in enumerate(instances, 1):
+        runs = dict(zip(alive, pool.map(lambda c: runConfig(c, instance, args), alive)))
+
+        # the reference of the primal integral is the best primal bound of all runs; the objective is minimized
+        primals = [p for gap, samples, endtime in runs.values() for t, p in samples if p is not None]
+        ref = min(primals) if primals else None
+        instvalues = {}
+        for c, (gap, samples, endtime) in runs.items():
+            integral = primalIntegral(samples, endtime, ref)
+            instvalues[c] = math.log(gap + GAP_SHIFT) + math.log(integral + INTEGRAL_SHIFT)
+            values[c].append(instvalues[c])
+
+        # ranks on the instance, ties get the mean rank
+        order = sorted(alive, key=lambda c: instvalues[c])
+        pos = 0
+        while pos < len(order):
+            end = pos
+            while end + 1 < len(order) and instvalues[order[end + 1]] == instvalues[order[pos]]:
+                end += 1
+            for c in order[pos:end + 1]:
+                ranks[c].append((pos + end) / 2.0 + 1.0)
+            pos = end + 1
+
+        # elimination by the mean ranks on the instances since the start of the race among the alive configurations
+        if n >= args.minrace and len(alive) > 2:
+            meanrank = {c: sum(ranks[c][-n:]) / n for c in alive}
+            best = min(meanrank.values())
+            cd = nemenyiCD(len(alive), n)
+            eliminated = [c for c in alive if meanrank[c] > best + cd]
+            alive = [c for c in alive if c not in eliminated]
+            if eliminated:
+                # the ranks of the survivors are recomputed among themselves on the next instances only
+                for c in alive:
+                    ranks[c] = []
+                    for k in range(n):
+                        ranks[c].append(1 + sum(1 for d in alive if values[d][k] < values[c][k])
+                                        + 0.5 * sum(1 for d in alive if d != c and values[d][k] == values[c][k]))
+        print("%s: instance %d/%d %s, %d configurations alive" % (label, n, len(instances), instance, len(alive)))
+    pool.shutdown()
+
+    scores = {c: math.exp(sum(values[c]) / len(values[c])) for c in alive}
+    return alive, scores
+
+
+def tune(instances, args, label, output):
+    rng = random.Random(args.seed)
+    configs = handwrittenConfigs()
+    while len(configs) < args.nconfigs:
+        config = tuple(rng.randrange(len(values)) for group, values in SPACE)
+        if config not in configs:
+            configs.append(config)
+    order = list(instances)
+    rng.shuffle(order)
+
+    alive, scores = race(configs, order, args, label)
+    winner = min(alive, key=lambda c: scores[c])
+    base = configs[0]
+    comment = "tuned by tune.py on %d instances (%s): score %.4g" % (len(order), label, scores[winner])
+    if base in scores:
+        comment += ", scip1 %.4g" % scores[base]
+    writeSettings(output, winner, comment)
+    print("%s: %s written to %s" % (label, comment, output))
+    return winner
+
+
+def main():
+    parser = argparse.ArgumentParser(description="racing tuner of the cut parameters of dopt")
+    parser.add_argument("--timelimit", type=float, default=60.0, help="time limit of a run in seconds")
+    parser.add_argument("--train", type=float, default=0.5, help="fraction of the benchmark used for training")
+    parser.add_argument("--nconfigs", type=int, default=24, help="number of configurations of the race")
+    parser.add_argument("--minrace", type=int, default=5, help="number of instances before the first elimination")
+    parser.add_argument("--jobs", type=int, default=1, help="number of runs in parallel")
+    parser.add_argument("--seed", type=int, default=1, help="seed of the configurations and the instance order")
+    parser.add_argument("--output", default=settingpath + "/tuned.set", help="settings file of the winner")
+    parser.add_argument("--classes", action="store_true", help="tune a settings file for every instance class")
+    parser.add_argument("--density", type=float, default=0.5, help="density below which an instance is sparse")
+    parser.add_argument("--size", type=int, default=1500, help="numvars * dim up to which an instance is small")
+    parser.add_argument("--select", metavar="INSTANCE", help="print the settings file of the class of an instance")
+    args = parser.parse_args()
+
+    if args.select:
+        cls = instanceClass(readFeatures(args.select), args)
+        path = "%s/tuned_%s.set" % (settingpath, cls)
+        print(path if os.path.exists(path) else args.output)
+        return
+
+    os.makedirs("%s/logs/t%g" % (tunepath, args.timelimit), exist_ok=True)
+    instances = sorted(os.listdir(datapath))
+    rng = random.Random(args.seed)
+    train = sorted(rng.sample(instances, max(1, int(round(args.train * len(instances))))))
+
+    with open(tunepath + "/features.csv", "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["instance", "numvars", "dim", "card", "density", "class", "train"])
+        features = {}
+        for instance in instances:
+            features[instance] = readFeatures(datapath + "/" + instance)
+            feat = features[instance]
+            writer.writerow([instance, feat["numvars"], feat["dim"], feat["card"], "%.4f" % feat["density"],
+                             instanceClass(feat, args), int(instance in train)])
+
+    if not args.classes:
+        tune(train, args, "all", args.output)
+        return
+
+    classes = sorted(set(instanceClass(features[i], args) for i in train))
+    for cls in classes:
+        members = [i for i in train if instanceClass(features[i], args) == cls]
+        tune(members, args, cls, "%s/tuned_%s.set" % (settingpath, cls))
+
+
+if __name__ == "__main__":
+    main()